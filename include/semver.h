@@ -71,6 +71,12 @@ enum {
     SEMVER_INVALID_RANGE_ITEM,
     SEMVER_ITEM_FULL,
     SEMVER_OUT_OF_RANGE,
+
+    SEMVER_IO_ERROR,
+    SEMVER_INVALID_CATALOG,
+    SEMVER_BUFFER_TOO_SMALL,
+    SEMVER_INVALID_BLOB,
+    SEMVER_INVALID_HANDLE,
 };
 
 /* Parses string and fills the version structure.
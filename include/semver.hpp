@@ -0,0 +1,399 @@
+﻿#ifndef SEMVER_HPP_20261019
+#define SEMVER_HPP_20261019
+
+/*
+ * Header-only C++17 layer over the C library.
+ *
+ * Version is a value type that owns a SemVersion (no heap memory), and it
+ * is ordered with compare_versions: with C++20 operator<=> gives
+ * std::weak_ordering because build parts are not compared. RangeList is a
+ * move-only owner of a VersionRange list. BasicConstraint keeps the terms
+ * of a version list in an allocator-aware vector, and pmr::Constraint
+ * takes a std::pmr::memory_resource.
+ *
+ * Errors of the C library are thrown as semver::Error.
+ */
+
+#include <cstring>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#endif
+#if defined(__cpp_impl_three_way_comparison) && __has_include(<compare>)
+#include <compare>
+#endif
+
+#include "semver.h"
+#include "ver_range.h"
+#include "semver_check.h"
+#include "semver_hash.h"
+
+namespace semver {
+
+class Error : public std::runtime_error {
+public:
+    explicit Error(int code) : std::runtime_error(message(code)), code_(code) {}
+
+    int code() const noexcept { return code_; }
+
+    static const char* message(int code) noexcept {
+        switch (code) {
+            case SEMVER_OK: return "no error";
+            case SEMVER_INVALID_VERSION: return "invalid version";
+            case SEMVER_INVALID_MAJOR: return "invalid major version";
+            case SEMVER_INVALID_MINOR: return "invalid minor version";
+            case SEMVER_INVALID_PATCH: return "invalid patch version";
+            case SEMVER_INVALID_PRERELEASE: return "invalid prerelease";
+            case SEMVER_INVALID_BUILD: return "invalid build";
+            case SEMVER_INVALID_VERSION_LIST: return "invalid version list";
+            case SEMVER_INVALID_RANGE: return "invalid range";
+            case SEMVER_OUT_OF_MEMORY: return "out of memory";
+            case SEMVER_INVALID_RANGE_ITEM: return "invalid range item";
+            case SEMVER_ITEM_FULL: return "range item is full";
+            case SEMVER_OUT_OF_RANGE: return "version is out of range";
+            case SEMVER_IO_ERROR: return "input/output error";
+            case SEMVER_INVALID_CATALOG: return "invalid catalog";
+            case SEMVER_BUFFER_TOO_SMALL: return "buffer is too small";
+            case SEMVER_INVALID_BLOB: return "invalid version blob";
+            case SEMVER_INVALID_HANDLE: return "invalid handle";
+            default: return "semver error";
+        }
+    }
+
+private:
+    int code_;
+};
+
+namespace detail {
+
+/* Calls fn with a NUL-terminated copy of str. Short strings are copied to
+ * the stack, so parsing usually does not allocate. A string with an
+ * embedded NUL gets NULL: C functions would silently stop at it
+ */
+template <class Fn>
+auto with_c_string(std::string_view str, Fn&& fn) {
+    if (std::memchr(str.data(), '\0', str.size()) != nullptr) {
+        return fn(static_cast<const char*>(nullptr));
+    }
+    char buf[128];
+    if (str.size() < sizeof(buf)) {
+        std::memcpy(buf, str.data(), str.size());
+        buf[str.size()] = '\0';
+        return fn(static_cast<const char*>(buf));
+    }
+    std::string copy(str);
+    return fn(copy.c_str());
+}
+
+/* Strings of SemVersion may fill the whole array without a NUL */
+constexpr std::string_view bounded_view(const char* str, std::size_t max_len) noexcept {
+    std::size_t len = 0;
+    while (len < max_len && str[len] != '\0') {
+        len++;
+    }
+    return std::string_view(str, len);
+}
+
+}
+
+class Version {
+public:
+    /* 0.0.0 */
+    constexpr Version() noexcept : ver_() {
+        ver_.prerelease = PRERELEASE_NONE;
+    }
+    constexpr explicit Version(const SemVersion& ver) noexcept : ver_(ver) {}
+    constexpr Version(unsigned int major, unsigned int minor, unsigned int patch) noexcept : Version() {
+        ver_.major = major;
+        ver_.minor = minor;
+        ver_.patch = patch;
+    }
+    /* Throws Error if str is not a valid version */
+    explicit Version(std::string_view str) : Version(parse(str)) {}
+
+    /* Returns nullopt if str is not a valid version, error (can be NULL)
+     * gets the code of parse_version. A long str is copied to the heap, and
+     * SEMVER_OUT_OF_MEMORY is the error if the copy fails
+     */
+    static std::optional<Version> try_parse(std::string_view str, int* error = nullptr) noexcept {
+        Version ver;
+        int res;
+        try {
+            res = detail::with_c_string(str, [&ver](const char* s) {
+                return s == nullptr ? SEMVER_INVALID_VERSION : parse_version(s, &ver.ver_);
+            });
+        } catch (const std::bad_alloc&) {
+            res = SEMVER_OUT_OF_MEMORY;
+        }
+        if (error != nullptr) {
+            *error = res;
+        }
+        if (res != SEMVER_OK) {
+            return std::nullopt;
+        }
+        return ver;
+    }
+
+    static Version parse(std::string_view str) {
+        int res;
+        std::optional<Version> ver = try_parse(str, &res);
+        if (res == SEMVER_OUT_OF_MEMORY) {
+            throw std::bad_alloc();
+        } else if (!ver) {
+            throw Error(res);
+        }
+        return *ver;
+    }
+
+    constexpr unsigned int major() const noexcept { return ver_.major; }
+    constexpr unsigned int minor() const noexcept { return ver_.minor; }
+    constexpr unsigned int patch() const noexcept { return ver_.patch; }
+    constexpr Prerelease prerelease() const noexcept { return ver_.prerelease; }
+    constexpr VersionCompare compare_operator() const noexcept { return ver_.cmp; }
+    std::string_view prerelease_str() const noexcept {
+        return detail::bounded_view(ver_.prerelease_str, MAX_PRERELEASE_LEN);
+    }
+    std::string_view build_str() const noexcept {
+        return detail::bounded_view(ver_.build_str, MAX_BUILD_LEN);
+    }
+    bool is_stable() const noexcept { return ver_.prerelease == PRERELEASE_NONE; }
+
+    constexpr const SemVersion& c_version() const noexcept { return ver_; }
+    constexpr SemVersion& c_version() noexcept { return ver_; }
+
+    /* version_equals: the version meets requirement with its compare operator */
+    bool meets(const Version& requirement) const noexcept {
+        return version_equals(&ver_, &requirement.ver_) != 0;
+    }
+
+    /* check_version. Throws Error if the list is invalid */
+    bool satisfies(std::string_view version_list) const {
+        int res = detail::with_c_string(version_list, [this](const char* s) {
+            return s == nullptr ? SEMVER_INVALID_VERSION_LIST : check_version(&ver_, s);
+        });
+        if (res != SEMVER_OK && res != SEMVER_OUT_OF_RANGE) {
+            throw Error(res);
+        }
+        return res == SEMVER_OK;
+    }
+
+    /* hash_version: equal versions have equal hashes */
+    std::size_t hash(int flags = 0) const noexcept {
+        return static_cast<std::size_t>(hash_version(&ver_, flags));
+    }
+
+    friend int compare(const Version& a, const Version& b) noexcept {
+        int res = compare_versions(&a.ver_, &b.ver_);
+        return res < 0 ? -1 : (res > 0 ? 1 : 0);
+    }
+
+#if defined(__cpp_impl_three_way_comparison) && __has_include(<compare>)
+    friend std::weak_ordering operator<=>(const Version& a, const Version& b) noexcept {
+        int res = compare(a, b);
+        return res < 0 ? std::weak_ordering::less :
+            (res > 0 ? std::weak_ordering::greater : std::weak_ordering::equivalent);
+    }
+    friend bool operator==(const Version& a, const Version& b) noexcept { return compare(a, b) == 0; }
+#else
+    friend bool operator==(const Version& a, const Version& b) noexcept { return compare(a, b) == 0; }
+    friend bool operator!=(const Version& a, const Version& b) noexcept { return compare(a, b) != 0; }
+    friend bool operator<(const Version& a, const Version& b) noexcept { return compare(a, b) < 0; }
+    friend bool operator<=(const Version& a, const Version& b) noexcept { return compare(a, b) <= 0; }
+    friend bool operator>(const Version& a, const Version& b) noexcept { return compare(a, b) > 0; }
+    friend bool operator>=(const Version& a, const Version& b) noexcept { return compare(a, b) >= 0; }
+#endif
+
+private:
+    SemVersion ver_;
+};
+
+/* Move-only owner of a VersionRange list */
+class RangeList {
+public:
+    RangeList() : head_(init_version_range()) {
+        if (head_ == nullptr) {
+            throw std::bad_alloc();
+        }
+    }
+    ~RangeList() { free_version_range(&head_); }
+
+    RangeList(const RangeList&) = delete;
+    RangeList& operator=(const RangeList&) = delete;
+    RangeList(RangeList&& other) noexcept : head_(std::exchange(other.head_, nullptr)) {}
+    RangeList& operator=(RangeList&& other) noexcept {
+        if (this != &other) {
+            free_version_range(&head_);
+            head_ = std::exchange(other.head_, nullptr);
+        }
+        return *this;
+    }
+
+    /* add_version: limit must have >, >=, <, or <= operator. Returns the
+     * range item that got the limit
+     */
+    VersionRange* add(const Version& limit, bool as_new = false) {
+        VersionCompare cmp = limit.compare_operator();
+        if (cmp != COMPARE_GREATER && cmp != COMPARE_GREATEROREQUAL && cmp != COMPARE_LESS && cmp != COMPARE_LESSOREQUAL) {
+            throw Error(SEMVER_INVALID_VERSION);
+        }
+        SemVersion ver = limit.c_version();
+        VersionRange* item = add_version(head_, &ver, as_new ? 1 : 0);
+        if (item == nullptr) {
+            throw std::bad_alloc();
+        }
+        return item;
+    }
+
+    /* complete_version_range */
+    void complete(VersionRange* item, const Version& limit) {
+        SemVersion ver = limit.c_version();
+        int res = complete_version_range(item, &ver);
+        if (res == SEMVER_OUT_OF_MEMORY) {
+            throw std::bad_alloc();
+        } else if (res != SEMVER_OK) {
+            throw Error(res);
+        }
+    }
+
+    int size() const noexcept { return range_size(head_); }
+
+    /* Returns true if the version fits any range of the list */
+    bool contains(const Version& ver) const noexcept {
+        for (const VersionRange* item = head_; item != nullptr; item = item->next) {
+            if (item->min_ver == nullptr && item->max_ver == nullptr) {
+                continue;
+            }
+            if ((item->min_ver == nullptr || version_equals(&ver.c_version(), item->min_ver)) &&
+                    (item->max_ver == nullptr || version_equals(&ver.c_version(), item->max_ver))) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    VersionRange* get() const noexcept { return head_; }
+    /* The caller frees the list with free_version_range */
+    VersionRange* release() noexcept { return std::exchange(head_, nullptr); }
+
+private:
+    VersionRange* head_;
+};
+
+/* A term of a version list: a version fits it if it meets all items.
+ * A term without items is '*'
+ */
+struct Term {
+    SemVersion items[2];
+    int count;
+
+    bool matches(const Version& ver) const noexcept {
+        for (int i = 0; i < count; i++) {
+            if (!version_equals(&ver.c_version(), &items[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+/* Terms of a version list (see walk_version_list) in an allocator-aware
+ * vector. matches gives the same result as check_version
+ */
+template <class Allocator = std::allocator<Term>>
+class BasicConstraint {
+public:
+    using allocator_type = Allocator;
+    using const_iterator = typename std::vector<Term, Allocator>::const_iterator;
+
+    explicit BasicConstraint(const Allocator& alloc = Allocator()) : terms_(alloc) {}
+    /* Throws Error if the list is invalid */
+    explicit BasicConstraint(std::string_view version_list, const Allocator& alloc = Allocator()) : terms_(alloc) {
+        assign(version_list);
+    }
+
+    /* Replaces terms with the terms of version_list. The constraint is not
+     * changed if the list is invalid
+     */
+    void assign(std::string_view version_list) {
+        Collector collector{std::vector<Term, Allocator>(terms_.get_allocator()), false};
+        int res = detail::with_c_string(version_list, [&collector](const char* s) {
+            return s == nullptr ? SEMVER_INVALID_VERSION_LIST : walk_version_list(s, collect, &collector);
+        });
+        if (collector.no_memory || res == SEMVER_OUT_OF_MEMORY) {
+            throw std::bad_alloc();
+        } else if (res != SEMVER_OK) {
+            throw Error(res);
+        }
+        terms_.swap(collector.terms);
+    }
+
+    bool matches(const Version& ver) const noexcept {
+        for (const Term& term : terms_) {
+            if (term.matches(ver)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::size_t size() const noexcept { return terms_.size(); }
+    const_iterator begin() const noexcept { return terms_.begin(); }
+    const_iterator end() const noexcept { return terms_.end(); }
+    allocator_type get_allocator() const noexcept { return terms_.get_allocator(); }
+
+private:
+    struct Collector {
+        std::vector<Term, Allocator> terms;
+        bool no_memory;
+    };
+
+    /* exceptions must not cross the C library */
+    static int collect(const SemVersion* items, int count, void* data) {
+        Collector* collector = static_cast<Collector*>(data);
+        if (count > 2) {
+            return SEMVER_INVALID_VERSION_LIST;
+        }
+        Term term = {};
+        for (int i = 0; i < count; i++) {
+            term.items[i] = items[i];
+        }
+        term.count = count;
+        try {
+            collector->terms.push_back(term);
+        } catch (...) {
+            collector->no_memory = true;
+            return SEMVER_OUT_OF_MEMORY;
+        }
+        return SEMVER_OK;
+    }
+
+    std::vector<Term, Allocator> terms_;
+};
+
+using Constraint = BasicConstraint<>;
+
+#if defined(__cpp_lib_memory_resource)
+namespace pmr {
+using Constraint = BasicConstraint<std::pmr::polymorphic_allocator<Term>>;
+using VersionVector = std::pmr::vector<Version>;
+}
+#endif
+
+}
+
+namespace std {
+template <>
+struct hash<semver::Version> {
+    size_t operator()(const semver::Version& ver) const noexcept {
+        return ver.hash();
+    }
+};
+}
+
+#endif
@@ -0,0 +1,66 @@
+﻿#ifndef SEMVER_ADAPTIVE_20261019
+#define SEMVER_ADAPTIVE_20261019
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Version lists with adaptive term order.
+ *
+ * An adaptive constraint is a compiled version list that learns which of
+ * its terms match most often. Every thread counts term hits of the
+ * constraints it checks in its own thread-local counters, and after every
+ * ADAPTIVE_PERIOD checks of a constraint the thread reorders its terms:
+ * terms with more hits per item go first. The order is a single 64-bit
+ * word (4 bits per position) that is published with an atomic store, so
+ * concurrent checks always see a whole order and the constraint needs
+ * no locks. The result never depends on the order.
+ *
+ * Lists with more than ADAPTIVE_MAX_TERMS terms are checked in the order
+ * walk_version_list reports their terms.
+ */
+
+#ifndef __cplusplus
+struct SemVersion;
+#endif
+struct constraint_term_t;
+
+#define ADAPTIVE_MAX_TERMS 16
+#define ADAPTIVE_PERIOD 1024
+
+typedef struct adaptive_constraint_t AdaptiveConstraint;
+
+/* Creates a constraint from terms, for example from an interned list
+ * (see semver_intern.h). Terms are copied. Returns NULL if there is no
+ * memory
+ */
+AdaptiveConstraint* create_adaptive_constraint(const struct constraint_term_t* terms, int count);
+
+/* Compiles version_list into a constraint. error (can be NULL) is set to
+ * SEMVER_OK, SEMVER_INVALID_VERSION_LIST, or SEMVER_OUT_OF_MEMORY
+ */
+AdaptiveConstraint* compile_adaptive_constraint(const char* version_list, int* error);
+
+/* The constraint must not be used by other threads */
+void free_adaptive_constraint(AdaptiveConstraint** constraint);
+
+/* The same as check_version with the list of the constraint. Can be
+ * called from many threads at once.
+ *
+ * Returns:
+ * SEMVER_OK - the version meets the requirements
+ * SEMVER_OUT_OF_RANGE - the version does not meet the requirements
+ * SEMVER_INVALID_VERSION - constraint or ver is NULL
+ */
+int check_adaptive_constraint(AdaptiveConstraint* constraint, const SemVersion* ver);
+
+/* Fills order with at most max term indices in the current evaluation
+ * order. Returns the number of terms
+ */
+int adaptive_constraint_order(const AdaptiveConstraint* constraint, int* order, int max);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
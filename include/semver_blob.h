@@ -0,0 +1,81 @@
+﻿#ifndef SEMVER_BLOB_20261019
+#define SEMVER_BLOB_20261019
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Compiled version list.
+ *
+ * A version list (see check_version) can be compiled once into a compact
+ * binary blob and then checked many times without parsing. The blob does
+ * not contain pointers and does not depend on alignment or byte order
+ * of the host, so it can be stored in a file or a database column and
+ * checked right from a mapped file or a column buffer.
+ *
+ * Layout (all integers are little-endian):
+ *   header - 16 bytes:
+ *     u32 magic, u16 format version, u16 term count,
+ *     u32 blob size, u32 checksum (FNV-1a of all bytes after header)
+ *   term offsets - u32 per term, offset of the term from the blob start
+ *   terms:
+ *     u8 item count, 3 reserved bytes, and items - 32 bytes per item:
+ *     u32 major, u32 minor, u32 patch, u8 compare operator,
+ *     u8 prerelease, 2 reserved bytes, 16 bytes of prerelease string
+ *     padded with zeroes
+ *
+ * A version fits a term if it meets requirements of all term items, and
+ * it meets the version list requirements if it fits any term. A term
+ * without items matches any version. Build part is not stored because
+ * it is not used to compare versions.
+ */
+
+#define VERSION_BLOB_MAGIC 0x42435653
+#define VERSION_BLOB_FORMAT 1
+#define VERSION_BLOB_HEADER_SIZE 16
+#define VERSION_BLOB_TERM_SIZE 4
+#define VERSION_BLOB_ITEM_SIZE 32
+#define VERSION_BLOB_MAX_TERMS 0xFFFF
+
+/* Compiles version_list into blob.
+ *
+ * blob can be NULL to get the required size only. blob_size is set to
+ * the size of the compiled list (or the required size if the buffer is
+ * too small).
+ *
+ * Returns:
+ * SEMVER_OK - the list is compiled
+ * SEMVER_INVALID_VERSION_LIST - version_list is NULL or invalid, or it
+ * has too many terms
+ * SEMVER_BUFFER_TOO_SMALL - blob is NULL or size is too small
+ * SEMVER_OUT_OF_MEMORY - failed to allocate temporary data
+ */
+int compile_version_list(const char* version_list, unsigned char* blob, size_t size, size_t* blob_size);
+
+/* Checks that blob of the given size is a valid compiled version list:
+ * header, checksum, term offsets, and all items.
+ *
+ * Returns SEMVER_OK or SEMVER_INVALID_BLOB
+ */
+int validate_version_blob(const unsigned char* blob, size_t size);
+
+/* The same as check_version but it uses compiled version list.
+ * The blob is not copied or unpacked. Only the header and term
+ * offsets are checked, so it is safe to use with any data, but
+ * blobs from untrusted sources must be checked with validate_version_blob.
+ *
+ * Returns:
+ * SEMVER_OK - the version meets the requirements
+ * SEMVER_OUT_OF_RANGE - the version does not meet the requirements
+ * SEMVER_INVALID_VERSION - ver is NULL
+ * SEMVER_INVALID_BLOB - blob is NULL or broken
+ */
+int check_version_blob(const SemVersion* ver, const unsigned char* blob, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
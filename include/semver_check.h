@@ -28,14 +28,65 @@ extern "C" {
  * >=1.11.0,<=1.14.1,!=1.12.20,1.10.9
  * 1.16.1 - 1.17.0,0.10.3 - 5.13.9,1.2.15 - 1.2.70
  *
+ * npm-style lists are supported as well: alternatives are separated
+ * with '||' and every alternative is a group of comparators separated
+ * with spaces - a version fits the group if it meets all comparators.
+ * A group can also be a 'min - max' range or '*'. A list is npm-style
+ * if it contains '||' or two comparators separated with spaces; commas
+ * in such a list separate alternatives too, and range limits are never
+ * paired across alternatives. Examples:
+ * >=1.2.0 <2.0.0 || ^3.1.0
+ * 1.0.0 - 2.0.0 !=1.5.0 || >=3.0.0
+ *
  * How check works:
- * At first it looks for the sinlge version rules (COMPARE_NONE,
- * COMPARE_EQUAL, COMPARE_NEQUAL, COMPARE_MAJOR, and COMPARE_MINOR).
- * If ver fits nothing of them then the function checks all version
- * ranges.
+ * The list is checked in one pass and the function returns as soon as
+ * ver fits a term. Single versions, ^ and ~ rules, and 'min - max'
+ * ranges are checked right after they are read; a >, >=, <, or <=
+ * limit is checked when it gets a pair (the same pairing as
+ * walk_version_list does) or at the end of the list. The function does
+ * not allocate memory unless the list has an item longer than 63
+ * characters or more than 8 unpaired limits at once.
+ * An npm-style list is compiled group by group into a disjunctive normal
+ * form: the limits of a group are intersected into one interval and every
+ * '!=' comparator splits it in two, so a group gives at most one term per
+ * '!=' comparator plus one. The terms of a group are checked right after
+ * the group is read (with one allocation for the whole list).
  */
 int check_version(const SemVersion* ver, const char *version_list);
 
+/* Callback for walk_version_list. items is an array of count versions
+ * with compare operators set. A version fits the term if it meets
+ * requirements of all its items. count is 0 for the special version
+ * list '*' - any version fits the term.
+ *
+ * The callback must return SEMVER_OK to continue walking. Any other
+ * value stops walking and walk_version_list returns it.
+ */
+typedef int (*VersionTermCallback)(const SemVersion* items, int count, void* data);
+
+/* Splits version_list into terms the same way check_version does and
+ * calls callback for every term. A version meets the requirements of the
+ * list if it fits any of the terms.
+ *
+ * Single versions are reported in the order of appearance, then all
+ * version ranges (including '^' and '~' items) are reported: a range has
+ * one or two items with COMPARE_GREATER, COMPARE_GREATEROREQUAL,
+ * COMPARE_LESS, or COMPARE_LESSOREQUAL operators. Terms of an npm-style
+ * list are reported in the order of its groups; a term is a single
+ * version with COMPARE_EQUAL or a range. A group that no version can
+ * meet reports no terms. A group with more than 16 '!=' comparators
+ * makes the list invalid.
+ *
+ * Returns:
+ * SEMVER_OK - all terms are reported
+ * SEMVER_INVALID_VERSION_LIST - version_list or callback is NULL, or
+ * the list contains invalid item. Ranges collected before the invalid
+ * item are reported before returning the error
+ * SEMVER_OUT_OF_MEMORY - failed to allocate memory for a temporary data
+ * any other value - the value returned by callback
+ */
+int walk_version_list(const char* version_list, VersionTermCallback callback, void* data);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,78 @@
+﻿#ifndef SEMVER_GROUP_20261019
+#define SEMVER_GROUP_20261019
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Grouped aggregation over version arrays: the newest version for every
+ * MAJOR.MINOR line, for every MAJOR line, or the newest version overall.
+ *
+ * Versions are grouped with a hash table in a single pass, no sorting of
+ * versions is needed. Only the resulting groups are sorted.
+ */
+
+#ifndef __cplusplus
+struct SemVersion;
+#endif
+
+typedef enum version_grouping_t {
+    /* one group for all versions */
+    GROUP_ALL,
+    /* a group for every major version */
+    GROUP_BY_MAJOR,
+    /* a group for every major and minor version pair */
+    GROUP_BY_MINOR,
+} VersionGrouping;
+
+/* Which versions are aggregated, flags can be combined */
+#define VERSION_FILTER_OTHER (1 << PRERELEASE_BASIC)
+#define VERSION_FILTER_ALPHA (1 << PRERELEASE_ALPHA)
+#define VERSION_FILTER_BETA (1 << PRERELEASE_BETA)
+#define VERSION_FILTER_RC (1 << PRERELEASE_RC)
+/* versions without prerelease */
+#define VERSION_FILTER_RELEASE (1 << PRERELEASE_NONE)
+#define VERSION_FILTER_ANY (VERSION_FILTER_OTHER | VERSION_FILTER_ALPHA | VERSION_FILTER_BETA | \
+        VERSION_FILTER_RC | VERSION_FILTER_RELEASE)
+
+typedef struct version_group_t {
+    /* group key, parts that are not used by grouping are 0 */
+    unsigned int major;
+    unsigned int minor;
+    /* index of the newest version of the group */
+    int latest;
+    /* number of versions in the group */
+    int count;
+} VersionGroup;
+
+/* Finds the newest version of every group among versions that pass the
+ * filter (a combination of VERSION_FILTER_* flags). The newest version
+ * is the first one that is greater than all previous versions of the
+ * group in compare_versions order.
+ *
+ * Groups are written to groups sorted by key. group_count gets the
+ * number of groups even if groups is too small.
+ *
+ * Returns:
+ * SEMVER_OK
+ * SEMVER_INVALID_VERSION - versions is NULL and count is not 0, or group_count is NULL
+ * SEMVER_BUFFER_TOO_SMALL - there are more than max_groups groups
+ * SEMVER_OUT_OF_MEMORY
+ */
+int group_latest_versions(const SemVersion* versions, int count, VersionGrouping grouping, int filter,
+        VersionGroup* groups, int max_groups, int* group_count);
+
+/* The same as group_latest_versions, but the array is split into parts
+ * processed by up to threads threads, and then the results are merged.
+ * Results are the same as group_latest_versions gives as long as
+ * compare_versions orders the versions of a group consistently (it may
+ * not for prereleases where one identifier is a prefix of another one).
+ */
+int group_latest_versions_parallel(const SemVersion* versions, int count, VersionGrouping grouping, int filter,
+        VersionGroup* groups, int max_groups, int* group_count, int threads);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
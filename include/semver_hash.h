@@ -0,0 +1,87 @@
+﻿#ifndef SEMVER_HASH_20261019
+#define SEMVER_HASH_20261019
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Version hashing and a version hash map.
+ *
+ * hash_version agrees with compare_versions: if compare_versions(a, b) is
+ * 0 then hash_version(a) == hash_version(b). So the hash mixes only what
+ * compare_versions looks at: numbers, prerelease type, and prerelease
+ * identifiers the way compare_versions reads them (a numeric identifier
+ * by its value, so "rc.01" and "rc.1" are equal, and other identifiers by
+ * their first character because compare_versions compares identifiers
+ * only up to the length of the shorter one). Build part is skipped.
+ *
+ * The only exception is an empty prerelease identifier (e.g, "1.0.0-a..b"
+ * that is not a valid semantic version): compare_versions treats it as
+ * equal to any other identifier, and no hash can follow that.
+ */
+
+#ifndef __cplusplus
+struct SemVersion;
+#endif
+
+/* Build parts must be equal too: the hash includes build part, and the
+ * map compares build parts as strings
+ */
+#define VERSION_HASH_BUILD 1
+
+unsigned long long hash_version(const SemVersion* version, int flags);
+
+/* Returns 1 if versions are equal for a hash map with the given flags */
+int version_hash_equals(const SemVersion* ver_a, const SemVersion* ver_b, int flags);
+
+/* Map entry. Entries are stored inline in the table, on 64-bit systems
+ * an entry takes 64 bytes, one cache line
+ */
+typedef struct version_map_entry_t {
+    /* high 32 bits of the version hash (never 0), 0 means the slot is empty */
+    unsigned int hash;
+    SemVersion version;
+    void* value;
+} VersionMapEntry;
+
+/* Open addressing hash map with linear probing. Removed entries are not
+ * marked: entries after them are shifted back, so lookups never pass
+ * through deleted slots. A map with all values NULL works as a set.
+ */
+typedef struct version_map_t {
+    VersionMapEntry* entries;
+    /* number of slots, a power of 2 */
+    int capacity;
+    int count;
+    int flags;
+} VersionMap;
+
+VersionMap* init_version_map(int flags);
+void free_version_map(VersionMap** map);
+void clear_version_map(VersionMap* map);
+
+/* Finds the entry of the version or adds a new one with NULL value.
+ * added (can be NULL) gets 1 if the entry is new. The entry pointer is
+ * valid until the next insert or remove.
+ *
+ * Returns NULL if map or version is NULL, or if there is no memory
+ */
+VersionMapEntry* version_map_insert(VersionMap* map, const SemVersion* version, int* added);
+
+/* Returns the entry of the version or NULL */
+VersionMapEntry* version_map_find(const VersionMap* map, const SemVersion* version);
+
+/* Returns 1 if the version was in the map, and 0 otherwise */
+int version_map_remove(VersionMap* map, const SemVersion* version);
+
+/* Iterates entries: returns the entry after entry (NULL means the
+ * first one), or NULL after the last entry. The map must not change
+ * while it is iterated.
+ */
+VersionMapEntry* version_map_next(const VersionMap* map, const VersionMapEntry* entry);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,110 @@
+﻿#ifndef SEMVER_HISTORY_20261019
+#define SEMVER_HISTORY_20261019
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Delta-compressed version history.
+ *
+ * A version array sorted in compare_versions order (e.g, all versions of
+ * a package) is encoded into a compact binary buffer. Like a compiled
+ * version list, the buffer does not contain pointers and does not depend
+ * on alignment or byte order of the host.
+ *
+ * Versions are split into blocks of VERSION_HISTORY_BLOCK versions, and
+ * every block is decoded independently, so a reader can skip blocks
+ * without decoding them.
+ *
+ * Layout (all integers are little-endian):
+ *   header - 16 bytes:
+ *     u32 magic, u16 format version, u16 versions per block,
+ *     u32 version count, u32 buffer size
+ *   block index - 16 bytes per block:
+ *     u32 offset of the block from the buffer start, u32 major,
+ *     u32 minor, u32 patch of the first version of the block
+ *   blocks - a record per version:
+ *     u8 tag: bits 0-1 - which number changed first (0 - patch,
+ *       1 - minor, 2 - major), bits 2-4 - prerelease, bit 5 - prerelease
+ *       string changed, bit 6 - build string changed
+ *     numbers as LEB128 varints: the delta of the first changed number
+ *       and the following numbers as is (e.g, only the patch delta if
+ *       major and minor did not change)
+ *     changed strings front-coded against the previous version: u8 length
+ *       of the common prefix, u8 length of the suffix, and the suffix
+ *
+ * The first version of a block is encoded against version 0.0.0 with
+ * empty strings. Compare operators are not stored, decoded versions
+ * have COMPARE_NONE and zero bytes after the end of their strings.
+ */
+
+#define VERSION_HISTORY_MAGIC 0x48445653
+#define VERSION_HISTORY_FORMAT 1
+#define VERSION_HISTORY_HEADER_SIZE 16
+#define VERSION_HISTORY_INDEX_SIZE 16
+#define VERSION_HISTORY_BLOCK 128
+
+/* Encodes count versions sorted in compare_versions order into data.
+ *
+ * data can be NULL to get the required size only. data_size is set to
+ * the size of the encoded history (or the required size if the buffer
+ * is too small).
+ *
+ * Returns:
+ * SEMVER_OK - versions are encoded
+ * SEMVER_INVALID_VERSION - versions is NULL and count is not 0, or the
+ * versions are not sorted
+ * SEMVER_BUFFER_TOO_SMALL - data is NULL or size is too small
+ */
+int encode_version_history(const SemVersion* versions, int count, unsigned char* data, size_t size,
+        size_t* data_size);
+
+/* Streaming decoder. The buffer is not copied: it must stay unchanged
+ * while the decoder is used
+ */
+typedef struct history_decoder_t {
+    const unsigned char* data;
+    size_t size;
+    int count;
+    int block_size;
+    int block_count;
+    /* index of the next version */
+    int next;
+    /* offset of the next record and the end of its block */
+    size_t pos;
+    size_t block_end;
+    /* the last decoded version of the current block */
+    SemVersion last;
+} HistoryDecoder;
+
+/* Checks the header and the block index and positions the decoder at
+ * the first version. Records are checked while they are decoded.
+ *
+ * Returns SEMVER_OK, SEMVER_INVALID_VERSION if decoder is NULL, or
+ * SEMVER_INVALID_BLOB if data is NULL or broken
+ */
+int init_history_decoder(HistoryDecoder* decoder, const unsigned char* data, size_t size);
+
+/* Decodes up to max next versions to versions. Returns the number of
+ * decoded versions (0 at the end of the history) or -1 if the record is
+ * broken
+ */
+int history_decoder_read(HistoryDecoder* decoder, SemVersion* versions, int max);
+
+/* Positions the decoder at the first version that is not less than ver:
+ * blocks that end before ver are skipped with the block index, and only
+ * the block where ver can be is decoded.
+ *
+ * Returns the index of the next version (the version count if all
+ * versions are less than ver), or -1 if the arguments are invalid or
+ * the record is broken
+ */
+int history_decoder_seek(HistoryDecoder* decoder, const SemVersion* ver);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
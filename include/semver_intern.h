@@ -0,0 +1,103 @@
+﻿#ifndef SEMVER_INTERN_20261019
+#define SEMVER_INTERN_20261019
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Interned version lists.
+ *
+ * A constraint table keeps every distinct version list once, parsed into
+ * its terms, and hands out small integer handles. The list is stored in
+ * a canonical form: the terms that walk_version_list reports, with '='
+ * and no operator made the same, unused prerelease and build strings
+ * cleared, terms sorted and duplicates removed, and any list with '*'
+ * reduced to '*'. So "1.0.0,^2.0.0" and " ^2.0.0, =1.0.0,1.0.0" get the
+ * same handle. Equal handles always mean lists that match the same
+ * versions (but lists written with different terms can still match the
+ * same versions and get different handles).
+ *
+ * Handles are reference counted: intern_constraint and retain_constraint
+ * add a reference, release_constraint drops it. A list is freed when its
+ * last reference is dropped, and its handle can be given to another list
+ * later. The table is not thread safe.
+ */
+
+#ifndef __cplusplus
+struct SemVersion;
+#endif
+
+/* 0 is never a valid handle */
+#define INVALID_CONSTRAINT 0
+
+typedef struct constraint_term_t {
+    /* 0 - any version fits the term, 1 - a single version or a one-limit
+     * range, 2 - a range
+     */
+    int count;
+    SemVersion items[2];
+} ConstraintTerm;
+
+typedef struct interned_constraint_t {
+    ConstraintTerm* terms;
+    int term_count;
+    /* 0 for a free handle */
+    int refs;
+    unsigned int hash;
+    /* the next free handle if the handle is free */
+    unsigned int next_free;
+} InternedConstraint;
+
+typedef struct constraint_table_t {
+    /* constraints by handle, constraints[0] is not used */
+    InternedConstraint* constraints;
+    unsigned int capacity;
+    /* handles in use and the head of the free handle list */
+    unsigned int count;
+    unsigned int free_head;
+    /* open addressing index of handles by canonical form, 0 is an empty
+     * slot; slot_count is a power of 2
+     */
+    unsigned int* slots;
+    unsigned int slot_count;
+} ConstraintTable;
+
+ConstraintTable* init_constraint_table();
+void free_constraint_table(ConstraintTable** table);
+
+/* Parses version_list and sets handle to the handle of its canonical form
+ * with a new reference.
+ *
+ * Returns:
+ * SEMVER_OK - handle is set
+ * SEMVER_INVALID_VERSION_LIST - version_list is NULL or invalid
+ * SEMVER_OUT_OF_MEMORY - failed to allocate memory
+ */
+int intern_constraint(ConstraintTable* table, const char* version_list, unsigned int* handle);
+
+/* Adds a reference. Returns SEMVER_OK or SEMVER_INVALID_HANDLE */
+int retain_constraint(ConstraintTable* table, unsigned int handle);
+
+/* Drops a reference, the last one frees the list. Returns SEMVER_OK or
+ * SEMVER_INVALID_HANDLE
+ */
+int release_constraint(ConstraintTable* table, unsigned int handle);
+
+/* Returns the interned list of the handle or NULL if the handle is not in use */
+const InternedConstraint* get_constraint(const ConstraintTable* table, unsigned int handle);
+
+/* The same as check_version with the interned list.
+ *
+ * Returns:
+ * SEMVER_OK - the version meets the requirements
+ * SEMVER_OUT_OF_RANGE - the version does not meet the requirements
+ * SEMVER_INVALID_VERSION - ver is NULL
+ * SEMVER_INVALID_HANDLE - the handle is not in use
+ */
+int check_constraint(const ConstraintTable* table, unsigned int handle, const SemVersion* ver);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
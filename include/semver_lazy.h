@@ -0,0 +1,78 @@
+﻿#ifndef SEMVER_LAZY_20261019
+#define SEMVER_LAZY_20261019
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Lazily decoded versions.
+ *
+ * parse_lazy_version reads only the compare operator and the version
+ * numbers and remembers where the '-' or '+' tail starts. The prerelease
+ * is classified and copied on first access: compare_lazy_versions decodes
+ * it only if both versions have the same numbers, so sorting and
+ * filtering versions that mostly differ in numbers never touches the
+ * tails. The build part is read only by lazy_version_to_semver.
+ *
+ * A lazy version points to its source string, so the string must stay
+ * valid while the version is used. Decoding writes to the version, so a
+ * version shared between threads must be decoded (decode_lazy_version)
+ * before other threads compare it.
+ */
+
+#ifndef __cplusplus
+struct SemVersion;
+#endif
+
+/* Validate the whole string as parse_version does. Without the flag the
+ * prerelease is validated when it is decoded, and the build part by
+ * lazy_version_to_semver
+ */
+#define LAZY_VERSION_STRICT 1
+
+typedef struct lazy_version_t {
+    unsigned int major;
+    unsigned int minor;
+    unsigned int patch;
+    VersionCompare cmp;
+    /* the version string */
+    const char* str;
+    /* offset of the '-' or '+' tail in str, -1 if there is no tail */
+    int tail;
+    /* 1 if prerelease fields are decoded */
+    int decoded;
+    /* SEMVER_OK or the error of the tail, set by decoding */
+    int tail_error;
+    Prerelease prerelease;
+    char prerelease_str[MAX_PRERELEASE_LEN];
+} LazyVersion;
+
+/* Parses the version numbers of str. Returns SEMVER_OK, or the same error
+ * as parse_version: without LAZY_VERSION_STRICT only for the compare
+ * operator and the numbers.
+ * A version without prerelease is decoded right away
+ */
+int parse_lazy_version(const char* str, int flags, LazyVersion* version);
+
+/* Decodes prerelease of the version if it is not decoded yet. Returns
+ * SEMVER_OK or the parse_version error of the tail. A version with an
+ * invalid tail keeps the part of prerelease before the invalid character,
+ * the same as parse_version leaves in SemVersion
+ */
+int decode_lazy_version(LazyVersion* version);
+
+/* Returns the same as compare_versions for the versions parsed with
+ * parse_version. Prereleases are decoded only if the numbers are equal
+ */
+int compare_lazy_versions(LazyVersion* ver_a, LazyVersion* ver_b);
+
+/* Fills SemVersion with all parts of the version including build.
+ * Returns SEMVER_OK or the parse_version error of the tail
+ */
+int lazy_version_to_semver(const LazyVersion* version, SemVersion* semver);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
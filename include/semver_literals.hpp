@@ -0,0 +1,612 @@
+﻿#ifndef SEMVER_LITERALS_HPP_20261019
+#define SEMVER_LITERALS_HPP_20261019
+
+/*
+ * Compile-time version and version list literals (C++20).
+ *
+ * The parser and the version list compiler are constexpr copies of
+ * parse_version and walk_version_list: the same operators (including ^
+ * and ~), 'min - max' ranges, prerelease ranks, and the same pairing of
+ * range limits into terms. A malformed literal does not compile.
+ *
+ *     using namespace semver::literals;
+ *     constexpr auto supported = ">=2.3.0,<3.0.0,4.0.0"_semver_list;
+ *     static_assert(supported.matches("2.5.0"_semver));
+ *
+ * The result of "..."_semver_list is a StaticConstraint: its terms are
+ * constants, so matches() is a few integer comparisons and the prerelease
+ * strings are compared only when all version numbers are equal. It gives
+ * the same result as check_version with the same list.
+ *
+ * Literals take comma-separated lists only. check_version also accepts
+ * npm-style lists with space-separated comparators and '||', but such a
+ * literal is malformed and does not compile: write ">=1.2.0 <2.0.0 ||
+ * 3.0.0" as ">=1.2.0,<2.0.0,3.0.0".
+ */
+
+#if !defined(__cpp_consteval) || !defined(__cpp_nontype_template_args) || __cpp_nontype_template_args < 201911L
+#error "semver_literals.hpp requires C++20"
+#endif
+
+#include <array>
+#include <climits>
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+
+#include "semver.hpp"
+
+namespace semver {
+
+namespace detail {
+
+/* A part of a string. Reading past its end gives '\0', the same as
+ * reading the NUL-terminated copy the C functions work with
+ */
+struct TextView {
+    const char* str;
+    std::size_t len;
+
+    constexpr char operator[](std::size_t idx) const noexcept {
+        return idx < len ? str[idx] : '\0';
+    }
+    constexpr TextView substr(std::size_t from, std::size_t count) const noexcept {
+        return TextView{ str + from, count };
+    }
+};
+
+constexpr bool is_digit(char c) noexcept {
+    return c >= '0' && c <= '9';
+}
+
+constexpr bool is_valid_char(char c) noexcept {
+    return is_digit(c) || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '.';
+}
+
+constexpr bool begins_with(TextView text, std::size_t pos, const char* with) noexcept {
+    for (; *with != '\0'; pos++, with++) {
+        if (text[pos] != *with) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* strtol of a run of digits: saturates at LONG_MAX */
+constexpr long read_long(TextView text, std::size_t& pos) noexcept {
+    constexpr long max = std::numeric_limits<long>::max();
+    long value = 0;
+    for (; is_digit(text[pos]); pos++) {
+        int digit = text[pos] - '0';
+        value = value > (max - digit) / 10 ? max : value * 10 + digit;
+    }
+    return value;
+}
+
+/* constexpr copy of parse_version */
+constexpr int parse_version(TextView text, SemVersion& version) noexcept {
+    version = SemVersion{};
+    version.prerelease = PRERELEASE_NONE;
+
+    std::size_t pos = 0;
+    while (text[pos] == ' ' || text[pos] == 'v' || text[pos] == 'V') {
+        pos++;
+    }
+
+    if (! is_digit(text[pos])) {
+        constexpr const char* multi[] = { "!=", "==", ">=", "<=" };
+        constexpr VersionCompare multi_val[] = {
+            COMPARE_NEQUAL, COMPARE_EQUAL, COMPARE_GREATEROREQUAL, COMPARE_LESSOREQUAL
+        };
+        constexpr char single[] = { '^', '~', '<', '>', '=' };
+        constexpr VersionCompare single_val[] = {
+            COMPARE_MAJOR, COMPARE_MINOR, COMPARE_LESS, COMPARE_GREATER, COMPARE_EQUAL
+        };
+
+        VersionCompare cmp = COMPARE_NONE;
+        for (std::size_t i = 0; i < 4 && cmp == COMPARE_NONE; i++) {
+            if (begins_with(text, pos, multi[i])) {
+                cmp = multi_val[i];
+                pos += 2;
+            }
+        }
+        for (std::size_t i = 0; i < 5 && cmp == COMPARE_NONE; i++) {
+            if (text[pos] == single[i]) {
+                cmp = single_val[i];
+                pos++;
+            }
+        }
+        if (cmp == COMPARE_NONE) {
+            return SEMVER_INVALID_MAJOR;
+        }
+        version.cmp = cmp;
+    }
+
+    unsigned int parts[PART_COUNT] = { 0, 0, 0 };
+    constexpr int err[PART_COUNT] = { SEMVER_INVALID_MAJOR, SEMVER_INVALID_MINOR, SEMVER_INVALID_PATCH };
+    for (int i = 0; i < PART_COUNT; i++) {
+        while (text[pos] == ' ') {
+            pos++;
+        }
+        if (! is_digit(text[pos])) {
+            return err[i];
+        }
+        parts[i] = static_cast<unsigned int>(read_long(text, pos));
+        if (parts[i] == INVALID_NUMBER) {
+            return err[i];
+        }
+        if (i != PART_COUNT - 1) {
+            if (text[pos] != '.') {
+                return err[i];
+            }
+            pos++;
+        }
+    }
+
+    if (text[pos] != '\0' && text[pos] != '+' && text[pos] != '-') {
+        return SEMVER_INVALID_PATCH;
+    }
+    version.major = parts[0];
+    version.minor = parts[1];
+    version.patch = parts[2];
+
+    if (text[pos] == '-') {
+        pos++;
+        version.prerelease = begins_with(text, pos, "alpha") ? PRERELEASE_ALPHA :
+            begins_with(text, pos, "beta") ? PRERELEASE_BETA :
+            begins_with(text, pos, "rc") ? PRERELEASE_RC : PRERELEASE_BASIC;
+
+        int idx = 0;
+        for (; text[pos] != '\0' && text[pos] != '+'; pos++) {
+            if (! is_valid_char(text[pos])) {
+                return SEMVER_INVALID_PRERELEASE;
+            }
+            if (idx < MAX_PRERELEASE_LEN - 1) {
+                version.prerelease_str[idx++] = text[pos];
+            }
+        }
+    }
+
+    if (text[pos] != '\0') {
+        pos++;
+        int idx = 0;
+        for (; is_valid_char(text[pos]); pos++) {
+            if (idx < MAX_BUILD_LEN) {
+                version.build_str[idx++] = text[pos];
+            }
+        }
+        while (text[pos] == ' ') {
+            pos++;
+        }
+    }
+
+    return text[pos] == '\0' ? SEMVER_OK : SEMVER_INVALID_BUILD;
+}
+
+constexpr const char* skip_identifier(const char* str) noexcept {
+    while (*str != '\0') {
+        if (*str++ == '.') {
+            break;
+        }
+    }
+    return str;
+}
+
+/* atoi of a run of digits */
+constexpr int read_int(const char* str) noexcept {
+    constexpr long max = std::numeric_limits<long>::max();
+    long value = 0;
+    for (; is_digit(*str); str++) {
+        int digit = *str - '0';
+        value = value > (max - digit) / 10 ? max : value * 10 + digit;
+    }
+    return static_cast<int>(value);
+}
+
+/* constexpr copy of compare_prerelease for versions of the same prerelease type */
+constexpr int compare_prerelease_str(Prerelease type, const char* pre_a, const char* pre_b) noexcept {
+    if (type != PRERELEASE_BASIC) {
+        pre_a = skip_identifier(pre_a);
+        pre_b = skip_identifier(pre_b);
+    }
+
+    if (*pre_a == '\0' && *pre_b != '\0') {
+        return -1;
+    } else if (*pre_a != '\0' && *pre_b == '\0') {
+        return 1;
+    }
+
+    while (*pre_a != '\0' && *pre_b != '\0') {
+        if (is_digit(*pre_a) && is_digit(*pre_b)) {
+            int int_a = read_int(pre_a);
+            int int_b = read_int(pre_b);
+            if (int_a != int_b) {
+                return int_a < int_b ? -1 : 1;
+            }
+        } else {
+            int len_a = 0;
+            int len_b = 0;
+            while (pre_a[len_a] != '\0' && pre_a[len_a] != '.') {
+                len_a++;
+            }
+            while (pre_b[len_b] != '\0' && pre_b[len_b] != '.') {
+                len_b++;
+            }
+            int to_cmp = len_a > len_b ? len_b : len_a;
+            for (int i = 0; i < to_cmp; i++) {
+                unsigned char ca = static_cast<unsigned char>(pre_a[i]);
+                unsigned char cb = static_cast<unsigned char>(pre_b[i]);
+                if (ca != cb) {
+                    return ca < cb ? -1 : 1;
+                }
+            }
+        }
+
+        pre_a = skip_identifier(pre_a);
+        pre_b = skip_identifier(pre_b);
+    }
+
+    if (*pre_a == '\0' && *pre_b != '\0') {
+        return 1;
+    } else if (*pre_a != '\0' && *pre_b == '\0') {
+        return -1;
+    }
+    return 0;
+}
+
+/* constexpr copy of compare_versions: the sign is the same */
+constexpr int compare_versions(const SemVersion& ver_a, const SemVersion& ver_b) noexcept {
+    if (ver_a.major != ver_b.major) {
+        return ver_a.major < ver_b.major ? -1 : 1;
+    }
+    if (ver_a.minor != ver_b.minor) {
+        return ver_a.minor < ver_b.minor ? -1 : 1;
+    }
+    if (ver_a.patch != ver_b.patch) {
+        return ver_a.patch < ver_b.patch ? -1 : 1;
+    }
+    if (ver_a.prerelease != ver_b.prerelease) {
+        return ver_a.prerelease < ver_b.prerelease ? -1 : 1;
+    }
+    if (ver_a.prerelease == PRERELEASE_NONE) {
+        return 0;
+    }
+    return compare_prerelease_str(ver_a.prerelease, ver_a.prerelease_str, ver_b.prerelease_str);
+}
+
+/* constexpr copy of version_equals for the operators that compiled
+ * version lists contain
+ */
+constexpr bool version_meets(const SemVersion& ver, const SemVersion& limit) noexcept {
+    int r = compare_versions(ver, limit);
+    switch (limit.cmp) {
+        case COMPARE_NEQUAL: return r != 0;
+        case COMPARE_GREATER: return r > 0;
+        case COMPARE_GREATEROREQUAL: return r >= 0;
+        case COMPARE_LESS: return r < 0;
+        case COMPARE_LESSOREQUAL: return r <= 0;
+        default: return r == 0;
+    }
+}
+
+/* A range term: one or both limits */
+struct StaticRange {
+    SemVersion min_ver;
+    SemVersion max_ver;
+    bool has_min;
+    bool has_max;
+
+    constexpr bool matches(const SemVersion& ver) const noexcept {
+        return (! has_min || version_meets(ver, min_ver)) && (! has_max || version_meets(ver, max_ver));
+    }
+};
+
+/* Terms of a version list, at most Capacity of every kind */
+template <std::size_t Capacity>
+struct CompiledList {
+    int error = SEMVER_OK;
+    bool any = false;
+    std::array<SemVersion, Capacity> singles{};
+    std::size_t single_count = 0;
+    /* range nodes in the order of the VersionRange list, empty ones included */
+    std::array<StaticRange, Capacity> nodes{};
+    std::size_t node_count = 0;
+
+    constexpr bool matches(const SemVersion& ver) const noexcept {
+        if (any) {
+            return true;
+        }
+        for (std::size_t i = 0; i < single_count; i++) {
+            if (version_meets(ver, singles[i])) {
+                return true;
+            }
+        }
+        for (std::size_t i = 0; i < node_count; i++) {
+            if ((nodes[i].has_min || nodes[i].has_max) && nodes[i].matches(ver)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    constexpr std::size_t range_count() const noexcept {
+        std::size_t count = 0;
+        for (std::size_t i = 0; i < node_count; i++) {
+            count += nodes[i].has_min || nodes[i].has_max;
+        }
+        return count;
+    }
+
+    /* add_version: returns the node the limit is put to */
+    constexpr std::size_t add_limit(const SemVersion& v, bool as_new) noexcept {
+        bool is_min = v.cmp == COMPARE_GREATER || v.cmp == COMPARE_GREATEROREQUAL;
+        if (node_count == 0) {
+            nodes[node_count++] = StaticRange{};
+        }
+        if (! as_new) {
+            for (std::size_t i = 0; i < node_count; i++) {
+                if (is_min ? ! nodes[i].has_min : ! nodes[i].has_max) {
+                    set_limit(i, v);
+                    return i;
+                }
+            }
+        }
+
+        StaticRange& last = nodes[node_count - 1];
+        if (last.has_min || last.has_max) {
+            nodes[node_count++] = StaticRange{};
+        }
+        set_limit(node_count - 1, v);
+        return node_count - 1;
+    }
+
+    /* complete_version_range */
+    constexpr int complete_limit(std::size_t node, const SemVersion& v) noexcept {
+        bool is_min = v.cmp == COMPARE_GREATER || v.cmp == COMPARE_GREATEROREQUAL;
+        if (is_min ? nodes[node].has_min : nodes[node].has_max) {
+            return SEMVER_ITEM_FULL;
+        }
+        set_limit(node, v);
+        return SEMVER_OK;
+    }
+
+    constexpr void set_limit(std::size_t node, const SemVersion& v) noexcept {
+        if (v.cmp == COMPARE_GREATER || v.cmp == COMPARE_GREATEROREQUAL) {
+            nodes[node].min_ver = v;
+            nodes[node].has_min = true;
+        } else {
+            nodes[node].max_ver = v;
+            nodes[node].has_max = true;
+        }
+    }
+};
+
+constexpr std::size_t find_char(TextView text, std::size_t pos, char c) noexcept {
+    for (; text[pos] != '\0'; pos++) {
+        if (text[pos] == c) {
+            return pos;
+        }
+    }
+    return SIZE_MAX;
+}
+
+constexpr std::size_t find_dash(TextView text, std::size_t pos) noexcept {
+    for (; text[pos] != '\0'; pos++) {
+        if (begins_with(text, pos, " - ")) {
+            return pos;
+        }
+    }
+    return SIZE_MAX;
+}
+
+/* constexpr copy of walk_version_list */
+template <std::size_t Capacity>
+constexpr CompiledList<Capacity> compile_version_list(TextView list) noexcept {
+    CompiledList<Capacity> res;
+
+    std::size_t pos = 0;
+    while (list[pos] == ' ') {
+        pos++;
+    }
+    if (list[pos] == '*') {
+        res.any = true;
+        return res;
+    }
+
+    int in_range = 0;
+    std::size_t first_item = 0;
+    bool item_exists = true;
+    while (item_exists) {
+        /* read_list_item */
+        while (list[pos] == ' ' || list[pos] == ',' || list[pos] == '-') {
+            pos++;
+        }
+        if (list[pos] == '\0') {
+            break;
+        }
+
+        std::size_t comma = find_char(list, pos, ',');
+        std::size_t dash = find_dash(list, pos);
+        SemVersion v{};
+        int parse = SEMVER_OK;
+        if (comma == SIZE_MAX && dash == SIZE_MAX) {
+            std::size_t end = pos;
+            while (list[end] != '\0') {
+                end++;
+            }
+            item_exists = false;
+            parse = parse_version(list.substr(pos, end - pos), v);
+            if (in_range == 1) {
+                v.cmp = COMPARE_LESSOREQUAL;
+                in_range = 2;
+            }
+        } else if (dash < comma) {
+            if (in_range) {
+                res.error = SEMVER_INVALID_VERSION_LIST;
+                return res;
+            }
+            in_range = 1;
+            parse = parse_version(list.substr(pos, dash - pos), v);
+            v.cmp = COMPARE_GREATEROREQUAL;
+            pos = dash + 3;
+        } else {
+            parse = parse_version(list.substr(pos, comma - pos), v);
+            pos = comma + 1;
+            if (in_range == 1) {
+                v.cmp = COMPARE_LESSOREQUAL;
+                in_range = 2;
+            }
+        }
+        if (parse != SEMVER_OK) {
+            res.error = SEMVER_INVALID_VERSION_LIST;
+            return res;
+        }
+
+        if (v.cmp == COMPARE_NEQUAL || v.cmp == COMPARE_NONE || v.cmp == COMPARE_EQUAL) {
+            res.singles[res.single_count++] = v;
+        } else if (v.cmp == COMPARE_MAJOR || v.cmp == COMPARE_MINOR) {
+            VersionCompare compare = v.cmp;
+            v.cmp = COMPARE_GREATEROREQUAL;
+            first_item = res.add_limit(v, true);
+
+            v.prerelease = PRERELEASE_NONE;
+            v.cmp = COMPARE_LESS;
+            v.patch = 0;
+            if (compare == COMPARE_MAJOR) {
+                v.minor = 0;
+                v.major++;
+            } else {
+                v.minor++;
+            }
+            res.error = res.complete_limit(first_item, v);
+        } else if (in_range == 1) {
+            first_item = res.add_limit(v, true);
+        } else if (in_range == 2) {
+            res.error = res.complete_limit(first_item, v);
+            in_range = 0;
+        } else {
+            res.add_limit(v, false);
+        }
+        if (res.error != SEMVER_OK) {
+            return res;
+        }
+    }
+
+    return res;
+}
+
+/* A string literal as a template argument */
+template <std::size_t N>
+struct FixedString {
+    char str[N]{};
+
+    constexpr FixedString(const char (&s)[N]) noexcept {
+        for (std::size_t i = 0; i < N; i++) {
+            str[i] = s[i];
+        }
+    }
+    constexpr TextView view() const noexcept {
+        return TextView{ str, N - 1 };
+    }
+};
+
+/* Not constexpr: calling them during constant evaluation is the compile
+ * error for a malformed literal, and the error message names the reason
+ */
+inline void invalid_version_literal() {}
+inline void invalid_version_list_literal() {}
+
+} // namespace detail
+
+/* Compiled version list. Singles are versions with =, ==, != or no
+ * operator, Ranges are range terms with one or two limits
+ */
+template <std::size_t Singles, std::size_t Ranges>
+class StaticConstraint {
+public:
+    template <std::size_t Capacity>
+    constexpr explicit StaticConstraint(const detail::CompiledList<Capacity>& list) noexcept : any_(list.any) {
+        for (std::size_t i = 0; i < Singles; i++) {
+            singles_[i] = list.singles[i];
+        }
+        std::size_t idx = 0;
+        for (std::size_t i = 0; i < list.node_count; i++) {
+            if (list.nodes[i].has_min || list.nodes[i].has_max) {
+                ranges_[idx++] = list.nodes[i];
+            }
+        }
+    }
+
+    /* The same as check_version(&ver, list) == SEMVER_OK */
+    constexpr bool matches(const SemVersion& ver) const noexcept {
+        if (any_) {
+            return true;
+        }
+        for (const SemVersion& single : singles_) {
+            if (detail::version_meets(ver, single)) {
+                return true;
+            }
+        }
+        for (const detail::StaticRange& range : ranges_) {
+            if (range.matches(ver)) {
+                return true;
+            }
+        }
+        return false;
+    }
+    constexpr bool matches(const Version& ver) const noexcept {
+        return matches(ver.c_version());
+    }
+
+    /* The number of terms walk_version_list reports */
+    constexpr std::size_t size() const noexcept {
+        return any_ ? 1 : Singles + Ranges;
+    }
+
+private:
+    bool any_;
+    std::array<SemVersion, Singles> singles_{};
+    std::array<detail::StaticRange, Ranges> ranges_{};
+};
+
+template <detail::FixedString S>
+consteval Version make_static_version() {
+    SemVersion ver{};
+    if (detail::parse_version(S.view(), ver) != SEMVER_OK) {
+        detail::invalid_version_literal();
+    }
+    return Version(ver);
+}
+
+template <detail::FixedString S>
+consteval auto make_static_constraint() {
+    constexpr auto list = detail::compile_version_list<sizeof(S.str)>(S.view());
+    if (list.error != SEMVER_OK) {
+        detail::invalid_version_list_literal();
+    }
+    return StaticConstraint<list.single_count, list.range_count()>(list);
+}
+
+template <detail::FixedString S>
+inline constexpr Version static_version = make_static_version<S>();
+
+template <detail::FixedString S>
+inline constexpr auto static_constraint = make_static_constraint<S>();
+
+namespace literals {
+
+template <detail::FixedString S>
+consteval Version operator""_semver() {
+    return make_static_version<S>();
+}
+
+template <detail::FixedString S>
+consteval auto operator""_semver_list() {
+    return make_static_constraint<S>();
+}
+
+} // namespace literals
+
+} // namespace semver
+
+#endif
@@ -0,0 +1,81 @@
+﻿#ifndef SEMVER_LIVE_20261019
+#define SEMVER_LIVE_20261019
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Concurrent ordered version index for live registries.
+ *
+ * Versions are kept sorted in compare_versions order in blocks of up to
+ * LIVE_BLOCK_SIZE versions. The whole index is an immutable snapshot: an
+ * array of block pointers. A writer copies the block it changes (a full
+ * block is split in two), builds a new block array that shares all other
+ * blocks, and publishes the new snapshot with one atomic store. Writers
+ * are serialized with a mutex, readers take no locks and never wait.
+ *
+ * A reader sees one snapshot between live_reader_enter and
+ * live_reader_exit, so all its queries are consistent with each other.
+ * Replaced snapshots and blocks are freed with epoch-based reclamation:
+ * a reader publishes the global epoch when it enters, and the writer
+ * frees memory retired before the oldest epoch of the readers that are
+ * inside.
+ */
+
+#ifndef __cplusplus
+struct SemVersion;
+#endif
+
+#define LIVE_BLOCK_SIZE 128
+
+typedef struct live_index_t LiveIndex;
+typedef struct live_reader_t LiveReader;
+typedef struct live_snapshot_t LiveSnapshot;
+
+/* Returns NULL if there is no memory */
+LiveIndex* create_live_index();
+/* There must be no readers inside and no writers. Open readers are closed */
+void free_live_index(LiveIndex** index);
+
+/* Adds a version to the index. Can be called from many threads at once.
+ * A version equal to one in the index (build part is ignored) is not
+ * added, and added (if it is not NULL) is set to 0.
+ *
+ * Returns SEMVER_OK, SEMVER_INVALID_VERSION if index or ver is NULL, or
+ * SEMVER_OUT_OF_MEMORY
+ */
+int live_index_insert(LiveIndex* index, const SemVersion* ver, int* added);
+
+/* Returns the number of versions in the latest snapshot */
+int live_index_count(LiveIndex* index);
+
+/* Every reading thread opens its own reader. Returns NULL if there is no
+ * memory. Closed readers are reused by the next open_live_reader
+ */
+LiveReader* open_live_reader(LiveIndex* index);
+void close_live_reader(LiveReader** reader);
+
+/* Pins the latest snapshot. It stays valid until live_reader_exit, even
+ * if writers publish new ones. Calls must not be nested
+ */
+const LiveSnapshot* live_reader_enter(LiveReader* reader);
+void live_reader_exit(LiveReader* reader);
+
+int live_snapshot_count(const LiveSnapshot* snapshot);
+
+/* Reads the version with the given rank. Returns SEMVER_OK or
+ * SEMVER_INVALID_VERSION if idx is out of range
+ */
+int live_snapshot_get(const LiveSnapshot* snapshot, int idx, SemVersion* version);
+
+/* Finds the highest version that meets version_list requirements (see
+ * check_version). Returns its rank or -1 if there is no such version or
+ * the list is invalid
+ */
+int live_snapshot_max_satisfying(const LiveSnapshot* snapshot, const char* version_list, SemVersion* version);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
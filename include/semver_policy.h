@@ -0,0 +1,93 @@
+﻿#ifndef SEMVER_POLICY_20261019
+#define SEMVER_POLICY_20261019
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Hot-reloadable version policies.
+ *
+ * A policy is text with one rule per line:
+ *   <package> allow <version list>
+ *   <package> deny <version list>
+ * Empty lines and lines starting with '#' are skipped. A version list is
+ * the rest of the line (see check_version and walk_version_list, compound
+ * lists are supported). Rules of the package '*' apply to all packages.
+ *
+ * A version of a package is rejected if it fits any of its deny lists.
+ * Otherwise, if the package has allow lists, the version must fit one of
+ * them, and a package without allow lists accepts any version.
+ *
+ * A policy set holds the latest compiled policy as an immutable snapshot.
+ * A reload parses and compiles the whole policy on the calling thread and
+ * publishes the new snapshot with one atomic store; reloads are serialized
+ * with a mutex, checks take no locks and never wait. A reader keeps the
+ * snapshot it entered with until policy_reader_exit, and old snapshots
+ * are freed with epoch-based reclamation when no reader can see them.
+ */
+
+#ifndef __cplusplus
+struct SemVersion;
+#endif
+
+typedef struct policy_set_t PolicySet;
+typedef struct policy_reader_t PolicyReader;
+typedef struct policy_snapshot_t PolicySnapshot;
+
+/* Creates a set with an empty policy (generation 0) that accepts any
+ * version. Returns NULL if there is no memory
+ */
+PolicySet* create_policy_set();
+/* There must be no readers inside and no reloads. Open readers are closed */
+void free_policy_set(PolicySet** set);
+
+/* Compiles a policy of the given length and replaces the current one.
+ * Can be called from many threads at once. If the policy is invalid the
+ * current one is kept and error_line (can be NULL) is set to the number
+ * of the first invalid line (starting from 1), otherwise it is set to 0.
+ *
+ * Returns:
+ * SEMVER_OK - the new policy is published
+ * SEMVER_INVALID_VERSION_LIST - a line is not a rule or its list is invalid
+ * SEMVER_INVALID_HANDLE - set or policy is NULL
+ * SEMVER_OUT_OF_MEMORY - failed to allocate the new policy
+ */
+int reload_policy_set(PolicySet* set, const char* policy, size_t len, int* error_line);
+
+/* Reads a policy file and calls reload_policy_set. Returns the same codes
+ * and SEMVER_IO_ERROR if the file cannot be read
+ */
+int load_policy_file(PolicySet* set, const char* path, int* error_line);
+
+/* Every checking thread opens its own reader. Returns NULL if there is no
+ * memory. Closed readers are reused by the next open_policy_reader
+ */
+PolicyReader* open_policy_reader(PolicySet* set);
+void close_policy_reader(PolicyReader** reader);
+
+/* Pins the current policy. It stays valid until policy_reader_exit, even
+ * if the set is reloaded. Calls must not be nested
+ */
+const PolicySnapshot* policy_reader_enter(PolicyReader* reader);
+void policy_reader_exit(PolicyReader* reader);
+
+/* Returns the number of successful reloads of the set up to the one that
+ * published the snapshot, 0 is the empty policy of a new set */
+unsigned long long policy_snapshot_generation(const PolicySnapshot* snapshot);
+
+/* Checks a version of package against the policy.
+ *
+ * Returns:
+ * SEMVER_OK - the version is accepted
+ * SEMVER_OUT_OF_RANGE - the version is rejected
+ * SEMVER_INVALID_VERSION - snapshot, package, or ver is NULL
+ */
+int check_policy(const PolicySnapshot* snapshot, const char* package, const SemVersion* ver);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
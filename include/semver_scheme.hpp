@@ -0,0 +1,324 @@
+﻿#ifndef SEMVER_SCHEME_HPP_20261019
+#define SEMVER_SCHEME_HPP_20261019
+
+/*
+ * Version types of other numbering schemes (C++20).
+ *
+ * BasicVersion<Parts, HasPrerelease> is a version of Parts numbers
+ * separated with '.', with an optional prerelease (only if HasPrerelease)
+ * and an optional build part:
+ *
+ *     semver::QuadVersion ver = semver::QuadVersion::parse("1.2.3.4");
+ *     semver::CalendarVersion cal = semver::CalendarVersion::parse("2026.10.17");
+ *
+ * compare(), hash(), and key() are unrolled for the number of parts at
+ * compile time. For SemanticVersion (3 parts and a prerelease) they give
+ * the same results as compare_versions and hash_version.
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string_view>
+#include <utility>
+#if __has_include(<compare>)
+#include <compare>
+#endif
+
+#include "semver_literals.hpp"
+
+namespace semver {
+
+namespace detail {
+
+constexpr unsigned long long hash_multiplier = 0x9e3779b97f4a7c15ull;
+
+/* the same mixing step as hash_version uses */
+constexpr unsigned long long hash_mix(unsigned long long hash, unsigned long long value) noexcept {
+    hash = (hash ^ value) * hash_multiplier;
+    return hash ^ (hash >> 29);
+}
+
+/* Prerelease of a scheme that has it */
+struct PrereleasePart {
+    Prerelease type = PRERELEASE_NONE;
+    char str[MAX_PRERELEASE_LEN] = {};
+};
+
+struct NoPrerelease {};
+
+} // namespace detail
+
+template <std::size_t Parts, bool HasPrerelease>
+class BasicVersion {
+    static_assert(Parts > 0, "a version needs at least one part");
+
+public:
+    static constexpr std::size_t part_count = Parts;
+    static constexpr bool has_prerelease = HasPrerelease;
+
+    /* Order preserving key: version numbers are packed 32 bits each from
+     * the highest bits of the first word, then the prerelease type. Keys
+     * compare as the versions do, except for prerelease strings
+     */
+    using Key = std::array<std::uint64_t, (Parts * 32 + (HasPrerelease ? 8 : 0) + 63) / 64>;
+
+    /* 0.0...0 */
+    constexpr BasicVersion() noexcept = default;
+
+    /* Versions from SemVersion and back: only for SemanticVersion */
+    constexpr explicit BasicVersion(const SemVersion& ver) noexcept
+        requires (Parts == PART_COUNT && HasPrerelease)
+        : parts_{ ver.major, ver.minor, ver.patch } {
+        pre_.type = ver.prerelease;
+        for (int i = 0; i < MAX_PRERELEASE_LEN; i++) {
+            pre_.str[i] = ver.prerelease_str[i];
+        }
+        for (int i = 0; i < MAX_BUILD_LEN; i++) {
+            build_[i] = ver.build_str[i];
+        }
+    }
+
+    constexpr SemVersion c_version() const noexcept
+        requires (Parts == PART_COUNT && HasPrerelease) {
+        SemVersion ver{};
+        ver.major = parts_[0];
+        ver.minor = parts_[1];
+        ver.patch = parts_[2];
+        ver.prerelease = pre_.type;
+        for (int i = 0; i < MAX_PRERELEASE_LEN; i++) {
+            ver.prerelease_str[i] = pre_.str[i];
+        }
+        for (int i = 0; i < MAX_BUILD_LEN; i++) {
+            ver.build_str[i] = build_[i];
+        }
+        return ver;
+    }
+
+    /* Parses the version the same way parse_version does, except that
+     * compare operators are not allowed. Part i that is not a valid number
+     * is SEMVER_INVALID_MAJOR, SEMVER_INVALID_MINOR, SEMVER_INVALID_PATCH
+     * for the first three parts, and SEMVER_INVALID_VERSION for the rest.
+     * A prerelease in a scheme without it is SEMVER_INVALID_PRERELEASE
+     */
+    static constexpr int parse(std::string_view str, BasicVersion& ver) noexcept {
+        detail::TextView text{ str.data(), str.size() };
+        ver = BasicVersion();
+
+        std::size_t pos = 0;
+        while (text[pos] == ' ' || text[pos] == 'v' || text[pos] == 'V') {
+            pos++;
+        }
+
+        for (std::size_t i = 0; i < Parts; i++) {
+            int err = i == 0 ? SEMVER_INVALID_MAJOR : i == 1 ? SEMVER_INVALID_MINOR :
+                i == 2 ? SEMVER_INVALID_PATCH : SEMVER_INVALID_VERSION;
+            while (text[pos] == ' ') {
+                pos++;
+            }
+            if (! detail::is_digit(text[pos])) {
+                return err;
+            }
+            ver.parts_[i] = static_cast<unsigned int>(detail::read_long(text, pos));
+            if (ver.parts_[i] == INVALID_NUMBER) {
+                return err;
+            }
+            if (i != Parts - 1) {
+                if (text[pos] != '.') {
+                    return err;
+                }
+                pos++;
+            }
+        }
+
+        if (text[pos] != '\0' && text[pos] != '+' && text[pos] != '-') {
+            return Parts > 3 ? SEMVER_INVALID_VERSION : SEMVER_INVALID_PATCH;
+        }
+
+        if (text[pos] == '-') {
+            if constexpr (! HasPrerelease) {
+                return SEMVER_INVALID_PRERELEASE;
+            } else {
+                pos++;
+                ver.pre_.type = detail::begins_with(text, pos, "alpha") ? PRERELEASE_ALPHA :
+                    detail::begins_with(text, pos, "beta") ? PRERELEASE_BETA :
+                    detail::begins_with(text, pos, "rc") ? PRERELEASE_RC : PRERELEASE_BASIC;
+
+                int idx = 0;
+                for (; text[pos] != '\0' && text[pos] != '+'; pos++) {
+                    if (! detail::is_valid_char(text[pos])) {
+                        return SEMVER_INVALID_PRERELEASE;
+                    }
+                    if (idx < MAX_PRERELEASE_LEN - 1) {
+                        ver.pre_.str[idx++] = text[pos];
+                    }
+                }
+            }
+        }
+
+        if (text[pos] != '\0') {
+            pos++;
+            int idx = 0;
+            for (; detail::is_valid_char(text[pos]); pos++) {
+                if (idx < MAX_BUILD_LEN) {
+                    ver.build_[idx++] = text[pos];
+                }
+            }
+            while (text[pos] == ' ') {
+                pos++;
+            }
+        }
+
+        return text[pos] == '\0' ? SEMVER_OK : SEMVER_INVALID_BUILD;
+    }
+
+    static constexpr std::optional<BasicVersion> try_parse(std::string_view str, int* error = nullptr) noexcept {
+        BasicVersion ver;
+        int res = parse(str, ver);
+        if (error != nullptr) {
+            *error = res;
+        }
+        if (res != SEMVER_OK) {
+            return std::nullopt;
+        }
+        return ver;
+    }
+
+    static BasicVersion parse(std::string_view str) {
+        BasicVersion ver;
+        int res = parse(str, ver);
+        if (res != SEMVER_OK) {
+            throw Error(res);
+        }
+        return ver;
+    }
+
+    constexpr unsigned int part(std::size_t idx) const noexcept { return parts_[idx]; }
+    constexpr const std::array<unsigned int, Parts>& parts() const noexcept { return parts_; }
+
+    constexpr Prerelease prerelease() const noexcept {
+        if constexpr (HasPrerelease) {
+            return pre_.type;
+        } else {
+            return PRERELEASE_NONE;
+        }
+    }
+    constexpr std::string_view prerelease_str() const noexcept {
+        if constexpr (HasPrerelease) {
+            return detail::bounded_view(pre_.str, MAX_PRERELEASE_LEN);
+        } else {
+            return std::string_view();
+        }
+    }
+    constexpr std::string_view build_str() const noexcept {
+        return detail::bounded_view(build_, MAX_BUILD_LEN);
+    }
+
+    /* -1, 0, or 1. Build parts are not compared */
+    friend constexpr int compare(const BasicVersion& a, const BasicVersion& b) noexcept {
+        int res = compare_parts(a, b, std::make_index_sequence<Parts>());
+        if constexpr (HasPrerelease) {
+            if (res == 0 && a.pre_.type != b.pre_.type) {
+                res = a.pre_.type < b.pre_.type ? -1 : 1;
+            }
+            if (res == 0 && a.pre_.type != PRERELEASE_NONE) {
+                int r = detail::compare_prerelease_str(a.pre_.type, a.pre_.str, b.pre_.str);
+                res = r < 0 ? -1 : (r > 0 ? 1 : 0);
+            }
+        }
+        return res;
+    }
+
+    /* Consistent with compare: equal versions have the same hash. Parts
+     * are mixed two at a time, and the prerelease type of a scheme without
+     * prereleases is PRERELEASE_NONE
+     */
+    constexpr unsigned long long hash() const noexcept {
+        unsigned long long hash = detail::hash_multiplier;
+        for (std::size_t i = 0; i + 1 < Parts; i += 2) {
+            hash = detail::hash_mix(hash, (static_cast<unsigned long long>(parts_[i]) << 32) | parts_[i + 1]);
+        }
+        if constexpr (Parts % 2 == 1) {
+            hash = detail::hash_mix(hash, (static_cast<unsigned long long>(parts_[Parts - 1]) << 32) |
+                    static_cast<unsigned int>(prerelease()));
+        } else {
+            hash = detail::hash_mix(hash, static_cast<unsigned int>(prerelease()));
+        }
+
+        if constexpr (HasPrerelease) {
+            if (pre_.type != PRERELEASE_NONE) {
+                /* identifiers are read as compare reads them */
+                const char* pre = pre_.str;
+                if (pre_.type != PRERELEASE_BASIC) {
+                    pre = detail::skip_identifier(pre);
+                }
+                while (*pre != '\0') {
+                    if (detail::is_digit(*pre)) {
+                        hash = detail::hash_mix(hash, (1ull << 32) | static_cast<unsigned int>(detail::read_int(pre)));
+                    } else {
+                        hash = detail::hash_mix(hash, static_cast<unsigned char>(*pre));
+                    }
+                    pre = detail::skip_identifier(pre);
+                }
+            }
+        }
+
+        hash ^= hash >> 32;
+        return hash * detail::hash_multiplier;
+    }
+
+    constexpr Key key() const noexcept {
+        Key key{};
+        for (std::size_t i = 0; i < Parts; i++) {
+            key[i / 2] |= static_cast<std::uint64_t>(parts_[i]) << (i % 2 == 0 ? 32 : 0);
+        }
+        if constexpr (HasPrerelease) {
+            key[Parts / 2] |= static_cast<std::uint64_t>(pre_.type) << (Parts % 2 == 0 ? 56 : 24);
+        }
+        return key;
+    }
+
+    friend constexpr std::weak_ordering operator<=>(const BasicVersion& a, const BasicVersion& b) noexcept {
+        int res = compare(a, b);
+        return res < 0 ? std::weak_ordering::less :
+            (res > 0 ? std::weak_ordering::greater : std::weak_ordering::equivalent);
+    }
+    friend constexpr bool operator==(const BasicVersion& a, const BasicVersion& b) noexcept {
+        return compare(a, b) == 0;
+    }
+
+private:
+    template <std::size_t... I>
+    static constexpr int compare_parts(const BasicVersion& a, const BasicVersion& b, std::index_sequence<I...>) noexcept {
+        int res = 0;
+        /* stops at the first different part */
+        (void)((res = a.parts_[I] == b.parts_[I] ? 0 : (a.parts_[I] < b.parts_[I] ? -1 : 1), res == 0) && ...);
+        return res;
+    }
+
+    std::array<unsigned int, Parts> parts_{};
+    [[no_unique_address]] std::conditional_t<HasPrerelease, detail::PrereleasePart, detail::NoPrerelease> pre_{};
+    char build_[MAX_BUILD_LEN] = {};
+};
+
+/* major.minor.patch-prerelease+build */
+using SemanticVersion = BasicVersion<3, true>;
+/* a.b.c.d+build */
+using QuadVersion = BasicVersion<4, false>;
+/* year.month.day+build */
+using CalendarVersion = BasicVersion<3, false>;
+
+} // namespace semver
+
+namespace std {
+template <std::size_t Parts, bool HasPrerelease>
+struct hash<semver::BasicVersion<Parts, HasPrerelease>> {
+    size_t operator()(const semver::BasicVersion<Parts, HasPrerelease>& ver) const noexcept {
+        return static_cast<size_t>(ver.hash());
+    }
+};
+}
+
+#endif
@@ -0,0 +1,59 @@
+﻿#ifndef SEMVER_SEARCH_20261019
+#define SEMVER_SEARCH_20261019
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Static search index over a version array sorted in compare_versions
+ * order.
+ *
+ * Every version is packed into a 64-bit key that keeps compare_versions
+ * order: 20 bits for each of major, minor, and patch, and the prerelease
+ * type. A number that does not fit its bits saturates the rest of the key.
+ * Keys are stored in Eytzinger (breadth-first) order of the implicit
+ * binary search tree, so the first levels of the tree share a few cache
+ * lines and the keys of the next 4 levels are prefetched while a level
+ * is compared. compare_versions is called only when the keys are equal
+ * and a key does not describe the version completely (prerelease
+ * versions and saturated keys).
+ *
+ * The index keeps a pointer to the sorted array: the array must not be
+ * changed or freed while the index is used. Searches do not change the
+ * index, so many threads can search at once.
+ */
+
+#ifndef __cplusplus
+struct SemVersion;
+#endif
+
+typedef struct version_search_t VersionSearch;
+
+/* Builds an index of count versions sorted in compare_versions order.
+ * error (if it is not NULL) gets SEMVER_OK, SEMVER_INVALID_VERSION if
+ * sorted is NULL and count is not 0 or the versions are not sorted, or
+ * SEMVER_OUT_OF_MEMORY. Returns NULL on error
+ */
+VersionSearch* build_version_search(const SemVersion* sorted, int count, int* error);
+void free_version_search(VersionSearch** search);
+
+/* Returns the rank (the index in the sorted array) of the first version
+ * that is not less than ver, or the number of versions if there is no
+ * such version
+ */
+int version_search_lower_bound(const VersionSearch* search, const SemVersion* ver);
+/* Returns the rank of the first version that is greater than ver, or the
+ * number of versions if there is no such version
+ */
+int version_search_upper_bound(const VersionSearch* search, const SemVersion* ver);
+/* Returns 1 if the array has a version equal to ver in compare_versions
+ * order (build part is ignored), 0 otherwise. If rank is not NULL it gets
+ * the rank of the first equal version
+ */
+int version_search_contains(const VersionSearch* search, const SemVersion* ver, int* rank);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
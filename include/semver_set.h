@@ -0,0 +1,64 @@
+﻿#ifndef SEMVER_SET_20261019
+#define SEMVER_SET_20261019
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Set operations over version arrays sorted in compare_versions order.
+ *
+ * Arrays are merged in linear time. When one array is much smaller than
+ * the other, runs of the larger array are skipped or copied with
+ * exponential (galloping) search, so the time is close to
+ * O(m * log(n / m)) for arrays of sizes m and n.
+ *
+ * Arrays may have equal versions: they are handled as the C++
+ * std::set_* algorithms do, e.g. the intersection of [1.0.0, 1.0.0] and
+ * [1.0.0] is [1.0.0].
+ */
+
+#ifndef __cplusplus
+struct SemVersion;
+#endif
+
+/* Versions are equal only if their build parts are equal too. Versions
+ * equal in compare_versions order must be sorted by build part (see
+ * compare_set_versions)
+ */
+#define VERSION_SET_COMPARE_BUILD 1
+
+/* Compares versions in the order set operations expect: the same as
+ * compare_versions, and if flags has VERSION_SET_COMPARE_BUILD then
+ * versions with equal numbers and prerelease are compared by build part
+ * as strings. Returns -1, 0, or 1
+ */
+int compare_set_versions(const SemVersion* ver_a, const SemVersion* ver_b, int flags);
+
+/* All functions write the result to out, and out_count gets the number
+ * of versions in the result even if out is too small. A version that is
+ * in both arrays is taken from set_a.
+ *
+ * Returns:
+ * SEMVER_OK
+ * SEMVER_INVALID_VERSION - an array is NULL and its count is not 0, or out_count is NULL
+ * SEMVER_BUFFER_TOO_SMALL - the result has more than max_out versions
+ */
+
+/* Versions that are in set_a or set_b */
+int version_set_union(const SemVersion* set_a, int count_a, const SemVersion* set_b, int count_b, int flags,
+        SemVersion* out, int max_out, int* out_count);
+/* Versions that are in both set_a and set_b */
+int version_set_intersection(const SemVersion* set_a, int count_a, const SemVersion* set_b, int count_b, int flags,
+        SemVersion* out, int max_out, int* out_count);
+/* Versions of set_a that are not in set_b */
+int version_set_difference(const SemVersion* set_a, int count_a, const SemVersion* set_b, int count_b, int flags,
+        SemVersion* out, int max_out, int* out_count);
+/* Versions that are in only one of set_a and set_b */
+int version_set_symmetric_difference(const SemVersion* set_a, int count_a, const SemVersion* set_b, int count_b,
+        int flags, SemVersion* out, int max_out, int* out_count);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
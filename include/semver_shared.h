@@ -0,0 +1,106 @@
+﻿#ifndef SEMVER_SHARED_20261019
+#define SEMVER_SHARED_20261019
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Cross-process cache of compiled version lists.
+ *
+ * The cache lives in a named shared memory segment (POSIX shm_open, or a
+ * named file mapping on Windows), so every process that opens it with
+ * the same name reuses lists that other processes already compiled.
+ * Nothing in the segment is a pointer, and it can be mapped at any
+ * address. Layout (all integers are in the host byte order):
+ *
+ *   header - 32 bytes: u32 magic, u32 format version, u32 slot count,
+ *            u32 segment size, u32 data offset, u32 used data size,
+ *            u32 entry count, u32 reserved
+ *   slots  - open addressing hash table, u64 per slot:
+ *            (FNV-1a hash of the list << 32) | entry offset, 0 - empty
+ *   data   - entries, 8-byte aligned: u32 list length, u32 blob size,
+ *            the NUL-terminated list, padding to 4 bytes, and the
+ *            compiled list (see semver_blob.h)
+ *
+ * Insertion takes no locks: a process reserves space for an entry with a
+ * compare-and-swap of the used data size, writes the entry, and then
+ * publishes its offset with a compare-and-swap of an empty slot. If
+ * another process published the same list first, the existing entry is
+ * used and the reserved space is lost. A process that dies while writing
+ * an entry loses only the space it reserved. Entries are never removed:
+ * when the data is full new lists are not cached.
+ *
+ * The cache needs lock-free 64-bit atomics, and all processes must be
+ * built for the same architecture.
+ */
+
+#ifndef __cplusplus
+struct SemVersion;
+#endif
+
+#define SHARED_CACHE_MAGIC 0x48435653
+#define SHARED_CACHE_FORMAT 1
+#define SHARED_CACHE_MIN_SIZE 4096
+
+typedef struct shared_cache_t SharedCache;
+
+typedef struct shared_cache_stats_t {
+    unsigned int slot_count;
+    unsigned int entry_count;
+    /* sizes of the data area in bytes */
+    unsigned int data_size;
+    unsigned int data_used;
+} SharedCacheStats;
+
+/* Opens the cache with the given name ("/name" on POSIX systems) or
+ * creates it with size bytes (at least SHARED_CACHE_MIN_SIZE, less than
+ * 4 GB) if it does not exist. The size of an existing cache is not
+ * changed. The cache must be closed with close_shared_cache.
+ *
+ * Returns:
+ * SEMVER_OK - the cache is opened
+ * SEMVER_IO_ERROR - failed to create, open, or map the segment, or its
+ * creator did not initialize it in time
+ * SEMVER_INVALID_BLOB - the segment is not a cache of this format
+ * SEMVER_OUT_OF_MEMORY - out of memory
+ */
+int open_shared_cache(const char* name, size_t size, SharedCache** cache);
+
+/* Unmaps the cache and sets the pointer to NULL. Blobs returned by
+ * shared_cache_get become invalid */
+void close_shared_cache(SharedCache** cache);
+
+/* Removes the name of the segment: processes that have the cache open
+ * keep using it, and the next open_shared_cache creates a new one.
+ * Returns SEMVER_OK or SEMVER_IO_ERROR. On Windows the segment is removed
+ * when the last process closes it, and the function does nothing
+ */
+int remove_shared_cache(const char* name);
+
+/* Finds the compiled version_list in the cache, or compiles and adds it.
+ * blob points into the segment and stays valid until the cache is closed.
+ *
+ * Returns:
+ * SEMVER_OK - blob and size are set
+ * SEMVER_INVALID_VERSION_LIST - version_list is NULL or invalid
+ * SEMVER_BUFFER_TOO_SMALL - the list is not in the cache and the cache is full
+ * SEMVER_INVALID_HANDLE - cache is NULL
+ * SEMVER_OUT_OF_MEMORY - failed to allocate temporary data
+ */
+int shared_cache_get(SharedCache* cache, const char* version_list, const unsigned char** blob, size_t* size);
+
+/* The same as check_version, but the list is compiled at most once for
+ * all processes. If the list cannot be cached the version is checked
+ * with check_version
+ */
+int check_version_shared(SharedCache* cache, const SemVersion* ver, const char* version_list);
+
+void shared_cache_stats(const SharedCache* cache, SharedCacheStats* stats);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
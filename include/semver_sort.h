@@ -0,0 +1,45 @@
+﻿#ifndef SEMVER_SORT_20261019
+#define SEMVER_SORT_20261019
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Parallel sort of version arrays in compare_versions order.
+ *
+ * The numeric parts of every version are copied to a compact key array,
+ * and only keys are moved while sorting: compare_versions is called only
+ * for keys with the same numbers and prerelease type. Every thread sorts
+ * its own part of the keys, and then the parts are merged in rounds where
+ * every merge is split between threads too.
+ */
+
+#ifndef __cplusplus
+struct SemVersion;
+#endif
+
+/* Versions that compare equal keep their order */
+#define VERSION_SORT_STABLE 1
+
+/* Sorts versions in place with up to threads threads. threads less than 1
+ * means the number of processors. Small arrays are sorted with fewer
+ * threads.
+ *
+ * Returns:
+ * SEMVER_OK
+ * SEMVER_INVALID_VERSION - versions is NULL and count is not 0
+ * SEMVER_OUT_OF_MEMORY
+ */
+int sort_versions(SemVersion* versions, int count, int flags, int threads);
+
+/* Sorts indices into versions: after the call versions[indices[0]] is the
+ * lowest version. versions are not changed. indices must contain count
+ * valid indices of versions (e.g, 0 .. count-1), duplicates are allowed.
+ */
+int sort_version_indices(const SemVersion* versions, int* indices, int count, int flags, int threads);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
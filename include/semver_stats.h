@@ -0,0 +1,103 @@
+﻿#ifndef SEMVER_STATS_20261019
+#define SEMVER_STATS_20261019
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Library statistics: call counters and latency histograms of the library
+ * entry points, and counters of what happens inside version list checks.
+ *
+ * Statistics are collected only if the library is built with SEMVER_STATS
+ * defined (make DEFINES=-DSEMVER_STATS). Otherwise all hooks are compiled
+ * out and the functions below return empty statistics.
+ *
+ * Every thread updates its own block of counters, so updates do not take
+ * locks and do not use atomic read-modify-write instructions. A snapshot
+ * sums the blocks of all threads: it is not an exact point-in-time copy if
+ * other threads are working. Blocks of finished threads are kept, so their
+ * counts are not lost.
+ */
+
+/* Timed library functions */
+typedef enum stats_entry_t {
+    STATS_PARSE_VERSION,
+    STATS_COMPARE_VERSIONS,
+    STATS_VERSION_EQUALS,
+    STATS_CHECK_VERSION,
+    STATS_WALK_VERSION_LIST,
+    STATS_ADD_VERSION,
+    STATS_COMPLETE_VERSION_RANGE,
+    STATS_COMPILE_VERSION_LIST,
+    STATS_CHECK_VERSION_BLOB,
+    STATS_VALIDATE_VERSION,
+    STATS_ENTRY_COUNT,
+} StatsEntry;
+
+typedef enum stats_counter_t {
+    /* version lists split into terms */
+    STATS_LISTS,
+    /* terms reported by walk_version_list (terms per list is TERMS / LISTS) */
+    STATS_TERMS,
+    /* VersionRange nodes created */
+    STATS_RANGE_NODES,
+    /* memory allocations made while checking version lists and building ranges */
+    STATS_ALLOCATIONS,
+    /* check_version calls matched by a single version term */
+    STATS_SINGLE_MATCHES,
+    /* check_version calls that had to evaluate version ranges */
+    STATS_RANGE_CHECKS,
+    /* check_version calls matched by a range term */
+    STATS_RANGE_MATCHES,
+    STATS_COUNTER_COUNT,
+} StatsCounter;
+
+/* Latency bucket i counts calls that took less than 2^i nanoseconds
+ * (the last bucket counts all slower calls)
+ */
+#define STATS_LATENCY_BUCKETS 32
+
+typedef struct stats_entry_data_t {
+    unsigned long long calls;
+    unsigned long long total_ns;
+    unsigned long long latency[STATS_LATENCY_BUCKETS];
+} StatsEntryData;
+
+typedef struct semver_stats_t {
+    StatsEntryData entries[STATS_ENTRY_COUNT];
+    unsigned long long counters[STATS_COUNTER_COUNT];
+} SemverStats;
+
+enum {
+    STATS_FORMAT_TEXT,
+    STATS_FORMAT_JSON,
+};
+
+/* Returns 1 if the library is built with statistics */
+int semver_stats_enabled();
+
+/* Fills stats with the sum of all threads statistics since the last reset */
+void get_semver_stats(SemverStats* stats);
+
+/* Starts collecting statistics from zero in all threads */
+void reset_semver_stats();
+
+/* Names used in dumps, NULL for invalid values */
+const char* stats_entry_name(int entry);
+const char* stats_counter_name(int counter);
+
+/* Writes stats to buf as text or JSON. The output is truncated to size
+ * bytes (including the terminating NUL).
+ *
+ * Returns the length of the whole output like snprintf does, or -1 if
+ * stats is NULL or format is unknown
+ */
+int format_semver_stats(const SemverStats* stats, int format, char* buf, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
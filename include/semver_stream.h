@@ -0,0 +1,87 @@
+﻿#ifndef SEMVER_STREAM_20261019
+#define SEMVER_STREAM_20261019
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Resumable version parser for chunked input.
+ *
+ * Versions come in a stream separated with new lines, tabs, or commas.
+ * The stream can be split into chunks at any byte, even in the middle of
+ * a version: the parser keeps its state between chunks, every byte is
+ * looked at only once, and no memory is allocated. Every version is
+ * parsed exactly like parse_version parses it.
+ *
+ * Empty items and items that contain only spaces are skipped.
+ */
+
+typedef struct version_stream_item_t {
+    /* parsed version, it is complete only if result is SEMVER_OK */
+    SemVersion version;
+    /* the same code as parse_version returns for the item */
+    int result;
+    /* stream offset of the first byte of the item */
+    unsigned long long offset;
+    /* number of bytes in the item */
+    unsigned long long length;
+    /* stream offset of the byte where parsing failed. For items that end
+     * unexpectedly it is the offset of the delimiter (or of the stream end)
+     */
+    unsigned long long error_offset;
+} VersionStreamItem;
+
+/* Called for every item of the stream. item is valid only during the call.
+ * Return SEMVER_OK to continue parsing, any other value stops parsing and
+ * it is returned by feed_version_stream or finish_version_stream
+ */
+typedef int (*VersionStreamCallback)(const VersionStreamItem* item, void* data);
+
+typedef struct version_stream_t {
+    VersionStreamItem item;
+    /* total number of consumed bytes */
+    unsigned long long offset;
+    int state;
+    /* number of version part (major, minor, patch) being read */
+    int part;
+    /* the value of the number being read */
+    unsigned long long number;
+    int overflow;
+    int pre_len;
+    int build_len;
+    /* 1 if the item has anything except spaces */
+    int not_blank;
+} VersionStream;
+
+/* Resets stream state: it must be called before the first chunk */
+void init_version_stream(VersionStream* stream);
+
+/* Parses the next chunk of the stream and calls callback for every
+ * item that ends in the chunk. The last item of the chunk is not
+ * reported until the next delimiter or the end of the stream.
+ *
+ * If callback stops parsing, the rest of the chunk after the delimiter of
+ * the reported item is not consumed: stream->offset points to the first
+ * unprocessed byte, and parsing can be resumed by feeding the rest of the chunk.
+ *
+ * Returns SEMVER_OK, SEMVER_INVALID_VERSION if stream or callback is NULL
+ * or chunk is NULL and len is not 0, or the value returned by callback
+ */
+int feed_version_stream(VersionStream* stream, const char* chunk, size_t len,
+        VersionStreamCallback callback, void* data);
+
+/* Finishes the stream: reports the last item if the stream does not end
+ * with a delimiter. After that the stream can get new data, offsets
+ * continue from the current position.
+ *
+ * Returns SEMVER_OK, SEMVER_INVALID_VERSION, or the value returned by callback
+ */
+int finish_version_stream(VersionStream* stream, VersionStreamCallback callback, void* data);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -9,8 +9,10 @@
 extern "C" {
 #endif
 
+#ifndef __cplusplus
 struct VersionRange;
 struct SemVersion;
+#endif
 
 /* Pretty print for VersionRange */
 void print_range(VersionRange* range);
@@ -0,0 +1,58 @@
+﻿#ifndef SEMVER_VALIDATE_20261019
+#define SEMVER_VALIDATE_20261019
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Fast version validation without parsing.
+ *
+ * The validator is a state machine driven by two precomputed tables: the
+ * first one maps every byte to its class, the second one maps a state and
+ * a byte class to the next state. So every byte costs one lookup in each
+ * table. The grammar and the error codes are the same as parse_version has.
+ */
+
+/* Validates a version string. Returns the same code as parse_version(str, NULL).
+ * If the string is invalid and error_offset is not NULL, it gets the offset
+ * of the byte where validation failed (it is the string length if the
+ * string ends unexpectedly)
+ */
+int validate_version(const char* str, size_t* error_offset);
+
+/* The same as validate_version but the string is not required to be
+ * NUL-terminated: it is validated up to len bytes. A NUL byte inside is
+ * invalid
+ */
+int validate_version_len(const char* str, size_t len, size_t* error_offset);
+
+typedef struct version_validation_t {
+    /* buffer offset of the first byte of the item */
+    size_t offset;
+    /* number of bytes in the item, without the delimiter */
+    size_t length;
+    /* the same code as parse_version returns for the item */
+    int result;
+    /* buffer offset of the byte where validation failed */
+    size_t error_offset;
+} VersionValidation;
+
+/* Validates all items of the buffer separated with the delimiter. Empty
+ * items are invalid, except the one after the delimiter at the end of the
+ * buffer: it is not an item.
+ *
+ * Results for the first max_results items are stored to results (it can be
+ * NULL if max_results is 0).
+ *
+ * Returns the number of items in the buffer, it can be greater than max_results
+ */
+size_t validate_version_buffer(const char* buf, size_t len, char delimiter,
+        VersionValidation* results, size_t max_results);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
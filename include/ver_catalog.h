@@ -0,0 +1,161 @@
+﻿#ifndef VER_CATALOG_20261019
+#define VER_CATALOG_20261019
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef __cplusplus
+struct SemVersion;
+#endif
+
+/*
+ * On-disk catalog of package versions.
+ *
+ * A catalog is written once by a builder and then opened read-only
+ * with mmap, so all lookups work directly on the mapped pages and many
+ * processes share the same physical memory. File layout (all integers
+ * are 32-bit in the host byte order, every section is 4-byte aligned):
+ *
+ *   header        - magic, format version, section offsets and sizes
+ *   directory     - open addressing hash table: package name hash ->
+ *                   package index + 1 (0 - empty bucket)
+ *   package table - name, first version index and version count
+ *   version table - packed versions of all packages. Versions of a
+ *                   package are stored in a row sorted with compare_versions
+ *   string pool   - NUL-terminated package names, prerelease and build strings
+ */
+
+#define CATALOG_MAGIC 0x54435653
+#define CATALOG_FORMAT_VERSION 1
+
+typedef struct catalog_header_t {
+    unsigned int magic;
+    unsigned int format_version;
+    unsigned int file_size;
+    unsigned int package_count;
+    unsigned int version_count;
+    unsigned int bucket_count;
+    unsigned int directory_offset;
+    unsigned int packages_offset;
+    unsigned int versions_offset;
+    unsigned int strings_offset;
+    unsigned int strings_size;
+    unsigned int reserved;
+} CatalogHeader;
+
+typedef struct catalog_package_t {
+    unsigned int name_offset;
+    unsigned int name_hash;
+    unsigned int first_version;
+    unsigned int version_count;
+} CatalogPackage;
+
+typedef struct catalog_version_t {
+    unsigned int major;
+    unsigned int minor;
+    unsigned int patch;
+    /* Prerelease value */
+    unsigned char prerelease;
+    unsigned char reserved[3];
+    /* offsets in string pool, 0 - empty string */
+    unsigned int prerelease_offset;
+    unsigned int build_offset;
+} CatalogVersion;
+
+typedef struct catalog_builder_t CatalogBuilder;
+
+typedef struct version_catalog_t {
+    const unsigned char *data;
+    unsigned int size;
+    const CatalogHeader *header;
+    const unsigned int *directory;
+    const CatalogPackage *packages;
+    const CatalogVersion *versions;
+    const char *strings;
+    /* 1 - data is mapped, 0 - data is read into memory */
+    int mapped;
+} VersionCatalog;
+
+/* Creates an empty catalog builder.
+ * Returns NULL if there is not enough memory.
+ */
+CatalogBuilder* init_catalog_builder();
+
+/* Frees the builder and sets the pointer to NULL */
+void free_catalog_builder(CatalogBuilder** builder);
+
+/* Adds a version of the package to the builder. The version's compare
+ * operator is ignored. Versions can be added in any order, duplicates
+ * (with the same build part) are stored only once.
+ *
+ * Returns:
+ * SEMVER_OK - the version is added
+ * SEMVER_INVALID_VERSION - builder, package, or version is NULL
+ * SEMVER_OUT_OF_MEMORY - failed to grow the builder storage
+ */
+int catalog_builder_add(CatalogBuilder* builder, const char* package, const SemVersion* version);
+
+/* Sorts everything added to the builder and writes the catalog file.
+ *
+ * Returns SEMVER_OK, SEMVER_INVALID_VERSION if builder or path is NULL,
+ * SEMVER_OUT_OF_MEMORY, or SEMVER_IO_ERROR if the file cannot be written
+ */
+int catalog_builder_write(CatalogBuilder* builder, const char* path);
+
+/* Opens catalog file and maps it into memory. The catalog must be closed
+ * with close_version_catalog.
+ *
+ * Returns:
+ * SEMVER_OK - the catalog is opened
+ * SEMVER_IO_ERROR - failed to open or map the file
+ * SEMVER_INVALID_CATALOG - the file is not a catalog or it is corrupted
+ * SEMVER_OUT_OF_MEMORY - out of memory
+ */
+int open_version_catalog(const char* path, VersionCatalog** catalog);
+
+/* Unmaps the catalog and sets the pointer to NULL */
+void close_version_catalog(VersionCatalog** catalog);
+
+/* Returns package index or -1 if the catalog does not have the package */
+int catalog_find_package(const VersionCatalog* catalog, const char* package);
+
+/* Returns the name of the package with index pkg or NULL */
+const char* catalog_package_name(const VersionCatalog* catalog, int pkg);
+
+/* Returns the number of versions of the package with index pkg.
+ * Returns 0 if pkg is invalid.
+ */
+int catalog_version_count(const VersionCatalog* catalog, int pkg);
+
+/* Unpacks the version with index idx of the package pkg into version.
+ * Versions of a package are sorted, so idx 0 is the lowest version.
+ * Compare operator of the result is COMPARE_NONE.
+ *
+ * Returns SEMVER_OK or SEMVER_OUT_OF_RANGE if pkg or idx is invalid
+ */
+int catalog_get_version(const VersionCatalog* catalog, int pkg, int idx, SemVersion* version);
+
+/* Returns index of the first version of the package that is not less than
+ * version, or catalog_version_count if all versions are less.
+ * Returns -1 if pkg is invalid or version is NULL.
+ */
+int catalog_lower_bound(const VersionCatalog* catalog, int pkg, const SemVersion* version);
+
+/* Returns 1 if the package has the version (build part is not compared), and 0 otherwise */
+int catalog_contains(const VersionCatalog* catalog, int pkg, const SemVersion* version);
+
+/* Looks for the highest version of the package that meets the requirements
+ * set with version_list (see check_version). version can be NULL if only
+ * index of the version is required.
+ *
+ * Returns index of the found version, or -1 if no version fits the list,
+ * the list is invalid, or pkg is invalid.
+ */
+int catalog_max_satisfying(const VersionCatalog* catalog, int pkg, const char* version_list,
+        SemVersion* version);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,98 @@
+﻿#ifndef VER_COLUMN_20261019
+#define VER_COLUMN_20261019
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Columnar version container.
+ *
+ * Versions are kept as a structure of arrays: major, minor, and patch
+ * columns, a prerelease rank column (the Prerelease value: the order of
+ * ranks is the order compare_versions uses for prerelease kinds), and a
+ * column of interned string ids. Every distinct pair of prerelease and
+ * build strings is stored once, id 0 means both strings are empty.
+ *
+ * Filter, count, and argmax kernels process 4 rows at a time with SSE2
+ * if it is available (there is a scalar fallback). They look only at
+ * numeric columns, strings are compared only for rows that have the same
+ * major, minor, and patch as the bound, so the results are exactly the
+ * same as compare_versions and version_equals give.
+ *
+ * Compare operators are not stored: versions read from a column have
+ * COMPARE_NONE.
+ */
+
+#ifndef __cplusplus
+struct SemVersion;
+#endif
+
+typedef struct version_column_t {
+    unsigned int* major;
+    unsigned int* minor;
+    unsigned int* patch;
+    unsigned char* prerelease;
+    unsigned int* str_id;
+    int count;
+    int capacity;
+
+    /* interned strings: prerelease and build of every id */
+    char (*strings)[MAX_PRERELEASE_LEN + MAX_BUILD_LEN];
+    int string_count;
+    int string_capacity;
+    /* hash table of string ids (id + 1, 0 - empty slot) */
+    int* string_table;
+    int table_size;
+} VersionColumn;
+
+VersionColumn* init_version_column();
+void free_version_column(VersionColumn** column);
+
+/* Adds a version to the end of the column. Returns SEMVER_OK,
+ * SEMVER_INVALID_VERSION, or SEMVER_OUT_OF_MEMORY
+ */
+int version_column_append(VersionColumn* column, const SemVersion* version);
+
+/* Reads (gathers) the version of a row. Returns SEMVER_OK or
+ * SEMVER_INVALID_VERSION if column or version is NULL or idx is out of range
+ */
+int version_column_get(const VersionColumn* column, int idx, SemVersion* version);
+/* Replaces (scatters) the version of a row. Returns the same codes as
+ * version_column_append
+ */
+int version_column_set(VersionColumn* column, int idx, const SemVersion* version);
+
+/* Reads rows with the given indices to versions[0..count-1] */
+int version_column_gather(const VersionColumn* column, const int* indices, int count, SemVersion* versions);
+/* Writes versions[0..count-1] to rows with the given indices */
+int version_column_scatter(VersionColumn* column, const int* indices, int count, const SemVersion* versions);
+
+/* Finds rows in [begin, end) that fit a range: lower must have
+ * COMPARE_GREATER or COMPARE_GREATEROREQUAL operator, upper - COMPARE_LESS
+ * or COMPARE_LESSOREQUAL. NULL bound means the range is not limited from
+ * that side. A row fits if version_equals(row, lower) and
+ * version_equals(row, upper) are both true.
+ *
+ * Indices of fitting rows are written to indices (it must have room for
+ * end - begin values) in increasing order.
+ *
+ * Returns the number of fitting rows or -1 if arguments are invalid
+ */
+int version_column_filter(const VersionColumn* column, int begin, int end,
+        const SemVersion* lower, const SemVersion* upper, int* indices);
+/* The same as version_column_filter but only counts fitting rows */
+int version_column_count(const VersionColumn* column, int begin, int end,
+        const SemVersion* lower, const SemVersion* upper);
+
+/* Returns the index of the greatest version in [begin, end) in
+ * compare_versions order (the first one if there are equal versions),
+ * or -1 if there are no rows. If stable_only is not 0, only versions
+ * without prerelease are considered
+ */
+int version_column_argmax(const VersionColumn* column, int begin, int end, int stable_only);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
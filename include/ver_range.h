@@ -5,7 +5,9 @@
 extern "C" {
 #endif
 
+#ifndef __cplusplus
 struct SemVersion;
+#endif
 
 /*
  * A simple internal structure to keep version ranges.
@@ -5,6 +5,9 @@
 
 #include "semver.h"
 #include "ver_range.h"
+#include "semver_stats_hooks.h"
+#include "semver_probes.h"
+#include "semver_parse.h"
 
 static int is_valid_char(char c) {
     return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >='A' && c <= 'Z') || c == '.';
@@ -70,16 +73,7 @@ static VersionCompare read_compare_method(const char **str) {
         return COMPARE_NONE;
 }
 
-int parse_version(const char *str, SemVersion* version) {
-    if (str == NULL) {
-        return SEMVER_INVALID_VERSION;
-    }
-
-    if (version != NULL) {
-        memset(version, 0, sizeof(SemVersion));
-        version->prerelease = PRERELEASE_NONE;
-    }
-
+const char* parse_version_numbers(const char* str, SemVersion* version, int* res) {
     /* skip all whitespaces and 'v' */
     while (*str == ' ' || *str == 'v' || *str == 'V') {
         str++;
@@ -89,7 +83,8 @@ int parse_version(const char *str, SemVersion* version) {
     if (! isdigit(*str)) {
         VersionCompare cmp = read_compare_method(&str);
         if (cmp == COMPARE_NONE) {
-            return SEMVER_INVALID_MAJOR;
+            *res = SEMVER_INVALID_MAJOR;
+            return str;
         }
         if (version != NULL) {
             version->cmp = cmp;
@@ -102,18 +97,21 @@ int parse_version(const char *str, SemVersion* version) {
     for (int i=0; i<PART_COUNT; i++) {
         str = read_number(str, &parts[i]);
         if (parts[i] == INVALID_NUMBER) {
-            return err[i];
+            *res = err[i];
+            return str;
         }
         if (i != PART_COUNT-1) {
            if (*str != '.') {
-              return err[i];
+              *res = err[i];
+              return str;
            }
            str++;
         }
     }
 
     if (*str != '\0' && *str != '+' && *str != '-') {
-        return SEMVER_INVALID_PATCH;
+        *res = SEMVER_INVALID_PATCH;
+        return str;
     }
 
     if (version != NULL) {
@@ -122,6 +120,11 @@ int parse_version(const char *str, SemVersion* version) {
         version->patch = parts[2];
     }
 
+    *res = SEMVER_OK;
+    return str;
+}
+
+int parse_version_tail(const char* str, SemVersion* version) {
     /* read prerelease */
     if (*str == '-') {
         str++;
@@ -172,6 +175,25 @@ int parse_version(const char *str, SemVersion* version) {
     return (*str == '\0') ? SEMVER_OK : SEMVER_INVALID_BUILD;
 }
 
+static int parse_version_impl(const char *str, SemVersion* version) {
+    if (str == NULL) {
+        return SEMVER_INVALID_VERSION;
+    }
+
+    if (version != NULL) {
+        memset(version, 0, sizeof(SemVersion));
+        version->prerelease = PRERELEASE_NONE;
+    }
+
+    int res;
+    str = parse_version_numbers(str, version, &res);
+    if (res != SEMVER_OK) {
+        return res;
+    }
+
+    return parse_version_tail(str, version);
+}
+
 static const char* skip_to_first_char(const char* str, char c) {
     if (str == NULL) {
         return str;
@@ -222,11 +244,12 @@ static int compare_prerelease(const SemVersion* ver_a, const SemVersion* ver_b)
         return 0;
     }
 
-    const char *pre_a = ver_a->prerelease_str;
-    const char *pre_b = ver_b->prerelease_str;
+    return compare_prerelease_str(ver_a->prerelease, ver_a->prerelease_str, ver_b->prerelease_str);
+}
 
+int compare_prerelease_str(Prerelease type, const char* pre_a, const char* pre_b) {
     /* skip beta, alpha, rc */
-    if (ver_a->prerelease != PRERELEASE_BASIC) {
+    if (type != PRERELEASE_BASIC) {
         pre_a = skip_to_first_char(pre_a, '.');
         pre_b = skip_to_first_char(pre_b, '.');
     }
@@ -281,7 +304,7 @@ static int compare_prerelease(const SemVersion* ver_a, const SemVersion* ver_b)
     return 0;
 }
 
-int compare_versions(const SemVersion* ver_a, const SemVersion* ver_b) {
+static int compare_versions_impl(const SemVersion* ver_a, const SemVersion* ver_b) {
     if (ver_a == NULL && ver_b == NULL) {
         return 0;
     } else if (ver_a == NULL) {
@@ -311,7 +334,7 @@ int compare_versions(const SemVersion* ver_a, const SemVersion* ver_b) {
     return compare_prerelease(ver_a, ver_b);
 }
 
-int version_equals(const SemVersion* ver_a, const SemVersion* ver_b) {
+static int version_equals_impl(const SemVersion* ver_a, const SemVersion* ver_b) {
     if (ver_a == NULL && ver_b == NULL) {
         return 1;
     } else if (ver_a == NULL) {
@@ -366,3 +389,29 @@ int version_equals(const SemVersion* ver_a, const SemVersion* ver_b) {
     return 0;
 }
 
+DEFINE_PROBE(parse_version_entry);
+DEFINE_PROBE(parse_version_return);
+DEFINE_PROBE(compare_versions_entry);
+DEFINE_PROBE(compare_versions_return);
+
+int parse_version(const char *str, SemVersion* version) {
+    int res;
+    FIRE_PROBE2(parse_version_entry, str, PROBE_STRLEN(str));
+    STATS_TIMED(STATS_PARSE_VERSION, res, parse_version_impl(str, version));
+    FIRE_PROBE2(parse_version_return, PROBE_STRLEN(str), res);
+    return res;
+}
+
+int compare_versions(const SemVersion* ver_a, const SemVersion* ver_b) {
+    int res;
+    FIRE_PROBE2(compare_versions_entry, ver_a, ver_b);
+    STATS_TIMED(STATS_COMPARE_VERSIONS, res, compare_versions_impl(ver_a, ver_b));
+    FIRE_PROBE1(compare_versions_return, res);
+    return res;
+}
+
+int version_equals(const SemVersion* ver_a, const SemVersion* ver_b) {
+    int res;
+    STATS_TIMED(STATS_VERSION_EQUALS, res, version_equals_impl(ver_a, ver_b));
+    return res;
+}
@@ -0,0 +1,249 @@
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "semver.h"
+#include "semver_check.h"
+#include "semver_intern.h"
+#include "semver_adaptive.h"
+
+/* Thread-local counters are kept in a set-associative table: a constraint
+ * goes to the set of its id and takes the least recently used way of it
+ */
+#define LOCAL_SETS 16
+#define LOCAL_WAYS 4
+#define INITIAL_TERMS 8
+
+struct adaptive_constraint_t {
+    /* unique for the process, so thread-local counters of a freed
+     * constraint are never taken for counters of a new one
+     */
+    unsigned long long id;
+    ConstraintTerm* terms;
+    int term_count;
+    /* term index at position i is in bits 4*i..4*i+3 */
+    atomic_ullong order;
+};
+
+typedef struct local_hits_t {
+    unsigned long long id;
+    /* local_clock at the last check */
+    unsigned long long used;
+    unsigned int checks;
+    unsigned int hits[ADAPTIVE_MAX_TERMS];
+} LocalHits;
+
+static atomic_ullong next_id = 1;
+static _Thread_local LocalHits local_hits[LOCAL_SETS][LOCAL_WAYS];
+static _Thread_local unsigned long long local_clock;
+
+static int term_at(unsigned long long order, int pos) {
+    return (int)((order >> (4 * pos)) & 0xF);
+}
+
+/* Counters of the constraint. A constraint that is not in the table
+ * replaces the least recently used one of its set, and its counting
+ * starts over
+ */
+static LocalHits* find_local_hits(unsigned long long id) {
+    LocalHits* set = local_hits[id % LOCAL_SETS];
+    LocalHits* lru = &set[0];
+    local_clock++;
+    for (int i = 0; i < LOCAL_WAYS; i++) {
+        if (set[i].id == id) {
+            set[i].used = local_clock;
+            return &set[i];
+        }
+        if (set[i].used < lru->used) {
+            lru = &set[i];
+        }
+    }
+
+    memset(lru, 0, sizeof(LocalHits));
+    lru->id = id;
+    lru->used = local_clock;
+    return lru;
+}
+
+static int fits_term(const ConstraintTerm* term, const SemVersion* ver) {
+    for (int i = 0; i < term->count; i++) {
+        if (! version_equals(ver, &term->items[i])) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* Orders terms by hits per item, terms without hits by the number of
+ * items. Equal terms keep their current order
+ */
+static unsigned long long new_order(const AdaptiveConstraint* c, unsigned long long order, const unsigned int* hits) {
+    int idx[ADAPTIVE_MAX_TERMS];
+    unsigned long long score[ADAPTIVE_MAX_TERMS];
+    for (int pos = 0; pos < c->term_count; pos++) {
+        idx[pos] = term_at(order, pos);
+        int items = c->terms[idx[pos]].count > 0 ? c->terms[idx[pos]].count : 1;
+        /* hits per item scaled; a term without hits gets less than any
+         * term with one hit
+         */
+        score[pos] = ((unsigned long long)hits[idx[pos]] * 2 + 1) * 2 / items;
+    }
+
+    /* insertion sort: stable and there are at most 16 terms */
+    for (int i = 1; i < c->term_count; i++) {
+        int t = idx[i];
+        unsigned long long s = score[i];
+        int j = i - 1;
+        for (; j >= 0 && score[j] < s; j--) {
+            idx[j + 1] = idx[j];
+            score[j + 1] = score[j];
+        }
+        idx[j + 1] = t;
+        score[j + 1] = s;
+    }
+
+    unsigned long long res = 0;
+    for (int pos = 0; pos < c->term_count; pos++) {
+        res |= (unsigned long long)idx[pos] << (4 * pos);
+    }
+    return res;
+}
+
+AdaptiveConstraint* create_adaptive_constraint(const ConstraintTerm* terms, int count) {
+    if (count < 0 || (terms == NULL && count > 0)) {
+        return NULL;
+    }
+
+    AdaptiveConstraint* c = calloc(1, sizeof(AdaptiveConstraint));
+    if (c == NULL) {
+        return NULL;
+    }
+    if (count > 0) {
+        c->terms = malloc(count * sizeof(ConstraintTerm));
+        if (c->terms == NULL) {
+            free(c);
+            return NULL;
+        }
+        memcpy(c->terms, terms, count * sizeof(ConstraintTerm));
+    }
+    c->term_count = count;
+    c->id = atomic_fetch_add(&next_id, 1);
+
+    unsigned long long order = 0;
+    for (int i = 0; i < count && i < ADAPTIVE_MAX_TERMS; i++) {
+        order |= (unsigned long long)i << (4 * i);
+    }
+    atomic_init(&c->order, order);
+    return c;
+}
+
+typedef struct collected_terms_t {
+    ConstraintTerm* terms;
+    int count;
+    int capacity;
+} CollectedTerms;
+
+static int collect_term(const SemVersion* items, int count, void* data) {
+    CollectedTerms* list = data;
+    if (list->count == list->capacity) {
+        int capacity = list->capacity == 0 ? INITIAL_TERMS : list->capacity * 2;
+        ConstraintTerm* terms = realloc(list->terms, capacity * sizeof(ConstraintTerm));
+        if (terms == NULL) {
+            return SEMVER_OUT_OF_MEMORY;
+        }
+        list->terms = terms;
+        list->capacity = capacity;
+    }
+
+    ConstraintTerm* term = &list->terms[list->count++];
+    memset(term, 0, sizeof(ConstraintTerm));
+    term->count = count;
+    for (int i = 0; i < count; i++) {
+        term->items[i] = items[i];
+    }
+    return SEMVER_OK;
+}
+
+AdaptiveConstraint* compile_adaptive_constraint(const char* version_list, int* error) {
+    CollectedTerms list;
+    memset(&list, 0, sizeof(list));
+    int res = walk_version_list(version_list, collect_term, &list);
+
+    AdaptiveConstraint* c = NULL;
+    if (res == SEMVER_OK) {
+        c = create_adaptive_constraint(list.terms, list.count);
+        if (c == NULL) {
+            res = SEMVER_OUT_OF_MEMORY;
+        }
+    }
+    free(list.terms);
+
+    if (error != NULL) {
+        *error = res;
+    }
+    return c;
+}
+
+void free_adaptive_constraint(AdaptiveConstraint** constraint) {
+    if (constraint == NULL || *constraint == NULL) {
+        return;
+    }
+
+    free((*constraint)->terms);
+    free(*constraint);
+    *constraint = NULL;
+}
+
+int check_adaptive_constraint(AdaptiveConstraint* constraint, const SemVersion* ver) {
+    if (constraint == NULL || ver == NULL) {
+        return SEMVER_INVALID_VERSION;
+    }
+
+    if (constraint->term_count > ADAPTIVE_MAX_TERMS) {
+        for (int i = 0; i < constraint->term_count; i++) {
+            if (fits_term(&constraint->terms[i], ver)) {
+                return SEMVER_OK;
+            }
+        }
+        return SEMVER_OUT_OF_RANGE;
+    }
+
+    unsigned long long order = atomic_load_explicit(&constraint->order, memory_order_relaxed);
+    int matched = -1;
+    for (int pos = 0; pos < constraint->term_count && matched < 0; pos++) {
+        int t = term_at(order, pos);
+        if (fits_term(&constraint->terms[t], ver)) {
+            matched = t;
+        }
+    }
+
+    LocalHits* local = find_local_hits(constraint->id);
+    if (matched >= 0) {
+        local->hits[matched]++;
+    }
+    if (++local->checks >= ADAPTIVE_PERIOD) {
+        unsigned long long reordered = new_order(constraint, order, local->hits);
+        if (reordered != order) {
+            atomic_store_explicit(&constraint->order, reordered, memory_order_relaxed);
+        }
+        /* older hits count half in the next period */
+        local->checks = 0;
+        for (int i = 0; i < ADAPTIVE_MAX_TERMS; i++) {
+            local->hits[i] /= 2;
+        }
+    }
+
+    return matched >= 0 ? SEMVER_OK : SEMVER_OUT_OF_RANGE;
+}
+
+int adaptive_constraint_order(const AdaptiveConstraint* constraint, int* order, int max) {
+    if (constraint == NULL) {
+        return 0;
+    }
+
+    unsigned long long packed = atomic_load_explicit((atomic_ullong*)&constraint->order, memory_order_relaxed);
+    for (int pos = 0; pos < constraint->term_count && pos < max; pos++) {
+        order[pos] = constraint->term_count > ADAPTIVE_MAX_TERMS ? pos : term_at(packed, pos);
+    }
+    return constraint->term_count;
+}
@@ -0,0 +1,317 @@
+#include <string.h>
+#include <stdlib.h>
+
+#include "semver.h"
+#include "semver_check.h"
+#include "semver_blob.h"
+#include "semver_stats_hooks.h"
+
+/* item field offsets */
+#define ITEM_MAJOR 0
+#define ITEM_MINOR 4
+#define ITEM_PATCH 8
+#define ITEM_CMP 12
+#define ITEM_PRERELEASE 13
+#define ITEM_PRERELEASE_STR 16
+
+static unsigned int read_u32(const unsigned char* p) {
+    return (unsigned int)p[0] | ((unsigned int)p[1] << 8) | ((unsigned int)p[2] << 16) | ((unsigned int)p[3] << 24);
+}
+
+static void write_u32(unsigned char* p, unsigned int value) {
+    p[0] = (unsigned char)(value & 0xFF);
+    p[1] = (unsigned char)((value >> 8) & 0xFF);
+    p[2] = (unsigned char)((value >> 16) & 0xFF);
+    p[3] = (unsigned char)((value >> 24) & 0xFF);
+}
+
+static unsigned int read_u16(const unsigned char* p) {
+    return (unsigned int)p[0] | ((unsigned int)p[1] << 8);
+}
+
+static void write_u16(unsigned char* p, unsigned int value) {
+    p[0] = (unsigned char)(value & 0xFF);
+    p[1] = (unsigned char)((value >> 8) & 0xFF);
+}
+
+static unsigned int checksum(const unsigned char* data, size_t size) {
+    unsigned int hash = 2166136261u;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= data[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+typedef struct blob_terms_t {
+    SemVersion* items;
+    int item_count;
+    int item_capacity;
+    int* term_items;
+    int term_count;
+    int term_capacity;
+} BlobTerms;
+
+static int collect_term(const SemVersion* items, int count, void* data) {
+    BlobTerms* terms = data;
+
+    if (terms->term_count >= VERSION_BLOB_MAX_TERMS) {
+        return SEMVER_INVALID_VERSION_LIST;
+    }
+
+    if (terms->term_count == terms->term_capacity) {
+        int capacity = terms->term_capacity == 0 ? 16 : terms->term_capacity * 2;
+        int* term_items = realloc(terms->term_items, capacity * sizeof(int));
+        if (term_items == NULL) {
+            return SEMVER_OUT_OF_MEMORY;
+        }
+        terms->term_items = term_items;
+        terms->term_capacity = capacity;
+    }
+    if (terms->item_count + count > terms->item_capacity) {
+        int capacity = terms->item_capacity == 0 ? 16 : terms->item_capacity * 2;
+        while (capacity < terms->item_count + count) {
+            capacity *= 2;
+        }
+        SemVersion* items_new = realloc(terms->items, capacity * sizeof(SemVersion));
+        if (items_new == NULL) {
+            return SEMVER_OUT_OF_MEMORY;
+        }
+        terms->items = items_new;
+        terms->item_capacity = capacity;
+    }
+
+    for (int i = 0; i < count; i++) {
+        terms->items[terms->item_count++] = items[i];
+    }
+    terms->term_items[terms->term_count++] = count;
+
+    return SEMVER_OK;
+}
+
+static void write_item(unsigned char* p, const SemVersion* ver) {
+    memset(p, 0, VERSION_BLOB_ITEM_SIZE);
+    write_u32(p + ITEM_MAJOR, ver->major);
+    write_u32(p + ITEM_MINOR, ver->minor);
+    write_u32(p + ITEM_PATCH, ver->patch);
+    p[ITEM_CMP] = (unsigned char)ver->cmp;
+    p[ITEM_PRERELEASE] = (unsigned char)ver->prerelease;
+    for (int i = 0; i < MAX_PRERELEASE_LEN - 1 && ver->prerelease_str[i] != '\0'; i++) {
+        p[ITEM_PRERELEASE_STR + i] = (unsigned char)ver->prerelease_str[i];
+    }
+}
+
+static int compile_version_list_impl(const char* version_list, unsigned char* blob, size_t size, size_t* blob_size) {
+    BlobTerms terms;
+    memset(&terms, 0, sizeof(terms));
+
+    int res = walk_version_list(version_list, collect_term, &terms);
+    if (res != SEMVER_OK) {
+        free(terms.items);
+        free(terms.term_items);
+        return res;
+    }
+
+    size_t total = VERSION_BLOB_HEADER_SIZE + (size_t)terms.term_count * VERSION_BLOB_TERM_SIZE;
+    for (int i = 0; i < terms.term_count; i++) {
+        total += 4 + (size_t)terms.term_items[i] * VERSION_BLOB_ITEM_SIZE;
+    }
+
+    if (blob_size != NULL) {
+        *blob_size = total;
+    }
+    if (blob == NULL || size < total) {
+        free(terms.items);
+        free(terms.term_items);
+        return SEMVER_BUFFER_TOO_SMALL;
+    }
+
+    memset(blob, 0, total);
+    write_u32(blob, VERSION_BLOB_MAGIC);
+    write_u16(blob + 4, VERSION_BLOB_FORMAT);
+    write_u16(blob + 6, terms.term_count);
+    write_u32(blob + 8, (unsigned int)total);
+
+    size_t offset = VERSION_BLOB_HEADER_SIZE + (size_t)terms.term_count * VERSION_BLOB_TERM_SIZE;
+    int item = 0;
+    for (int i = 0; i < terms.term_count; i++) {
+        write_u32(blob + VERSION_BLOB_HEADER_SIZE + i * VERSION_BLOB_TERM_SIZE, (unsigned int)offset);
+        blob[offset] = (unsigned char)terms.term_items[i];
+        offset += 4;
+        for (int j = 0; j < terms.term_items[i]; j++) {
+            write_item(blob + offset, &terms.items[item++]);
+            offset += VERSION_BLOB_ITEM_SIZE;
+        }
+    }
+
+    write_u32(blob + 12, checksum(blob + VERSION_BLOB_HEADER_SIZE, total - VERSION_BLOB_HEADER_SIZE));
+
+    free(terms.items);
+    free(terms.term_items);
+    return SEMVER_OK;
+}
+
+int compile_version_list(const char* version_list, unsigned char* blob, size_t size, size_t* blob_size) {
+    int res;
+    STATS_TIMED(STATS_COMPILE_VERSION_LIST, res, compile_version_list_impl(version_list, blob, size, blob_size));
+    return res;
+}
+
+/* Checks the header and returns the number of terms or -1 if it is invalid */
+static int blob_term_count(const unsigned char* blob, size_t size) {
+    if (blob == NULL || size < VERSION_BLOB_HEADER_SIZE) {
+        return -1;
+    }
+    if (read_u32(blob) != VERSION_BLOB_MAGIC || read_u16(blob + 4) != VERSION_BLOB_FORMAT ||
+        read_u32(blob + 8) > size) {
+        return -1;
+    }
+
+    int count = (int)read_u16(blob + 6);
+    if (VERSION_BLOB_HEADER_SIZE + (size_t)count * VERSION_BLOB_TERM_SIZE > read_u32(blob + 8)) {
+        return -1;
+    }
+
+    return count;
+}
+
+/* Returns a pointer to the term with index idx or NULL if the term
+ * does not fit the blob. item_count is set to the number of term items
+ */
+static const unsigned char* blob_term(const unsigned char* blob, int idx, int* item_count) {
+    size_t size = read_u32(blob + 8);
+    size_t offset = read_u32(blob + VERSION_BLOB_HEADER_SIZE + idx * VERSION_BLOB_TERM_SIZE);
+    if (offset < VERSION_BLOB_HEADER_SIZE || offset + 4 > size) {
+        return NULL;
+    }
+
+    int count = blob[offset];
+    if (offset + 4 + (size_t)count * VERSION_BLOB_ITEM_SIZE > size) {
+        return NULL;
+    }
+
+    *item_count = count;
+    return blob + offset + 4;
+}
+
+int validate_version_blob(const unsigned char* blob, size_t size) {
+    int count = blob_term_count(blob, size);
+    if (count < 0 || read_u32(blob + 8) != size) {
+        return SEMVER_INVALID_BLOB;
+    }
+    if (read_u32(blob + 12) != checksum(blob + VERSION_BLOB_HEADER_SIZE, size - VERSION_BLOB_HEADER_SIZE)) {
+        return SEMVER_INVALID_BLOB;
+    }
+
+    size_t data_start = VERSION_BLOB_HEADER_SIZE + (size_t)count * VERSION_BLOB_TERM_SIZE;
+    for (int i = 0; i < count; i++) {
+        int items = 0;
+        const unsigned char* term = blob_term(blob, i, &items);
+        if (term == NULL || (size_t)(term - blob) < data_start + 4) {
+            return SEMVER_INVALID_BLOB;
+        }
+
+        for (int j = 0; j < items; j++) {
+            const unsigned char* item = term + j * VERSION_BLOB_ITEM_SIZE;
+            if (item[ITEM_CMP] > COMPARE_MINOR || item[ITEM_PRERELEASE] > PRERELEASE_NONE ||
+                item[ITEM_PRERELEASE_STR + MAX_PRERELEASE_LEN - 1] != 0) {
+                return SEMVER_INVALID_BLOB;
+            }
+        }
+    }
+
+    return SEMVER_OK;
+}
+
+static void unpack_item(const unsigned char* item, SemVersion* ver) {
+    memset(ver, 0, sizeof(SemVersion));
+    ver->major = read_u32(item + ITEM_MAJOR);
+    ver->minor = read_u32(item + ITEM_MINOR);
+    ver->patch = read_u32(item + ITEM_PATCH);
+    ver->cmp = item[ITEM_CMP];
+    ver->prerelease = item[ITEM_PRERELEASE];
+    memcpy(ver->prerelease_str, item + ITEM_PRERELEASE_STR, MAX_PRERELEASE_LEN - 1);
+}
+
+/* Compares ver with a blob item. The item is unpacked only if it has
+ * the same major, minor, and patch numbers and prerelease
+ */
+static int compare_item(const SemVersion* ver, const unsigned char* item) {
+    unsigned int num = read_u32(item + ITEM_MAJOR);
+    if (ver->major != num) {
+        return ver->major > num ? 1 : -1;
+    }
+    num = read_u32(item + ITEM_MINOR);
+    if (ver->minor != num) {
+        return ver->minor > num ? 1 : -1;
+    }
+    num = read_u32(item + ITEM_PATCH);
+    if (ver->patch != num) {
+        return ver->patch > num ? 1 : -1;
+    }
+    if (ver->prerelease == PRERELEASE_NONE && item[ITEM_PRERELEASE] == PRERELEASE_NONE) {
+        return 0;
+    }
+
+    SemVersion tmp;
+    unpack_item(item, &tmp);
+    return compare_versions(ver, &tmp);
+}
+
+static int item_matches(const SemVersion* ver, const unsigned char* item) {
+    switch (item[ITEM_CMP]) {
+        case COMPARE_NONE:
+        case COMPARE_EQUAL:
+            return compare_item(ver, item) == 0;
+        case COMPARE_NEQUAL:
+            return compare_item(ver, item) != 0;
+        case COMPARE_GREATER:
+            return compare_item(ver, item) > 0;
+        case COMPARE_GREATEROREQUAL:
+            return compare_item(ver, item) >= 0;
+        case COMPARE_LESS:
+            return compare_item(ver, item) < 0;
+        case COMPARE_LESSOREQUAL:
+            return compare_item(ver, item) <= 0;
+        default: {
+            SemVersion tmp;
+            unpack_item(item, &tmp);
+            return version_equals(ver, &tmp);
+        }
+    }
+}
+
+static int check_version_blob_impl(const SemVersion* ver, const unsigned char* blob, size_t size) {
+    if (ver == NULL) {
+        return SEMVER_INVALID_VERSION;
+    }
+
+    int count = blob_term_count(blob, size);
+    if (count < 0) {
+        return SEMVER_INVALID_BLOB;
+    }
+
+    for (int i = 0; i < count; i++) {
+        int items = 0;
+        const unsigned char* term = blob_term(blob, i, &items);
+        if (term == NULL) {
+            return SEMVER_INVALID_BLOB;
+        }
+
+        int j = 0;
+        while (j < items && item_matches(ver, term + j * VERSION_BLOB_ITEM_SIZE)) {
+            j++;
+        }
+        if (j == items) {
+            return SEMVER_OK;
+        }
+    }
+
+    return SEMVER_OUT_OF_RANGE;
+}
+
+int check_version_blob(const SemVersion* ver, const unsigned char* blob, size_t size) {
+    int res;
+    STATS_TIMED(STATS_CHECK_VERSION_BLOB, res, check_version_blob_impl(ver, blob, size));
+    return res;
+}
@@ -6,84 +6,465 @@
 #include "semver.h"
 #include "semver_check.h"
 #include "ver_range.h"
+#include "semver_sorted.h"
+#include "semver_stats_hooks.h"
+#include "semver_probes.h"
 
-int check_version(const SemVersion* ver, const char *version_list) {
-    if (version_list == NULL) {
-        return SEMVER_INVALID_VERSION_LIST;
+/* Marks the end of version list for read_list_item */
+#define LIST_END -1
+/* Returned by read_list_item if the item does not fit the buffer */
+#define ITEM_TOO_LONG -3
+
+/* Reads the next item of the version list into v and moves list
+ * pointer to the beginning of the next item. buf is a temporary buffer
+ * of buf_size bytes for the item.
+ *
+ * in_range keeps the state of a 'min - max' range between calls:
+ * 0 - the item is not a part of a range, 1 - the item is the lower
+ * limit of a range (its compare operator is set to COMPARE_GREATEROREQUAL),
+ * 2 - the item is the upper limit of a range (COMPARE_LESSOREQUAL).
+ *
+ * Returns SEMVER_OK, SEMVER_INVALID_VERSION_LIST, LIST_END if there
+ * are no more items, or ITEM_TOO_LONG if the item does not fit buf
+ */
+static int read_list_item(const char** list, char* buf, size_t buf_size, int* in_range, int* item_exists, SemVersion* v) {
+    const char* version_list = *list;
+
+    while (*version_list == ' ' || *version_list == ',' || *version_list == '-') {
+        version_list++;
     }
-    if (ver == NULL) {
-        return SEMVER_INVALID_VERSION;
+    if (*version_list == '\0') {
+        *list = version_list;
+        return LIST_END;
     }
 
-    while (*version_list != '\0' && *version_list == ' ') version_list++;
+    const char* comma = strchr(version_list, ',');
+    const char* dash = strstr(version_list, " - ");
+    int parse = SEMVER_OK;
 
-    if (*version_list == '*') {
-        return SEMVER_OK;
+    size_t len;
+    if (comma == NULL && dash == NULL) {
+        len = strlen(version_list);
+    } else {
+        len = (dash != NULL && (comma == NULL || comma > dash) ? dash : comma) - version_list;
+    }
+    if (len >= buf_size) {
+        return ITEM_TOO_LONG;
     }
 
-    char* tmp_version = calloc(strlen(version_list)+1, sizeof(char));
-    int in_range = 0;
-    int item_exists = 1;
-    int res = SEMVER_OUT_OF_RANGE;
-    VersionRange* range = NULL;
-    VersionRange* first_item = NULL;
+    if (comma == NULL && dash == NULL) {
+        strcpy(buf, version_list);
+        *item_exists = 0;
+        parse = parse_version(buf, v);
+        if (*in_range == 1) {
+            v->cmp = COMPARE_LESSOREQUAL;
+            *in_range = 2;
+        }
+    } else if ((comma == NULL && dash != NULL) ||
+               (dash != NULL && comma - version_list > dash - version_list)) {
+        if (*in_range) {
+            *list = version_list;
+            return SEMVER_INVALID_VERSION_LIST;
+        } else {
+            *in_range = 1;
+            strncpy(buf, version_list, dash - version_list);
+            buf[dash - version_list] = '\0';
+            version_list = dash + 3;
+            parse = parse_version(buf, v);
+            v->cmp = COMPARE_GREATEROREQUAL;
+        }
+    } else {
+        strncpy(buf, version_list, comma - version_list);
+        buf[comma - version_list] = '\0';
+        version_list = comma + 1;
+        parse = parse_version(buf, v);
+        if (*in_range == 1) {
+            v->cmp = COMPARE_LESSOREQUAL;
+            *in_range = 2;
+        }
+    }
 
-    while (item_exists) {
-        while (*version_list == ' ' || *version_list == ',' || *version_list == '-') {
-            version_list++;
+    *list = version_list;
+    return parse == SEMVER_OK ? SEMVER_OK : SEMVER_INVALID_VERSION_LIST;
+}
+
+/* Sets lower and upper limits of a ^ or ~ item: ^1.2.3 is >=1.2.3,<2.0.0
+ * and ~1.2.3 is >=1.2.3,<1.3.0 */
+static void set_prefix_range(const SemVersion* v, SemVersion* lower, SemVersion* upper) {
+    int compare = v->cmp;
+    *upper = *v;
+    *lower = *v;
+    lower->cmp = COMPARE_GREATEROREQUAL;
+    upper->prerelease = PRERELEASE_NONE;
+    upper->cmp = COMPARE_LESS;
+    upper->patch = 0;
+    if (compare == COMPARE_MAJOR) {
+        upper->minor = 0;
+        upper->major++;
+    } else {
+        upper->minor++;
+    }
+}
+
+/* Most comparators and '!=' items in one conjunction group */
+#define GROUP_ITEMS 16
+
+/* Comparators of a conjunction group reduced to one interval, an
+ * optional exact version, and the versions excluded with '!=' */
+typedef struct compound_group_t {
+    SemVersion lower;
+    SemVersion upper;
+    SemVersion equal;
+    SemVersion excluded[GROUP_ITEMS];
+    int has_lower;
+    int has_upper;
+    int has_equal;
+    int excluded_count;
+    int items;
+    int empty;
+} CompoundGroup;
+
+typedef struct interval_t {
+    SemVersion lower;
+    SemVersion upper;
+    int has_lower;
+    int has_upper;
+} Interval;
+
+static int is_operator_char(char c) {
+    return c == '<' || c == '>' || c == '=' || c == '!' || c == '^' || c == '~';
+}
+
+static int is_prefix_char(char c) {
+    return is_operator_char(c) || c == 'v' || c == 'V';
+}
+
+/* Returns 1 if the list uses npm-style syntax: '||' alternatives or
+ * comparators separated with spaces. The old grammar allows spaces only
+ * around ' - ', after compare operators and 'v', and inside numbers
+ * ('1. 2. 3'), so a space between the end of a version and the start of
+ * the next one is never valid there */
+static int is_compound_list(const char* list) {
+    const char* token = list;
+
+    for (const char* p = list; *p != '\0'; p++) {
+        if (p[0] == '|' && p[1] == '|') {
+            return 1;
+        }
+        if (*p == ',') {
+            token = p + 1;
+            continue;
+        }
+        if (*p != ' ') {
+            continue;
+        }
+
+        const char* next = p;
+        while (*next == ' ') next++;
+        if (p > token && isalnum((unsigned char)p[-1]) &&
+                (isdigit((unsigned char)*next) || is_prefix_char(*next))) {
+            const char* c = token;
+            while (c < p && is_prefix_char(*c)) c++;
+            if (c < p) {
+                return 1;
+            }
         }
-        if (*version_list == '\0') {
+        token = next;
+        p = next - 1;
+    }
+
+    return 0;
+}
+
+/* Keeps the tighter of the current lower (or upper) limit and v. Equal
+ * limits keep the exclusive one */
+static void tighten_limit(SemVersion* limit, int* has_limit, const SemVersion* v, int lower) {
+    if (*has_limit) {
+        int cmp = compare_versions(v, limit);
+        if ((lower && cmp < 0) || (! lower && cmp > 0)) {
+            return;
+        }
+        if (cmp == 0 && (v->cmp == COMPARE_GREATEROREQUAL || v->cmp == COMPARE_LESSOREQUAL)) {
+            return;
+        }
+    }
+    *limit = *v;
+    *has_limit = 1;
+}
+
+static int add_group_item(CompoundGroup* group, const SemVersion* v) {
+    SemVersion lower, upper;
+
+    group->items++;
+    switch (v->cmp) {
+        case COMPARE_NONE:
+        case COMPARE_EQUAL:
+            if (group->has_equal && compare_versions(&group->equal, v) != 0) {
+                group->empty = 1;
+            }
+            group->equal = *v;
+            group->equal.cmp = COMPARE_EQUAL;
+            group->has_equal = 1;
+            break;
+        case COMPARE_NEQUAL:
+            if (group->excluded_count == GROUP_ITEMS) {
+                return SEMVER_INVALID_VERSION_LIST;
+            }
+            group->excluded[group->excluded_count++] = *v;
+            break;
+        case COMPARE_MAJOR:
+        case COMPARE_MINOR:
+            set_prefix_range(v, &lower, &upper);
+            tighten_limit(&group->lower, &group->has_lower, &lower, 1);
+            tighten_limit(&group->upper, &group->has_upper, &upper, 0);
+            break;
+        case COMPARE_GREATER:
+        case COMPARE_GREATEROREQUAL:
+            tighten_limit(&group->lower, &group->has_lower, v, 1);
+            break;
+        default:
+            tighten_limit(&group->upper, &group->has_upper, v, 0);
             break;
+    }
+
+    return SEMVER_OK;
+}
+
+static int is_empty_interval(const Interval* in) {
+    if (! in->has_lower || ! in->has_upper) {
+        return 0;
+    }
+    int cmp = compare_versions(&in->lower, &in->upper);
+    return cmp > 0 || (cmp == 0 && (in->lower.cmp == COMPARE_GREATER || in->upper.cmp == COMPARE_LESS));
+}
+
+/* Reports a conjunction group as terms of the disjunctive normal form:
+ * an exact version becomes one single-version term, otherwise every
+ * '!=' item splits the interval into the parts below and above the
+ * excluded version. Empty parts are dropped */
+static int report_group(const CompoundGroup* group, VersionTermCallback callback, void* data) {
+    if (group->empty) {
+        return SEMVER_OK;
+    }
+    if (! group->has_lower && ! group->has_upper && ! group->has_equal && group->excluded_count == 0) {
+        STATS_COUNT(STATS_TERMS, 1);
+        return callback(NULL, 0, data);
+    }
+
+    if (group->has_equal) {
+        if ((group->has_lower && ! version_equals(&group->equal, &group->lower)) ||
+                (group->has_upper && ! version_equals(&group->equal, &group->upper))) {
+            return SEMVER_OK;
         }
+        for (int i = 0; i < group->excluded_count; i++) {
+            if (compare_versions(&group->equal, &group->excluded[i]) == 0) {
+                return SEMVER_OK;
+            }
+        }
+        STATS_COUNT(STATS_TERMS, 1);
+        return callback(&group->equal, 1, data);
+    }
 
-        char* comma = strchr(version_list, ',');
-        char* dash = strstr(version_list, " - ");
-        int parse = SEMVER_OK;
-        SemVersion v;
+    /* a point splits only the interval that contains it */
+    Interval parts[GROUP_ITEMS + 1];
+    int count = 1;
+    parts[0].lower = group->lower;
+    parts[0].upper = group->upper;
+    parts[0].has_lower = group->has_lower;
+    parts[0].has_upper = group->has_upper;
+    if (is_empty_interval(&parts[0])) {
+        return SEMVER_OK;
+    }
 
-        if (comma == NULL && dash == NULL) {
-            strcpy(tmp_version, version_list);
-            item_exists = 0;
-            parse = parse_version(tmp_version, &v);
-            if (in_range == 1) {
-                v.cmp = COMPARE_LESSOREQUAL;
-                in_range = 2;
+    for (int i = 0; i < group->excluded_count; i++) {
+        SemVersion below = group->excluded[i];
+        SemVersion above = group->excluded[i];
+        below.cmp = COMPARE_LESS;
+        above.cmp = COMPARE_GREATER;
+
+        int split = count;
+        for (int j = 0; j < split; j++) {
+            Interval high = parts[j];
+            tighten_limit(&parts[j].upper, &parts[j].has_upper, &below, 0);
+            tighten_limit(&high.lower, &high.has_lower, &above, 1);
+            if (is_empty_interval(&high)) {
+                continue;
             }
-        } else if ((comma == NULL && dash != NULL) ||
-                   (dash != NULL && comma - version_list > dash - version_list)) {
-            if (in_range) {
+            if (is_empty_interval(&parts[j])) {
+                parts[j] = high;
+            } else if (count == GROUP_ITEMS + 1) {
+                return SEMVER_INVALID_VERSION_LIST;
+            } else {
+                parts[count++] = high;
+            }
+        }
+
+        /* drop the parts that became empty */
+        int kept = 0;
+        for (int j = 0; j < count; j++) {
+            if (! is_empty_interval(&parts[j])) {
+                parts[kept++] = parts[j];
+            }
+        }
+        count = kept;
+    }
+
+    for (int i = 0; i < count; i++) {
+        SemVersion items[2];
+        int n = 0;
+        if (parts[i].has_lower) {
+            items[n++] = parts[i].lower;
+        }
+        if (parts[i].has_upper) {
+            items[n++] = parts[i].upper;
+        }
+        STATS_COUNT(STATS_TERMS, 1);
+        int ok = callback(items, n, data);
+        if (ok != SEMVER_OK) {
+            return ok;
+        }
+    }
+
+    return SEMVER_OK;
+}
+
+/* Reads the next comparator of a compound list into buf: an optional
+ * operator or 'v' prefix that may be followed by spaces, and a version.
+ * Returns the length of the comparator */
+static size_t read_comparator(const char** list, char* buf) {
+    const char* start = *list;
+    const char* end = start;
+
+    while (is_prefix_char(*end) || (*end == ' ' && end > start)) end++;
+    while (*end != '\0' && *end != ' ' && *end != ',' && *end != '|') end++;
+
+    size_t len = end - start;
+    memcpy(buf, start, len);
+    buf[len] = '\0';
+    *list = end;
+    return len;
+}
+
+/* Walks an npm-style list: alternatives separated with '||' (or with
+ * commas) are groups of comparators separated with spaces, and a version
+ * fits a group if it meets all its comparators. A group may be a
+ * 'min - max' range instead. Every group is reduced to intervals and
+ * reported as soon as it is read, so the walk stops at the first term
+ * the callback accepts */
+static int walk_compound_list(const char* version_list, VersionTermCallback callback, void* data) {
+    char* buf = malloc(strlen(version_list) + 1);
+    if (buf == NULL) {
+        return SEMVER_OUT_OF_MEMORY;
+    }
+    STATS_COUNT(STATS_ALLOCATIONS, 1);
+
+    CompoundGroup group;
+    memset(&group, 0, sizeof(group));
+    int res = SEMVER_OK;
+
+    while (res == SEMVER_OK) {
+        while (*version_list == ' ') version_list++;
+
+        int alternative = version_list[0] == '|' && version_list[1] == '|';
+        if (*version_list == '\0' || *version_list == ',' || alternative) {
+            if (group.items > 0) {
+                res = report_group(&group, callback, data);
+                memset(&group, 0, sizeof(group));
+            }
+            if (*version_list == '\0') {
+                break;
+            }
+            version_list += alternative ? 2 : 1;
+            continue;
+        }
+
+        SemVersion v;
+        read_comparator(&version_list, buf);
+        if (strcmp(buf, "*") == 0) {
+            group.items++;
+            continue;
+        }
+        if (parse_version(buf, &v) != SEMVER_OK) {
+            res = SEMVER_INVALID_VERSION_LIST;
+            break;
+        }
+
+        const char* next = version_list;
+        while (*next == ' ') next++;
+        if (next > version_list && next[0] == '-' && next[1] == ' ') {
+            /* 'min - max' range, both limits are inclusive */
+            SemVersion max;
+            version_list = next + 1;
+            while (*version_list == ' ') version_list++;
+            read_comparator(&version_list, buf);
+            if (parse_version(buf, &max) != SEMVER_OK) {
                 res = SEMVER_INVALID_VERSION_LIST;
                 break;
-            } else {
-                in_range = 1;
-                strncpy(tmp_version, version_list, dash - version_list);
-                tmp_version[dash - version_list] = '\0';
-                version_list = dash + 3;
-                parse = parse_version(tmp_version, &v);
-                v.cmp = COMPARE_GREATEROREQUAL;
             }
-        } else {
-            strncpy(tmp_version, version_list, comma - version_list);
-            tmp_version[comma - version_list] = '\0';
-            version_list = comma + 1;
-            parse = parse_version(tmp_version, &v);
-            if (in_range == 1) {
-                v.cmp = COMPARE_LESSOREQUAL;
-                in_range = 2;
+            v.cmp = COMPARE_GREATEROREQUAL;
+            max.cmp = COMPARE_LESSOREQUAL;
+            res = add_group_item(&group, &v);
+            if (res == SEMVER_OK) {
+                res = add_group_item(&group, &max);
             }
+        } else {
+            res = add_group_item(&group, &v);
         }
+    }
+
+    free(buf);
+    return res;
+}
+
+static int walk_version_list_impl(const char* version_list, VersionTermCallback callback, void* data) {
+    if (version_list == NULL || callback == NULL) {
+        return SEMVER_INVALID_VERSION_LIST;
+    }
+
+    STATS_COUNT(STATS_LISTS, 1);
+    while (*version_list != '\0' && *version_list == ' ') version_list++;
+
+    if (is_compound_list(version_list)) {
+        return walk_compound_list(version_list, callback, data);
+    }
+
+    if (*version_list == '*') {
+        STATS_COUNT(STATS_TERMS, 1);
+        return callback(NULL, 0, data);
+    }
+
+    size_t tmp_size = strlen(version_list) + 1;
+    char* tmp_version = calloc(tmp_size, sizeof(char));
+    if (tmp_version == NULL) {
+        return SEMVER_OUT_OF_MEMORY;
+    }
+    STATS_COUNT(STATS_ALLOCATIONS, 1);
+
+    int in_range = 0;
+    int item_exists = 1;
+    int res = SEMVER_OK;
+    int stopped = 0;
+    VersionRange* range = NULL;
+    VersionRange* first_item = NULL;
 
+    while (item_exists) {
+        SemVersion v;
+        int parse = read_list_item(&version_list, tmp_version, tmp_size, &in_range, &item_exists, &v);
+        if (parse == LIST_END) {
+            break;
+        }
         if (parse != SEMVER_OK) {
             res = SEMVER_INVALID_VERSION_LIST;
             break;
         }
 
         if (v.cmp == COMPARE_NEQUAL || v.cmp == COMPARE_NONE || v.cmp == COMPARE_EQUAL) {
-            if (version_equals(ver, &v)) {
-                res = SEMVER_OK;
+            STATS_COUNT(STATS_TERMS, 1);
+            int ok = callback(&v, 1, data);
+            if (ok != SEMVER_OK) {
+                res = ok;
+                stopped = 1;
                 break;
-            } else {
-                res = SEMVER_OUT_OF_RANGE;
             }
         } else if (v.cmp == COMPARE_MAJOR || v.cmp == COMPARE_MINOR) {
             if (range == NULL) {
@@ -95,26 +476,15 @@ int check_version(const SemVersion* ver, const char *version_list) {
                 break;
             }
 
-            int compare = v.cmp;
-            v.cmp = COMPARE_GREATEROREQUAL;
+            SemVersion upper;
+            set_prefix_range(&v, &v, &upper);
             first_item = add_version(range, &v, 1);
             if (first_item == NULL) {
                 res = SEMVER_OUT_OF_MEMORY;
                 break;
             }
 
-            v.prerelease = PRERELEASE_NONE;
-            v.cmp = COMPARE_LESS;
-            v.patch = 0;
-
-            if (compare == COMPARE_MAJOR) {
-                v.minor = 0;
-                v.major++;
-            } else {
-                v.minor++;
-            }
-
-            int ok = complete_version_range(first_item, &v);
+            int ok = complete_version_range(first_item, &upper);
             if (ok != SEMVER_OK) {
                 res = ok;
                 break;
@@ -152,26 +522,25 @@ int check_version(const SemVersion* ver, const char *version_list) {
         }
     }
 
-    if (res != SEMVER_OK && range_size(range) > 0) {
+    if (! stopped) {
         VersionRange* tmp = range;
-        res = SEMVER_OUT_OF_RANGE;
         while (tmp != NULL) {
-            int less = SEMVER_OK;
+            SemVersion items[2];
+            int count = 0;
             if (tmp->min_ver != NULL) {
-                if (! version_equals(ver, tmp->min_ver)) {
-                    less = SEMVER_OUT_OF_RANGE;
-                }
+                items[count++] = *tmp->min_ver;
             }
-            int greater = SEMVER_OK;
             if (tmp->max_ver != NULL) {
-                if (! version_equals(ver, tmp->max_ver)) {
-                    greater = SEMVER_OUT_OF_RANGE;
-                }
+                items[count++] = *tmp->max_ver;
             }
 
-            if (less == SEMVER_OK && greater == SEMVER_OK) {
-                res = SEMVER_OK;
-                break;
+            if (count > 0) {
+                STATS_COUNT(STATS_TERMS, 1);
+                int ok = callback(items, count, data);
+                if (ok != SEMVER_OK) {
+                    res = ok;
+                    break;
+                }
             }
 
             tmp = tmp->next;
@@ -184,3 +553,252 @@ int check_version(const SemVersion* ver, const char *version_list) {
     return res;
 }
 
+int walk_version_list(const char* version_list, VersionTermCallback callback, void* data) {
+    int res;
+    STATS_TIMED(STATS_WALK_VERSION_LIST, res, walk_version_list_impl(version_list, callback, data));
+    return res;
+}
+
+/* Returned by check_term to stop walking when the version fits a term */
+#define TERM_MATCHED -2
+
+typedef struct check_data_t {
+    const SemVersion* ver;
+    int terms;
+    int ranges;
+} CheckData;
+
+static int check_term(const SemVersion* items, int count, void* data) {
+    CheckData* check = data;
+
+    check->terms++;
+    int is_range = count > 1 || (count == 1 && items[0].cmp != COMPARE_NEQUAL &&
+            items[0].cmp != COMPARE_NONE && items[0].cmp != COMPARE_EQUAL);
+    if (is_range) {
+        check->ranges++;
+    }
+
+    for (int i = 0; i < count; i++) {
+        if (! version_equals(check->ver, &items[i])) {
+            return SEMVER_OK;
+        }
+    }
+
+    STATS_COUNT(is_range ? STATS_RANGE_MATCHES : STATS_SINGLE_MATCHES, 1);
+    return TERM_MATCHED;
+}
+
+/* Range limits that are not paired yet, kept by check_one_pass */
+#define OPEN_LIMIT_SLOTS 8
+/* Items of a version list that check_one_pass parses on the stack */
+#define ONE_PASS_ITEM_LEN 64
+/* Returned by check_one_pass when the list needs walk_version_list */
+#define ONE_PASS_FALLBACK -3
+
+static int is_lower_limit(const SemVersion* v) {
+    return v->cmp == COMPARE_GREATER || v->cmp == COMPARE_GREATEROREQUAL;
+}
+
+static int check_limits(CheckData* check, const SemVersion* items, int count) {
+    STATS_COUNT(STATS_TERMS, 1);
+    return check_term(items, count, check);
+}
+
+/* Checks the version against the list in one pass without building a
+ * VersionRange list: the terms are the same as walk_version_list reports.
+ * A range is checked as soon as both its limits are known. Limits that
+ * are not paired yet stay in open slots in the order of their range items,
+ * so a new limit is paired with the first open limit of the other side,
+ * the same way add_version fills the first half-full range item. Limits
+ * that stay open to the end of the list are checked as one-limit ranges.
+ *
+ * Returns TERM_MATCHED, SEMVER_OK if no term matches, an error, or
+ * ONE_PASS_FALLBACK if an item is too long or there are too many open
+ * limits
+ */
+static int check_one_pass(const char* version_list, CheckData* check) {
+    while (*version_list == ' ') version_list++;
+    if (*version_list == '*') {
+        STATS_COUNT(STATS_LISTS, 1);
+        return check_limits(check, NULL, 0);
+    }
+
+    char buf[ONE_PASS_ITEM_LEN];
+    SemVersion open[OPEN_LIMIT_SLOTS];
+    int open_count = 0;
+    int in_range = 0;
+    int item_exists = 1;
+    int res = SEMVER_OK;
+
+    while (item_exists && res == SEMVER_OK) {
+        SemVersion v;
+        int parse = read_list_item(&version_list, buf, sizeof(buf), &in_range, &item_exists, &v);
+        if (parse == LIST_END) {
+            break;
+        }
+        if (parse == ITEM_TOO_LONG) {
+            return ONE_PASS_FALLBACK;
+        }
+        if (parse != SEMVER_OK) {
+            res = SEMVER_INVALID_VERSION_LIST;
+            break;
+        }
+
+        if (v.cmp == COMPARE_NEQUAL || v.cmp == COMPARE_NONE || v.cmp == COMPARE_EQUAL) {
+            res = check_limits(check, &v, 1);
+        } else if (v.cmp == COMPARE_MAJOR || v.cmp == COMPARE_MINOR) {
+            SemVersion items[2];
+            set_prefix_range(&v, &items[0], &items[1]);
+            res = check_limits(check, items, 2);
+        } else if (in_range == 2) {
+            /* the lower limit is the last open one */
+            SemVersion items[2] = { open[--open_count], v };
+            res = check_limits(check, items, 2);
+            in_range = 0;
+        } else {
+            int idx = open_count;
+            if (in_range == 0) {
+                for (idx = 0; idx < open_count && is_lower_limit(&open[idx]) == is_lower_limit(&v); idx++);
+            }
+            if (idx < open_count) {
+                SemVersion items[2] = { open[idx], v };
+                memmove(&open[idx], &open[idx + 1], (open_count - idx - 1) * sizeof(SemVersion));
+                open_count--;
+                res = check_limits(check, items, 2);
+            } else if (open_count == OPEN_LIMIT_SLOTS) {
+                return ONE_PASS_FALLBACK;
+            } else {
+                open[open_count++] = v;
+            }
+        }
+    }
+
+    /* open limits are checked after an invalid item as well */
+    for (int i = 0; i < open_count && res != TERM_MATCHED; i++) {
+        if (check_limits(check, &open[i], 1) == TERM_MATCHED) {
+            res = TERM_MATCHED;
+        }
+    }
+
+    STATS_COUNT(STATS_LISTS, 1);
+    return res;
+}
+
+static int check_version_impl(const SemVersion* ver, const char *version_list, CheckData* check) {
+    if (version_list == NULL) {
+        return SEMVER_INVALID_VERSION_LIST;
+    }
+    if (ver == NULL) {
+        return SEMVER_INVALID_VERSION;
+    }
+
+    check->ver = ver;
+    int res = is_compound_list(version_list) ? ONE_PASS_FALLBACK : check_one_pass(version_list, check);
+    if (res == ONE_PASS_FALLBACK) {
+        check->terms = 0;
+        check->ranges = 0;
+        res = walk_version_list(version_list, check_term, check);
+    }
+    if (check->ranges > 0) {
+        STATS_COUNT(STATS_RANGE_CHECKS, 1);
+    }
+    if (res == TERM_MATCHED) {
+        return SEMVER_OK;
+    }
+
+    /* ranges collected before an invalid item are checked anyway */
+    if (res == SEMVER_OK || check->ranges > 0) {
+        return SEMVER_OUT_OF_RANGE;
+    }
+
+    return res;
+}
+
+DEFINE_PROBE(check_version_entry);
+DEFINE_PROBE(check_version_return);
+
+int check_version(const SemVersion* ver, const char *version_list) {
+    CheckData check;
+    check.terms = 0;
+    check.ranges = 0;
+
+    int res;
+    FIRE_PROBE2(check_version_entry, version_list, PROBE_STRLEN(version_list));
+    STATS_TIMED(STATS_CHECK_VERSION, res, check_version_impl(ver, version_list, &check));
+    FIRE_PROBE4(check_version_return, PROBE_STRLEN(version_list), res, check.terms, check.ranges);
+    return res;
+}
+
+int sorted_bound(const void* array, int count, SortedCompare compare, const SemVersion* version, int strict) {
+    int lo = 0;
+    int hi = count;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        int cmp = compare(array, mid, version);
+        if (cmp < 0 || (strict && cmp == 0)) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+typedef struct satisfying_t {
+    const void* array;
+    int count;
+    SortedCompare compare;
+    int best;
+} Satisfying;
+
+/* Finds the highest version of a term above the best one found so far */
+static int find_satisfying(const SemVersion* items, int count, void* data) {
+    Satisfying* sat = data;
+    int lo = sat->best + 1;
+    int hi = sat->count;
+
+    for (int i = 0; i < count && lo < hi; i++) {
+        const SemVersion* limit = &items[i];
+        int bound;
+        switch (limit->cmp) {
+            case COMPARE_LESS:
+            case COMPARE_LESSOREQUAL:
+                bound = sorted_bound(sat->array, sat->count, sat->compare, limit, limit->cmp == COMPARE_LESSOREQUAL);
+                hi = bound < hi ? bound : hi;
+                break;
+            case COMPARE_GREATER:
+            case COMPARE_GREATEROREQUAL:
+                bound = sorted_bound(sat->array, sat->count, sat->compare, limit, limit->cmp == COMPARE_GREATER);
+                lo = bound > lo ? bound : lo;
+                break;
+            case COMPARE_NEQUAL:
+                break;
+            default:
+                bound = sorted_bound(sat->array, sat->count, sat->compare, limit, 0);
+                lo = bound > lo ? bound : lo;
+                bound = sorted_bound(sat->array, sat->count, sat->compare, limit, 1);
+                hi = bound < hi ? bound : hi;
+                break;
+        }
+    }
+
+    for (int idx = hi - 1; idx >= lo; idx--) {
+        int fits = 1;
+        for (int i = 0; i < count && fits; i++) {
+            fits = items[i].cmp != COMPARE_NEQUAL || sat->compare(sat->array, idx, &items[i]) != 0;
+        }
+        if (fits) {
+            sat->best = idx;
+            break;
+        }
+    }
+    return SEMVER_OK;
+}
+
+int sorted_max_satisfying(const void* array, int count, SortedCompare compare, const char* version_list) {
+    Satisfying sat = { array, count, compare, -1 };
+    if (walk_version_list(version_list, find_satisfying, &sat) != SEMVER_OK) {
+        return -1;
+    }
+    return sat.best;
+}
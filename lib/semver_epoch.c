@@ -0,0 +1,134 @@
+#include <stdlib.h>
+
+#include "semver_epoch.h"
+
+void init_epoch_domain(EpochDomain* domain, void* current) {
+    atomic_init(&domain->current, current);
+    atomic_init(&domain->epoch, 1);
+    atomic_init(&domain->readers, NULL);
+    domain->retired = NULL;
+    domain->spare = NULL;
+}
+
+static void free_retired(EpochRetired** list, unsigned long long before) {
+    while (*list != NULL) {
+        EpochRetired* r = *list;
+        if (r->epoch < before) {
+            *list = r->next;
+            r->free_fn(r->ptr);
+            free(r);
+        } else {
+            list = &r->next;
+        }
+    }
+}
+
+void free_epoch_domain(EpochDomain* domain) {
+    free_retired(&domain->retired, ~0ull);
+    while (domain->spare != NULL) {
+        EpochRetired* next = domain->spare->next;
+        free(domain->spare);
+        domain->spare = next;
+    }
+
+    EpochReader* reader = atomic_load(&domain->readers);
+    while (reader != NULL) {
+        EpochReader* next = reader->next;
+        free(reader);
+        reader = next;
+    }
+    atomic_store(&domain->readers, NULL);
+}
+
+EpochReader* open_epoch_reader(EpochDomain* domain) {
+    for (EpochReader* r = atomic_load(&domain->readers); r != NULL; r = r->next) {
+        int expected = 0;
+        if (atomic_compare_exchange_strong(&r->in_use, &expected, 1)) {
+            return r;
+        }
+    }
+
+    EpochReader* reader = malloc(sizeof(EpochReader));
+    if (reader == NULL) {
+        return NULL;
+    }
+    reader->domain = domain;
+    atomic_init(&reader->epoch, 0);
+    atomic_init(&reader->in_use, 1);
+    reader->next = atomic_load(&domain->readers);
+    while (! atomic_compare_exchange_weak(&domain->readers, &reader->next, reader));
+    return reader;
+}
+
+void close_epoch_reader(EpochReader* reader) {
+    atomic_store(&reader->epoch, 0);
+    atomic_store(&reader->in_use, 0);
+}
+
+void* epoch_enter(EpochReader* reader) {
+    /* the epoch is published before the pointer is loaded: a writer that
+     * does not see it has published its pointer before the load */
+    EpochDomain* domain = reader->domain;
+    atomic_store(&reader->epoch, atomic_load(&domain->epoch));
+    return atomic_load(&domain->current);
+}
+
+void epoch_exit(EpochReader* reader) {
+    atomic_store_explicit(&reader->epoch, 0, memory_order_release);
+}
+
+void* epoch_current(EpochDomain* domain) {
+    return atomic_load_explicit(&domain->current, memory_order_relaxed);
+}
+
+void epoch_publish(EpochDomain* domain, void* current) {
+    atomic_store(&domain->current, current);
+}
+
+int epoch_reserve(EpochDomain* domain, int count) {
+    int spare = 0;
+    for (EpochRetired* r = domain->spare; r != NULL; r = r->next) {
+        spare++;
+    }
+    for (; spare < count; spare++) {
+        EpochRetired* r = malloc(sizeof(EpochRetired));
+        if (r == NULL) {
+            return 0;
+        }
+        r->next = domain->spare;
+        domain->spare = r;
+    }
+    return 1;
+}
+
+int epoch_retire(EpochDomain* domain, void* ptr, void (*free_fn)(void* ptr)) {
+    EpochRetired* r = domain->spare;
+    if (r != NULL) {
+        domain->spare = r->next;
+    } else {
+        r = malloc(sizeof(EpochRetired));
+    }
+    if (r == NULL) {
+        return 0;
+    }
+    r->ptr = ptr;
+    r->free_fn = free_fn;
+    r->epoch = atomic_load(&domain->epoch);
+    r->next = domain->retired;
+    domain->retired = r;
+    return 1;
+}
+
+void epoch_advance(EpochDomain* domain) {
+    atomic_fetch_add(&domain->epoch, 1);
+
+    /* readers that entered after data was retired load the new pointer */
+    unsigned long long oldest = ~0ull;
+    for (EpochReader* r = atomic_load(&domain->readers); r != NULL; r = r->next) {
+        unsigned long long epoch = atomic_load(&r->epoch);
+        if (epoch != 0 && epoch < oldest) {
+            oldest = epoch;
+        }
+    }
+    free_retired(&domain->retired, oldest);
+}
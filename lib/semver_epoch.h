@@ -0,0 +1,69 @@
+/* Epoch-based reclamation for the library sources.
+ *
+ * A domain publishes a pointer to immutable data (a snapshot) that
+ * readers use without locks. A reader publishes the global epoch when it
+ * enters and loads the pointer after that; a writer that replaces the
+ * pointer retires the old data, and the data is freed when every reader
+ * inside entered after it was retired. Writers must be serialized by the
+ * caller; readers never wait.
+ */
+#ifndef SEMVER_EPOCH_20261019
+#define SEMVER_EPOCH_20261019
+
+#include <stdatomic.h>
+
+struct epoch_domain_t;
+
+typedef struct epoch_reader_t {
+    struct epoch_domain_t* domain;
+    /* the global epoch when the reader entered, 0 - the reader is outside */
+    atomic_ullong epoch;
+    atomic_int in_use;
+    struct epoch_reader_t* next;
+} EpochReader;
+
+typedef struct epoch_retired_t {
+    void* ptr;
+    void (*free_fn)(void* ptr);
+    unsigned long long epoch;
+    struct epoch_retired_t* next;
+} EpochRetired;
+
+typedef struct epoch_domain_t {
+    _Atomic(void*) current;
+    atomic_ullong epoch;
+    /* readers are never removed from the list until the domain is freed */
+    _Atomic(EpochReader*) readers;
+    EpochRetired* retired;
+    /* records allocated by epoch_reserve */
+    EpochRetired* spare;
+} EpochDomain;
+
+void init_epoch_domain(EpochDomain* domain, void* current);
+/* Frees all retired data and readers, the current pointer is not freed.
+ * There must be no readers inside */
+void free_epoch_domain(EpochDomain* domain);
+
+/* Returns a free reader of the domain or a new one, NULL if there is no memory */
+EpochReader* open_epoch_reader(EpochDomain* domain);
+void close_epoch_reader(EpochReader* reader);
+
+/* Returns the current pointer, it stays valid until epoch_exit */
+void* epoch_enter(EpochReader* reader);
+void epoch_exit(EpochReader* reader);
+
+/* Writer side: the current pointer, publishing a new one, and retiring
+ * replaced data with its free function. A writer reserves records for
+ * everything it is going to retire before it publishes: epoch_reserve
+ * returns 0 if there is no memory, and then epoch_retire of up to count
+ * pointers cannot fail. Without a reserved record epoch_retire returns 0
+ * if ptr cannot be retired (it is leaked rather than freed too early)
+ */
+int epoch_reserve(EpochDomain* domain, int count);
+void* epoch_current(EpochDomain* domain);
+void epoch_publish(EpochDomain* domain, void* current);
+int epoch_retire(EpochDomain* domain, void* ptr, void (*free_fn)(void* ptr));
+/* Starts a new epoch and frees retired data that no reader can see */
+void epoch_advance(EpochDomain* domain);
+
+#endif
@@ -0,0 +1,283 @@
+#include <stdlib.h>
+
+#include "semver.h"
+#include "semver_group.h"
+#include "semver_threads.h"
+
+#define INITIAL_TABLE_SIZE 64
+
+/* Open addressing hash table of groups, latest is -1 in empty slots */
+typedef struct group_table_t {
+    VersionGroup* slots;
+    int size;
+    int used;
+} GroupTable;
+
+static int init_table(GroupTable* table) {
+    table->slots = malloc(INITIAL_TABLE_SIZE * sizeof(VersionGroup));
+    if (table->slots == NULL) {
+        return 0;
+    }
+    for (int i = 0; i < INITIAL_TABLE_SIZE; i++) {
+        table->slots[i].latest = -1;
+    }
+    table->size = INITIAL_TABLE_SIZE;
+    table->used = 0;
+    return 1;
+}
+
+static unsigned int group_hash(unsigned int major, unsigned int minor) {
+    unsigned int hash = major * 0x9e3779b1u ^ (minor + 0x7f4a7c15u) * 0x85ebca77u;
+    return hash ^ (hash >> 15);
+}
+
+/* Returns the slot of the group, a new group gets latest -1 */
+static VersionGroup* find_slot(VersionGroup* slots, int size, unsigned int major, unsigned int minor) {
+    unsigned int mask = size - 1;
+    unsigned int idx = group_hash(major, minor) & mask;
+    while (slots[idx].latest != -1 && (slots[idx].major != major || slots[idx].minor != minor)) {
+        idx = (idx + 1) & mask;
+    }
+    return &slots[idx];
+}
+
+static int grow_table(GroupTable* table) {
+    int size = table->size * 2;
+    VersionGroup* slots = malloc(size * sizeof(VersionGroup));
+    if (slots == NULL) {
+        return 0;
+    }
+    for (int i = 0; i < size; i++) {
+        slots[i].latest = -1;
+    }
+    for (int i = 0; i < table->size; i++) {
+        if (table->slots[i].latest != -1) {
+            const VersionGroup* g = &table->slots[i];
+            *find_slot(slots, size, g->major, g->minor) = *g;
+        }
+    }
+
+    free(table->slots);
+    table->slots = slots;
+    table->size = size;
+    return 1;
+}
+
+/* Returns the group of the key, adds an empty group if it does not exist */
+static VersionGroup* get_group(GroupTable* table, unsigned int major, unsigned int minor) {
+    VersionGroup* g = find_slot(table->slots, table->size, major, minor);
+    if (g->latest != -1) {
+        return g;
+    }
+
+    /* the table is kept at most half full */
+    if ((table->used + 1) * 2 > table->size) {
+        if (! grow_table(table)) {
+            return NULL;
+        }
+        g = find_slot(table->slots, table->size, major, minor);
+    }
+    table->used++;
+    g->major = major;
+    g->minor = minor;
+    g->count = 0;
+    return g;
+}
+
+/* Returns 1 if ver_a is greater than ver_b, numbers are compared first
+ * to avoid calling compare_versions for most pairs
+ */
+static int is_newer(const SemVersion* ver_a, const SemVersion* ver_b) {
+    if (ver_a->major != ver_b->major) {
+        return ver_a->major > ver_b->major;
+    }
+    if (ver_a->minor != ver_b->minor) {
+        return ver_a->minor > ver_b->minor;
+    }
+    if (ver_a->patch != ver_b->patch) {
+        return ver_a->patch > ver_b->patch;
+    }
+    if (ver_a->prerelease == PRERELEASE_NONE && ver_b->prerelease == PRERELEASE_NONE) {
+        return 0;
+    }
+    return compare_versions(ver_a, ver_b) > 0;
+}
+
+static int passes_filter(const SemVersion* ver, int filter) {
+    return ver->prerelease >= PRERELEASE_BASIC && ver->prerelease <= PRERELEASE_NONE &&
+        (filter & (1 << ver->prerelease)) != 0;
+}
+
+/* Adds versions [begin, end) to the table. Returns 0 if there is no memory */
+static int aggregate(const SemVersion* versions, int begin, int end, VersionGrouping grouping, int filter,
+        GroupTable* table) {
+    for (int i = begin; i < end; i++) {
+        const SemVersion* ver = &versions[i];
+        if (! passes_filter(ver, filter)) {
+            continue;
+        }
+
+        unsigned int major = grouping == GROUP_ALL ? 0 : ver->major;
+        unsigned int minor = grouping == GROUP_BY_MINOR ? ver->minor : 0;
+        VersionGroup* g = get_group(table, major, minor);
+        if (g == NULL) {
+            return 0;
+        }
+
+        if (g->latest == -1 || is_newer(ver, &versions[g->latest])) {
+            g->latest = i;
+        }
+        g->count++;
+    }
+
+    return 1;
+}
+
+/* Merges groups of the other table into the table. Groups of the table
+ * must come from versions that are before the ones of the other table
+ */
+static int merge_tables(const SemVersion* versions, GroupTable* table, const GroupTable* other) {
+    for (int i = 0; i < other->size; i++) {
+        const VersionGroup* src = &other->slots[i];
+        if (src->latest == -1) {
+            continue;
+        }
+
+        VersionGroup* g = get_group(table, src->major, src->minor);
+        if (g == NULL) {
+            return 0;
+        }
+        if (g->latest == -1 || is_newer(&versions[src->latest], &versions[g->latest])) {
+            g->latest = src->latest;
+        }
+        g->count += src->count;
+    }
+
+    return 1;
+}
+
+static int compare_groups(const void* a, const void* b) {
+    const VersionGroup* ga = a;
+    const VersionGroup* gb = b;
+    if (ga->major != gb->major) {
+        return ga->major > gb->major ? 1 : -1;
+    }
+    if (ga->minor != gb->minor) {
+        return ga->minor > gb->minor ? 1 : -1;
+    }
+    return 0;
+}
+
+/* Writes sorted groups of the table to the caller's buffer */
+static int write_groups(const GroupTable* table, VersionGroup* groups, int max_groups, int* group_count) {
+    *group_count = table->used;
+    if (table->used > max_groups || (table->used > 0 && groups == NULL)) {
+        return SEMVER_BUFFER_TOO_SMALL;
+    }
+
+    int n = 0;
+    for (int i = 0; i < table->size; i++) {
+        if (table->slots[i].latest != -1) {
+            groups[n++] = table->slots[i];
+        }
+    }
+    qsort(groups, n, sizeof(VersionGroup), compare_groups);
+
+    return SEMVER_OK;
+}
+
+int group_latest_versions(const SemVersion* versions, int count, VersionGrouping grouping, int filter,
+        VersionGroup* groups, int max_groups, int* group_count) {
+    if ((versions == NULL && count != 0) || count < 0 || group_count == NULL) {
+        return SEMVER_INVALID_VERSION;
+    }
+
+    GroupTable table;
+    if (! init_table(&table)) {
+        return SEMVER_OUT_OF_MEMORY;
+    }
+
+    int res = SEMVER_OUT_OF_MEMORY;
+    if (aggregate(versions, 0, count, grouping, filter, &table)) {
+        res = write_groups(&table, groups, max_groups, group_count);
+    }
+
+    free(table.slots);
+    return res;
+}
+
+typedef struct group_task_t {
+    const SemVersion* versions;
+    int begin;
+    int end;
+    VersionGrouping grouping;
+    int filter;
+    GroupTable table;
+    int ok;
+} GroupTask;
+
+static void run_task(void* arg, int part) {
+    GroupTask* task = (GroupTask*)arg + part;
+    if (task->table.slots != NULL) {
+        task->ok = aggregate(task->versions, task->begin, task->end, task->grouping, task->filter, &task->table);
+    }
+}
+
+/* Arrays smaller than this are not split between threads */
+#define MIN_PART_SIZE 4096
+
+int group_latest_versions_parallel(const SemVersion* versions, int count, VersionGrouping grouping, int filter,
+        VersionGroup* groups, int max_groups, int* group_count, int threads) {
+    if (threads > count / MIN_PART_SIZE) {
+        threads = count / MIN_PART_SIZE;
+    }
+    if (threads <= 1) {
+        return group_latest_versions(versions, count, grouping, filter, groups, max_groups, group_count);
+    }
+    if (versions == NULL || group_count == NULL) {
+        return SEMVER_INVALID_VERSION;
+    }
+
+    GroupTask* tasks = calloc(threads, sizeof(GroupTask));
+    if (tasks == NULL) {
+        return SEMVER_OUT_OF_MEMORY;
+    }
+
+    int res = SEMVER_OK;
+    for (int t = 0; t < threads; t++) {
+        GroupTask* task = &tasks[t];
+        task->versions = versions;
+        task->begin = (int)((long long)count * t / threads);
+        task->end = (int)((long long)count * (t + 1) / threads);
+        task->grouping = grouping;
+        task->filter = filter;
+        if (! init_table(&task->table)) {
+            res = SEMVER_OUT_OF_MEMORY;
+            break;
+        }
+    }
+    if (res == SEMVER_OK) {
+        run_parallel(threads, run_task, tasks);
+    }
+    for (int t = 0; t < threads && res == SEMVER_OK; t++) {
+        if (! tasks[t].ok) {
+            res = SEMVER_OUT_OF_MEMORY;
+        }
+    }
+
+    /* parts are merged in order, so ties are resolved as in a single pass */
+    for (int t = 1; t < threads && res == SEMVER_OK; t++) {
+        if (! merge_tables(versions, &tasks[0].table, &tasks[t].table)) {
+            res = SEMVER_OUT_OF_MEMORY;
+        }
+    }
+    if (res == SEMVER_OK) {
+        res = write_groups(&tasks[0].table, groups, max_groups, group_count);
+    }
+
+    for (int t = 0; t < threads; t++) {
+        free(tasks[t].table.slots);
+    }
+    free(tasks);
+    return res;
+}
@@ -0,0 +1,224 @@
+#include <ctype.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include "semver.h"
+#include "semver_hash.h"
+
+#define INITIAL_MAP_CAPACITY 16
+#define HASH_MULTIPLIER 0x9e3779b97f4a7c15ull
+/* numeric prerelease identifiers are mixed with this bit set, so they
+ * never collide with the first character of other identifiers
+ */
+#define NUMERIC_IDENTIFIER (1ull << 32)
+
+static unsigned long long mix(unsigned long long hash, unsigned long long value) {
+    hash = (hash ^ value) * HASH_MULTIPLIER;
+    return hash ^ (hash >> 29);
+}
+
+unsigned long long hash_version(const SemVersion* version, int flags) {
+    if (version == NULL) {
+        return 0;
+    }
+
+    unsigned long long hash = mix(HASH_MULTIPLIER, ((unsigned long long)version->major << 32) | version->minor);
+    hash = mix(hash, ((unsigned long long)version->patch << 32) | (unsigned int)version->prerelease);
+
+    if (version->prerelease != PRERELEASE_NONE) {
+        /* identifiers are read the same way compare_versions reads them:
+         * for alpha, beta, and rc the first identifier is skipped
+         */
+        const char* pre = version->prerelease_str;
+        if (version->prerelease != PRERELEASE_BASIC) {
+            while (*pre != '\0' && *pre++ != '.');
+        }
+
+        while (*pre != '\0') {
+            if (isdigit(*pre)) {
+                hash = mix(hash, NUMERIC_IDENTIFIER | (unsigned int)atoi(pre));
+            } else {
+                hash = mix(hash, (unsigned char)*pre);
+            }
+            while (*pre != '\0' && *pre++ != '.');
+        }
+    }
+
+    if (flags & VERSION_HASH_BUILD) {
+        for (int i = 0; i < MAX_BUILD_LEN && version->build_str[i] != '\0'; i++) {
+            hash = mix(hash, (unsigned char)version->build_str[i]);
+        }
+    }
+
+    hash ^= hash >> 32;
+    return hash * HASH_MULTIPLIER;
+}
+
+int version_hash_equals(const SemVersion* ver_a, const SemVersion* ver_b, int flags) {
+    if (compare_versions(ver_a, ver_b) != 0) {
+        return 0;
+    }
+    if ((flags & VERSION_HASH_BUILD) == 0 || ver_a == NULL || ver_b == NULL) {
+        return 1;
+    }
+    return strncmp(ver_a->build_str, ver_b->build_str, MAX_BUILD_LEN) == 0;
+}
+
+/* Hash stored in an entry: high bits of the full hash, never 0 */
+static unsigned int entry_hash(const VersionMap* map, const SemVersion* version) {
+    unsigned int hash = (unsigned int)(hash_version(version, map->flags) >> 32);
+    return hash == 0 ? 1 : hash;
+}
+
+/* Returns the slot of the version: either its entry or an empty slot */
+static VersionMapEntry* find_slot(const VersionMap* map, const SemVersion* version, unsigned int hash) {
+    unsigned int mask = map->capacity - 1;
+    unsigned int idx = hash & mask;
+    while (map->entries[idx].hash != 0) {
+        VersionMapEntry* e = &map->entries[idx];
+        if (e->hash == hash && version_hash_equals(&e->version, version, map->flags)) {
+            return e;
+        }
+        idx = (idx + 1) & mask;
+    }
+    return &map->entries[idx];
+}
+
+static int grow_map(VersionMap* map) {
+    int capacity = map->capacity == 0 ? INITIAL_MAP_CAPACITY : map->capacity * 2;
+    VersionMapEntry* entries = calloc(capacity, sizeof(VersionMapEntry));
+    if (entries == NULL) {
+        return 0;
+    }
+
+    unsigned int mask = capacity - 1;
+    for (int i = 0; i < map->capacity; i++) {
+        if (map->entries[i].hash == 0) {
+            continue;
+        }
+        unsigned int idx = map->entries[i].hash & mask;
+        while (entries[idx].hash != 0) {
+            idx = (idx + 1) & mask;
+        }
+        entries[idx] = map->entries[i];
+    }
+
+    free(map->entries);
+    map->entries = entries;
+    map->capacity = capacity;
+    return 1;
+}
+
+VersionMap* init_version_map(int flags) {
+    VersionMap* map = calloc(1, sizeof(VersionMap));
+    if (map != NULL) {
+        map->flags = flags;
+    }
+    return map;
+}
+
+void free_version_map(VersionMap** map) {
+    if (map == NULL || *map == NULL) {
+        return;
+    }
+
+    free((*map)->entries);
+    free(*map);
+    *map = NULL;
+}
+
+void clear_version_map(VersionMap* map) {
+    if (map == NULL || map->entries == NULL) {
+        return;
+    }
+
+    memset(map->entries, 0, map->capacity * sizeof(VersionMapEntry));
+    map->count = 0;
+}
+
+VersionMapEntry* version_map_insert(VersionMap* map, const SemVersion* version, int* added) {
+    if (map == NULL || version == NULL) {
+        return NULL;
+    }
+
+    unsigned int hash = entry_hash(map, version);
+    VersionMapEntry* e = NULL;
+    if (map->entries != NULL) {
+        e = find_slot(map, version, hash);
+        if (e->hash != 0) {
+            if (added != NULL) {
+                *added = 0;
+            }
+            return e;
+        }
+    }
+
+    /* the table is kept at most 3/4 full */
+    if (map->entries == NULL || (map->count + 1) * 4 > map->capacity * 3) {
+        if (! grow_map(map)) {
+            return NULL;
+        }
+        e = find_slot(map, version, hash);
+    }
+
+    e->hash = hash;
+    e->version = *version;
+    e->value = NULL;
+    map->count++;
+    if (added != NULL) {
+        *added = 1;
+    }
+    return e;
+}
+
+VersionMapEntry* version_map_find(const VersionMap* map, const SemVersion* version) {
+    if (map == NULL || version == NULL || map->entries == NULL) {
+        return NULL;
+    }
+
+    VersionMapEntry* e = find_slot(map, version, entry_hash(map, version));
+    return e->hash != 0 ? e : NULL;
+}
+
+int version_map_remove(VersionMap* map, const SemVersion* version) {
+    VersionMapEntry* e = version_map_find(map, version);
+    if (e == NULL) {
+        return 0;
+    }
+
+    /* shift back entries that cannot be found past the emptied slot */
+    unsigned int mask = map->capacity - 1;
+    unsigned int hole = (unsigned int)(e - map->entries);
+    unsigned int idx = hole;
+    for (;;) {
+        idx = (idx + 1) & mask;
+        if (map->entries[idx].hash == 0) {
+            break;
+        }
+        unsigned int home = map->entries[idx].hash & mask;
+        /* the entry stays if its home slot is cyclically in (hole, idx] */
+        int stays = hole <= idx ? (home > hole && home <= idx) : (home > hole || home <= idx);
+        if (! stays) {
+            map->entries[hole] = map->entries[idx];
+            hole = idx;
+        }
+    }
+
+    map->entries[hole].hash = 0;
+    map->count--;
+    return 1;
+}
+
+VersionMapEntry* version_map_next(const VersionMap* map, const VersionMapEntry* entry) {
+    if (map == NULL || map->entries == NULL) {
+        return NULL;
+    }
+
+    int idx = entry == NULL ? 0 : (int)(entry - map->entries) + 1;
+    for (; idx < map->capacity; idx++) {
+        if (map->entries[idx].hash != 0) {
+            return &map->entries[idx];
+        }
+    }
+    return NULL;
+}
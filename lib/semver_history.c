@@ -0,0 +1,424 @@
+#include <string.h>
+#include <stdlib.h>
+#include <limits.h>
+
+#include "semver.h"
+#include "semver_history.h"
+
+/* tag bits */
+#define TAG_KIND 0x03
+#define TAG_PATCH 0
+#define TAG_MINOR 1
+#define TAG_MAJOR 2
+#define TAG_PRERELEASE_SHIFT 2
+#define TAG_PRERELEASE_MASK 0x1C
+#define TAG_PRERELEASE_STR 0x20
+#define TAG_BUILD_STR 0x40
+
+/* header field offsets */
+#define HEADER_FORMAT 4
+#define HEADER_BLOCK 6
+#define HEADER_COUNT 8
+#define HEADER_SIZE 12
+
+static unsigned int read_u32(const unsigned char* p) {
+    return (unsigned int)p[0] | ((unsigned int)p[1] << 8) | ((unsigned int)p[2] << 16) | ((unsigned int)p[3] << 24);
+}
+
+static unsigned int read_u16(const unsigned char* p) {
+    return (unsigned int)p[0] | ((unsigned int)p[1] << 8);
+}
+
+/* Output buffer: bytes that do not fit are counted but not written */
+typedef struct history_writer_t {
+    unsigned char* data;
+    size_t size;
+    size_t pos;
+} HistoryWriter;
+
+static void put_byte_at(HistoryWriter* w, size_t pos, unsigned int value) {
+    if (w->data != NULL && pos < w->size) {
+        w->data[pos] = (unsigned char)value;
+    }
+}
+
+static void put_u32_at(HistoryWriter* w, size_t pos, unsigned int value) {
+    for (int i = 0; i < 4; i++) {
+        put_byte_at(w, pos + i, (value >> (8 * i)) & 0xFF);
+    }
+}
+
+static void put_byte(HistoryWriter* w, unsigned int value) {
+    put_byte_at(w, w->pos++, value);
+}
+
+static void put_varint(HistoryWriter* w, unsigned int value) {
+    while (value >= 0x80) {
+        put_byte(w, (value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    put_byte(w, value);
+}
+
+/* Writes str front-coded against prev: the length of the common prefix,
+ * the length of the rest, and the rest */
+static void put_string(HistoryWriter* w, const char* prev, const char* str, size_t len) {
+    size_t str_len = strnlen(str, len);
+    size_t shared = 0;
+    while (shared < str_len && prev[shared] == str[shared]) {
+        shared++;
+    }
+
+    put_byte(w, shared);
+    put_byte(w, str_len - shared);
+    for (size_t i = shared; i < str_len; i++) {
+        put_byte(w, (unsigned char)str[i]);
+    }
+}
+
+/* Copies str and fills the rest of dest with zeroes */
+static void copy_string(char* dest, const char* str, size_t len) {
+    size_t str_len = strnlen(str, len);
+    memcpy(dest, str, str_len);
+    memset(dest + str_len, 0, len - str_len);
+}
+
+static int same_string(const char* a, const char* b, size_t len) {
+    return strncmp(a, b, len) == 0;
+}
+
+int encode_version_history(const SemVersion* versions, int count, unsigned char* data, size_t size,
+        size_t* data_size) {
+    if (count < 0 || (versions == NULL && count != 0)) {
+        return SEMVER_INVALID_VERSION;
+    }
+    for (int i = 1; i < count; i++) {
+        if (compare_versions(&versions[i - 1], &versions[i]) > 0) {
+            return SEMVER_INVALID_VERSION;
+        }
+    }
+
+    int block_count = (count + VERSION_HISTORY_BLOCK - 1) / VERSION_HISTORY_BLOCK;
+    HistoryWriter w = { data, size, VERSION_HISTORY_HEADER_SIZE + (size_t)block_count * VERSION_HISTORY_INDEX_SIZE };
+    SemVersion prev;
+
+    for (int i = 0; i < count; i++) {
+        const SemVersion* v = &versions[i];
+        unsigned int kind;
+
+        if (i % VERSION_HISTORY_BLOCK == 0) {
+            size_t entry = VERSION_HISTORY_HEADER_SIZE + (size_t)(i / VERSION_HISTORY_BLOCK) * VERSION_HISTORY_INDEX_SIZE;
+            put_u32_at(&w, entry, (unsigned int)w.pos);
+            put_u32_at(&w, entry + 4, v->major);
+            put_u32_at(&w, entry + 8, v->minor);
+            put_u32_at(&w, entry + 12, v->patch);
+            memset(&prev, 0, sizeof(prev));
+            kind = TAG_MAJOR;
+        } else if (v->major != prev.major) {
+            kind = TAG_MAJOR;
+        } else if (v->minor != prev.minor) {
+            kind = TAG_MINOR;
+        } else {
+            kind = TAG_PATCH;
+        }
+
+        unsigned int tag = kind | ((unsigned int)v->prerelease << TAG_PRERELEASE_SHIFT);
+        if (! same_string(prev.prerelease_str, v->prerelease_str, MAX_PRERELEASE_LEN)) {
+            tag |= TAG_PRERELEASE_STR;
+        }
+        if (! same_string(prev.build_str, v->build_str, MAX_BUILD_LEN)) {
+            tag |= TAG_BUILD_STR;
+        }
+        put_byte(&w, tag);
+
+        if (kind == TAG_MAJOR) {
+            put_varint(&w, v->major - prev.major);
+            put_varint(&w, v->minor);
+            put_varint(&w, v->patch);
+        } else if (kind == TAG_MINOR) {
+            put_varint(&w, v->minor - prev.minor);
+            put_varint(&w, v->patch);
+        } else {
+            put_varint(&w, v->patch - prev.patch);
+        }
+        if (tag & TAG_PRERELEASE_STR) {
+            put_string(&w, prev.prerelease_str, v->prerelease_str, MAX_PRERELEASE_LEN);
+        }
+        if (tag & TAG_BUILD_STR) {
+            put_string(&w, prev.build_str, v->build_str, MAX_BUILD_LEN);
+        }
+
+        /* the previous version as the decoder sees it */
+        prev.major = v->major;
+        prev.minor = v->minor;
+        prev.patch = v->patch;
+        copy_string(prev.prerelease_str, v->prerelease_str, MAX_PRERELEASE_LEN);
+        copy_string(prev.build_str, v->build_str, MAX_BUILD_LEN);
+    }
+
+    put_u32_at(&w, 0, VERSION_HISTORY_MAGIC);
+    put_byte_at(&w, HEADER_FORMAT, VERSION_HISTORY_FORMAT & 0xFF);
+    put_byte_at(&w, HEADER_FORMAT + 1, VERSION_HISTORY_FORMAT >> 8);
+    put_byte_at(&w, HEADER_BLOCK, VERSION_HISTORY_BLOCK & 0xFF);
+    put_byte_at(&w, HEADER_BLOCK + 1, VERSION_HISTORY_BLOCK >> 8);
+    put_u32_at(&w, HEADER_COUNT, (unsigned int)count);
+    put_u32_at(&w, HEADER_SIZE, (unsigned int)w.pos);
+
+    if (data_size != NULL) {
+        *data_size = w.pos;
+    }
+    return (data == NULL || w.pos > size) ? SEMVER_BUFFER_TOO_SMALL : SEMVER_OK;
+}
+
+static size_t block_offset(const HistoryDecoder* decoder, int block) {
+    return read_u32(decoder->data + VERSION_HISTORY_HEADER_SIZE + (size_t)block * VERSION_HISTORY_INDEX_SIZE);
+}
+
+static void open_block(HistoryDecoder* decoder, int block) {
+    decoder->next = block * decoder->block_size;
+    decoder->pos = block_offset(decoder, block);
+    decoder->block_end = block + 1 < decoder->block_count ? block_offset(decoder, block + 1) : decoder->size;
+    memset(&decoder->last, 0, sizeof(SemVersion));
+}
+
+int init_history_decoder(HistoryDecoder* decoder, const unsigned char* data, size_t size) {
+    if (decoder == NULL) {
+        return SEMVER_INVALID_VERSION;
+    }
+    if (data == NULL || size < VERSION_HISTORY_HEADER_SIZE || read_u32(data) != VERSION_HISTORY_MAGIC ||
+            read_u16(data + HEADER_FORMAT) != VERSION_HISTORY_FORMAT || read_u16(data + HEADER_BLOCK) == 0) {
+        return SEMVER_INVALID_BLOB;
+    }
+
+    unsigned int count = read_u32(data + HEADER_COUNT);
+    unsigned int block_size = read_u16(data + HEADER_BLOCK);
+    size_t data_size = read_u32(data + HEADER_SIZE);
+    size_t block_count = (count + (size_t)block_size - 1) / block_size;
+    size_t index_end = VERSION_HISTORY_HEADER_SIZE + block_count * VERSION_HISTORY_INDEX_SIZE;
+    if (count > INT_MAX || data_size > size || index_end > data_size) {
+        return SEMVER_INVALID_BLOB;
+    }
+
+    decoder->data = data;
+    decoder->size = data_size;
+    decoder->count = (int)count;
+    decoder->block_size = (int)block_size;
+    decoder->block_count = (int)block_count;
+
+    size_t prev = index_end;
+    for (int i = 0; i < decoder->block_count; i++) {
+        size_t offset = block_offset(decoder, i);
+        if (offset < prev || offset > data_size) {
+            return SEMVER_INVALID_BLOB;
+        }
+        prev = offset;
+    }
+
+    if (block_count > 0) {
+        open_block(decoder, 0);
+    } else {
+        decoder->next = 0;
+        decoder->pos = index_end;
+        decoder->block_end = index_end;
+        memset(&decoder->last, 0, sizeof(SemVersion));
+    }
+    return SEMVER_OK;
+}
+
+static const unsigned char* read_varint(const unsigned char* p, const unsigned char* end, unsigned int* value) {
+    unsigned int v = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+        if (p >= end) {
+            return NULL;
+        }
+        unsigned int b = *p++;
+        v |= (b & 0x7F) << shift;
+        if (b < 0x80) {
+            *value = v;
+            return p;
+        }
+    }
+    return NULL;
+}
+
+static const unsigned char* read_string(const unsigned char* p, const unsigned char* end, char* str, size_t len) {
+    if (end - p < 2) {
+        return NULL;
+    }
+    size_t shared = p[0];
+    size_t suffix = p[1];
+    p += 2;
+    if (shared + suffix > len || (size_t)(end - p) < suffix) {
+        return NULL;
+    }
+    memcpy(str + shared, p, suffix);
+    memset(str + shared + suffix, 0, len - shared - suffix);
+    return p + suffix;
+}
+
+/* Decodes the record at p over the previous version ver. Returns the
+ * next record or NULL if the record is broken */
+static const unsigned char* decode_record(const unsigned char* p, const unsigned char* end, SemVersion* ver) {
+    if (p >= end) {
+        return NULL;
+    }
+    unsigned int tag = *p++;
+    unsigned int delta;
+    if ((tag & ~(TAG_KIND | TAG_PRERELEASE_MASK | TAG_PRERELEASE_STR | TAG_BUILD_STR)) != 0 ||
+            (tag & TAG_PRERELEASE_MASK) >> TAG_PRERELEASE_SHIFT > PRERELEASE_NONE) {
+        return NULL;
+    }
+
+    p = read_varint(p, end, &delta);
+    if (p == NULL) {
+        return NULL;
+    }
+    switch (tag & TAG_KIND) {
+        case TAG_PATCH:
+            ver->patch += delta;
+            break;
+        case TAG_MINOR:
+            ver->minor += delta;
+            p = read_varint(p, end, &ver->patch);
+            break;
+        case TAG_MAJOR:
+            ver->major += delta;
+            p = read_varint(p, end, &ver->minor);
+            if (p != NULL) {
+                p = read_varint(p, end, &ver->patch);
+            }
+            break;
+        default:
+            return NULL;
+    }
+
+    ver->prerelease = (tag & TAG_PRERELEASE_MASK) >> TAG_PRERELEASE_SHIFT;
+    if (p != NULL && (tag & TAG_PRERELEASE_STR)) {
+        p = read_string(p, end, ver->prerelease_str, MAX_PRERELEASE_LEN);
+    }
+    if (p != NULL && (tag & TAG_BUILD_STR)) {
+        p = read_string(p, end, ver->build_str, MAX_BUILD_LEN);
+    }
+    return p;
+}
+
+int history_decoder_read(HistoryDecoder* decoder, SemVersion* versions, int max) {
+    if (decoder == NULL || (versions == NULL && max > 0)) {
+        return -1;
+    }
+
+    int n = 0;
+    while (n < max && decoder->next < decoder->count) {
+        int in_block = decoder->next % decoder->block_size;
+        if (in_block == 0) {
+            open_block(decoder, decoder->next / decoder->block_size);
+        }
+
+        int todo = decoder->block_size - in_block;
+        if (todo > max - n) {
+            todo = max - n;
+        }
+        if (todo > decoder->count - decoder->next) {
+            todo = decoder->count - decoder->next;
+        }
+
+        /* numbers are kept apart from the strings: a version is written
+         * field by field, so its copy never reads a just changed number */
+        const unsigned char* p = decoder->data + decoder->pos;
+        const unsigned char* end = decoder->data + decoder->block_end;
+        SemVersion* last = &decoder->last;
+        unsigned int major = last->major;
+        unsigned int minor = last->minor;
+        unsigned int patch = last->patch;
+        Prerelease prerelease = last->prerelease;
+        for (int i = 0; i < todo; i++) {
+            /* the most frequent record: the next patch, strings are the same */
+            if (end - p >= 2 && (p[0] & TAG_KIND) == TAG_PATCH &&
+                    p[0] <= (PRERELEASE_NONE << TAG_PRERELEASE_SHIFT) && p[1] < 0x80) {
+                patch += p[1];
+                prerelease = p[0] >> TAG_PRERELEASE_SHIFT;
+                p += 2;
+            } else {
+                last->major = major;
+                last->minor = minor;
+                last->patch = patch;
+                p = decode_record(p, end, last);
+                if (p == NULL) {
+                    return -1;
+                }
+                major = last->major;
+                minor = last->minor;
+                patch = last->patch;
+                prerelease = last->prerelease;
+            }
+
+            SemVersion* out = &versions[n + i];
+            out->major = major;
+            out->minor = minor;
+            out->patch = patch;
+            out->cmp = COMPARE_NONE;
+            out->prerelease = prerelease;
+            memcpy(out->prerelease_str, last->prerelease_str, MAX_PRERELEASE_LEN);
+            memcpy(out->build_str, last->build_str, MAX_BUILD_LEN);
+        }
+
+        last->major = major;
+        last->minor = minor;
+        last->patch = patch;
+        last->prerelease = prerelease;
+        decoder->pos = p - decoder->data;
+        decoder->next += todo;
+        n += todo;
+    }
+
+    return n;
+}
+
+/* Returns -1, 0, or 1 comparing the numbers of ver with a block index entry */
+static int compare_block_numbers(const HistoryDecoder* decoder, int block, const SemVersion* ver) {
+    const unsigned char* entry = decoder->data + VERSION_HISTORY_HEADER_SIZE + (size_t)block * VERSION_HISTORY_INDEX_SIZE;
+    unsigned int numbers[PART_COUNT] = { ver->major, ver->minor, ver->patch };
+    for (int i = 0; i < PART_COUNT; i++) {
+        unsigned int first = read_u32(entry + 4 + 4 * i);
+        if (first != numbers[i]) {
+            return first < numbers[i] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+int history_decoder_seek(HistoryDecoder* decoder, const SemVersion* ver) {
+    if (decoder == NULL || ver == NULL) {
+        return -1;
+    }
+    if (decoder->block_count == 0) {
+        return 0;
+    }
+
+    /* the last block that starts with smaller numbers than ver: all
+     * versions of the blocks before it are less than ver */
+    int lo = 0, hi = decoder->block_count;
+    while (hi - lo > 1) {
+        int mid = lo + (hi - lo) / 2;
+        if (compare_block_numbers(decoder, mid, ver) < 0) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    open_block(decoder, lo);
+
+    while (decoder->next < decoder->count) {
+        HistoryDecoder saved = *decoder;
+        SemVersion v;
+        if (history_decoder_read(decoder, &v, 1) != 1) {
+            return -1;
+        }
+        if (compare_versions(&v, ver) >= 0) {
+            *decoder = saved;
+            break;
+        }
+    }
+
+    return decoder->next;
+}
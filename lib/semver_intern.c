@@ -0,0 +1,311 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "semver.h"
+#include "semver_check.h"
+#include "semver_intern.h"
+
+#define INITIAL_CAPACITY 16
+
+typedef struct term_list_t {
+    ConstraintTerm* terms;
+    int count;
+    int capacity;
+    int any;
+} TermList;
+
+/* Clears everything that does not change how the item matches, so equal
+ * items have equal bytes
+ */
+static void canonical_item(SemVersion* dst, const SemVersion* src) {
+    memset(dst, 0, sizeof(SemVersion));
+    dst->major = src->major;
+    dst->minor = src->minor;
+    dst->patch = src->patch;
+    dst->cmp = src->cmp == COMPARE_NONE ? COMPARE_EQUAL : src->cmp;
+    dst->prerelease = src->prerelease;
+    if (src->prerelease != PRERELEASE_NONE) {
+        strncpy(dst->prerelease_str, src->prerelease_str, MAX_PRERELEASE_LEN);
+    }
+}
+
+static int collect_term(const SemVersion* items, int count, void* data) {
+    TermList* list = data;
+
+    if (count == 0) {
+        list->any = 1;
+        return SEMVER_OK;
+    }
+    if (list->count == list->capacity) {
+        int capacity = list->capacity == 0 ? INITIAL_CAPACITY : list->capacity * 2;
+        ConstraintTerm* terms = realloc(list->terms, capacity * sizeof(ConstraintTerm));
+        if (terms == NULL) {
+            return SEMVER_OUT_OF_MEMORY;
+        }
+        list->terms = terms;
+        list->capacity = capacity;
+    }
+
+    ConstraintTerm* term = &list->terms[list->count++];
+    memset(term, 0, sizeof(ConstraintTerm));
+    term->count = count;
+    for (int i = 0; i < count; i++) {
+        canonical_item(&term->items[i], &items[i]);
+    }
+    return SEMVER_OK;
+}
+
+static int compare_terms(const void* a, const void* b) {
+    return memcmp(a, b, sizeof(ConstraintTerm));
+}
+
+/* Sorts terms and removes duplicates. A list with '*' becomes one term
+ * without items
+ */
+static void canonical_terms(TermList* list) {
+    if (list->any) {
+        list->count = 1;
+        memset(&list->terms[0], 0, sizeof(ConstraintTerm));
+        return;
+    }
+
+    if (list->count > 1) {
+        qsort(list->terms, list->count, sizeof(ConstraintTerm), compare_terms);
+    }
+    int count = 0;
+    for (int i = 0; i < list->count; i++) {
+        if (count == 0 || compare_terms(&list->terms[count - 1], &list->terms[i]) != 0) {
+            list->terms[count++] = list->terms[i];
+        }
+    }
+    list->count = count;
+}
+
+static unsigned int hash_terms(const ConstraintTerm* terms, int count) {
+    const unsigned char* data = (const unsigned char*)terms;
+    size_t size = count * sizeof(ConstraintTerm);
+    unsigned int hash = 2166136261u;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= data[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static int same_terms(const InternedConstraint* c, const ConstraintTerm* terms, int count) {
+    return c->term_count == count && (count == 0 || memcmp(c->terms, terms, count * sizeof(ConstraintTerm)) == 0);
+}
+
+/* Returns the slot of the list: its handle or an empty slot */
+static unsigned int* find_slot(const ConstraintTable* table, const ConstraintTerm* terms, int count, unsigned int hash) {
+    unsigned int mask = table->slot_count - 1;
+    unsigned int idx = hash & mask;
+    while (table->slots[idx] != INVALID_CONSTRAINT) {
+        const InternedConstraint* c = &table->constraints[table->slots[idx]];
+        if (c->hash == hash && same_terms(c, terms, count)) {
+            return &table->slots[idx];
+        }
+        idx = (idx + 1) & mask;
+    }
+    return &table->slots[idx];
+}
+
+static int grow_slots(ConstraintTable* table) {
+    unsigned int slot_count = table->slot_count == 0 ? INITIAL_CAPACITY : table->slot_count * 2;
+    unsigned int* slots = calloc(slot_count, sizeof(unsigned int));
+    if (slots == NULL) {
+        return 0;
+    }
+
+    unsigned int mask = slot_count - 1;
+    for (unsigned int i = 0; i < table->slot_count; i++) {
+        unsigned int handle = table->slots[i];
+        if (handle == INVALID_CONSTRAINT) {
+            continue;
+        }
+        unsigned int idx = table->constraints[handle].hash & mask;
+        while (slots[idx] != INVALID_CONSTRAINT) {
+            idx = (idx + 1) & mask;
+        }
+        slots[idx] = handle;
+    }
+
+    free(table->slots);
+    table->slots = slots;
+    table->slot_count = slot_count;
+    return 1;
+}
+
+/* Returns a free handle, INVALID_CONSTRAINT if there is no memory */
+static unsigned int new_handle(ConstraintTable* table) {
+    if (table->free_head != INVALID_CONSTRAINT) {
+        unsigned int handle = table->free_head;
+        table->free_head = table->constraints[handle].next_free;
+        return handle;
+    }
+
+    /* handles are 1..capacity-1, 0 is never used */
+    if (table->count + 1 >= table->capacity) {
+        unsigned int capacity = table->capacity == 0 ? INITIAL_CAPACITY : table->capacity * 2;
+        InternedConstraint* constraints = realloc(table->constraints, capacity * sizeof(InternedConstraint));
+        if (constraints == NULL) {
+            return INVALID_CONSTRAINT;
+        }
+        memset(constraints + table->capacity, 0, (capacity - table->capacity) * sizeof(InternedConstraint));
+        table->constraints = constraints;
+        table->capacity = capacity;
+    }
+    return table->count + 1;
+}
+
+ConstraintTable* init_constraint_table() {
+    return calloc(1, sizeof(ConstraintTable));
+}
+
+void free_constraint_table(ConstraintTable** table) {
+    if (table == NULL || *table == NULL) {
+        return;
+    }
+
+    for (unsigned int i = 1; i < (*table)->capacity; i++) {
+        free((*table)->constraints[i].terms);
+    }
+    free((*table)->constraints);
+    free((*table)->slots);
+    free(*table);
+    *table = NULL;
+}
+
+int intern_constraint(ConstraintTable* table, const char* version_list, unsigned int* handle) {
+    if (table == NULL || handle == NULL) {
+        return SEMVER_INVALID_VERSION_LIST;
+    }
+
+    TermList list;
+    memset(&list, 0, sizeof(list));
+    int res = walk_version_list(version_list, collect_term, &list);
+    /* '*' and lists that no version meets have no terms, the constraint
+     * still gets its own block */
+    if (res == SEMVER_OK && list.count == 0) {
+        list.terms = malloc(sizeof(ConstraintTerm));
+        res = list.terms == NULL ? SEMVER_OUT_OF_MEMORY : SEMVER_OK;
+    }
+    if (res != SEMVER_OK) {
+        free(list.terms);
+        return res;
+    }
+
+    canonical_terms(&list);
+    unsigned int hash = hash_terms(list.terms, list.count);
+
+    if (table->slots != NULL) {
+        unsigned int* slot = find_slot(table, list.terms, list.count, hash);
+        if (*slot != INVALID_CONSTRAINT) {
+            table->constraints[*slot].refs++;
+            *handle = *slot;
+            free(list.terms);
+            return SEMVER_OK;
+        }
+    }
+
+    /* the index is kept at most 3/4 full */
+    if (table->slots == NULL || (table->count + 1) * 4 > table->slot_count * 3) {
+        if (! grow_slots(table)) {
+            free(list.terms);
+            return SEMVER_OUT_OF_MEMORY;
+        }
+    }
+    unsigned int h = new_handle(table);
+    if (h == INVALID_CONSTRAINT) {
+        free(list.terms);
+        return SEMVER_OUT_OF_MEMORY;
+    }
+
+    InternedConstraint* c = &table->constraints[h];
+    c->terms = list.terms;
+    c->term_count = list.count;
+    c->refs = 1;
+    c->hash = hash;
+    c->next_free = INVALID_CONSTRAINT;
+    *find_slot(table, list.terms, list.count, hash) = h;
+    table->count++;
+
+    *handle = h;
+    return SEMVER_OK;
+}
+
+const InternedConstraint* get_constraint(const ConstraintTable* table, unsigned int handle) {
+    if (table == NULL || handle == INVALID_CONSTRAINT || handle >= table->capacity ||
+            table->constraints[handle].refs == 0) {
+        return NULL;
+    }
+    return &table->constraints[handle];
+}
+
+int retain_constraint(ConstraintTable* table, unsigned int handle) {
+    if (get_constraint(table, handle) == NULL) {
+        return SEMVER_INVALID_HANDLE;
+    }
+    table->constraints[handle].refs++;
+    return SEMVER_OK;
+}
+
+int release_constraint(ConstraintTable* table, unsigned int handle) {
+    if (get_constraint(table, handle) == NULL) {
+        return SEMVER_INVALID_HANDLE;
+    }
+    InternedConstraint* c = &table->constraints[handle];
+    if (--c->refs > 0) {
+        return SEMVER_OK;
+    }
+
+    /* remove the handle from the index, shifting back entries that cannot
+     * be found past the emptied slot
+     */
+    unsigned int mask = table->slot_count - 1;
+    unsigned int hole = (unsigned int)(find_slot(table, c->terms, c->term_count, c->hash) - table->slots);
+    unsigned int idx = hole;
+    for (;;) {
+        idx = (idx + 1) & mask;
+        if (table->slots[idx] == INVALID_CONSTRAINT) {
+            break;
+        }
+        unsigned int home = table->constraints[table->slots[idx]].hash & mask;
+        int stays = hole <= idx ? (home > hole && home <= idx) : (home > hole || home <= idx);
+        if (! stays) {
+            table->slots[hole] = table->slots[idx];
+            hole = idx;
+        }
+    }
+    table->slots[hole] = INVALID_CONSTRAINT;
+
+    free(c->terms);
+    c->terms = NULL;
+    c->term_count = 0;
+    c->next_free = table->free_head;
+    table->free_head = handle;
+    table->count--;
+    return SEMVER_OK;
+}
+
+int check_constraint(const ConstraintTable* table, unsigned int handle, const SemVersion* ver) {
+    const InternedConstraint* c = get_constraint(table, handle);
+    if (c == NULL) {
+        return SEMVER_INVALID_HANDLE;
+    }
+    if (ver == NULL) {
+        return SEMVER_INVALID_VERSION;
+    }
+
+    for (int i = 0; i < c->term_count; i++) {
+        const ConstraintTerm* term = &c->terms[i];
+        int fits = 1;
+        for (int j = 0; j < term->count && fits; j++) {
+            fits = version_equals(ver, &term->items[j]);
+        }
+        if (fits) {
+            return SEMVER_OK;
+        }
+    }
+    return SEMVER_OUT_OF_RANGE;
+}
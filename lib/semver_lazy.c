@@ -0,0 +1,105 @@
+#include <string.h>
+
+#include "semver.h"
+#include "semver_lazy.h"
+#include "semver_parse.h"
+
+int parse_lazy_version(const char* str, int flags, LazyVersion* version) {
+    if (str == NULL || version == NULL) {
+        return SEMVER_INVALID_VERSION;
+    }
+
+    SemVersion numbers;
+    numbers.cmp = COMPARE_NONE;
+    int res;
+    const char* tail = parse_version_numbers(str, &numbers, &res);
+    if (res != SEMVER_OK) {
+        return res;
+    }
+
+    version->major = numbers.major;
+    version->minor = numbers.minor;
+    version->patch = numbers.patch;
+    version->cmp = numbers.cmp;
+    version->str = str;
+    version->tail = *tail == '\0' ? -1 : (int)(tail - str);
+    version->decoded = 0;
+    version->tail_error = SEMVER_OK;
+
+    /* only '-' starts a prerelease, anything else needs no decoding */
+    if (*tail != '-') {
+        version->decoded = 1;
+        version->prerelease = PRERELEASE_NONE;
+        version->prerelease_str[0] = '\0';
+    }
+
+    if (flags & LAZY_VERSION_STRICT) {
+        res = *tail == '-' ? decode_lazy_version(version) : parse_version_tail(tail, NULL);
+    }
+    return res;
+}
+
+int decode_lazy_version(LazyVersion* version) {
+    if (version == NULL) {
+        return SEMVER_INVALID_VERSION;
+    }
+    if (version->decoded) {
+        return version->tail_error;
+    }
+
+    SemVersion tmp;
+    memset(tmp.prerelease_str, 0, sizeof(tmp.prerelease_str));
+    tmp.prerelease = PRERELEASE_NONE;
+    version->tail_error = parse_version_tail(version->str + version->tail, &tmp);
+    version->prerelease = tmp.prerelease;
+    memcpy(version->prerelease_str, tmp.prerelease_str, sizeof(tmp.prerelease_str));
+    version->decoded = 1;
+    return version->tail_error;
+}
+
+int compare_lazy_versions(LazyVersion* ver_a, LazyVersion* ver_b) {
+    if (ver_a == NULL && ver_b == NULL) {
+        return 0;
+    } else if (ver_a == NULL) {
+        return -1;
+    } else if (ver_b == NULL) {
+        return 1;
+    }
+
+    if (ver_a->major != ver_b->major) {
+        return ver_a->major > ver_b->major ? 1 : -1;
+    }
+    if (ver_a->minor != ver_b->minor) {
+        return ver_a->minor > ver_b->minor ? 1 : -1;
+    }
+    if (ver_a->patch != ver_b->patch) {
+        return ver_a->patch > ver_b->patch ? 1 : -1;
+    }
+
+    decode_lazy_version(ver_a);
+    decode_lazy_version(ver_b);
+    if (ver_a->prerelease != ver_b->prerelease) {
+        return ver_a->prerelease > ver_b->prerelease ? 1 : -1;
+    } else if (ver_a->prerelease == PRERELEASE_NONE) {
+        return 0;
+    }
+
+    return compare_prerelease_str(ver_a->prerelease, ver_a->prerelease_str, ver_b->prerelease_str);
+}
+
+int lazy_version_to_semver(const LazyVersion* version, SemVersion* semver) {
+    if (version == NULL || semver == NULL) {
+        return SEMVER_INVALID_VERSION;
+    }
+
+    memset(semver, 0, sizeof(SemVersion));
+    semver->major = version->major;
+    semver->minor = version->minor;
+    semver->patch = version->patch;
+    semver->cmp = version->cmp;
+    semver->prerelease = PRERELEASE_NONE;
+    if (version->tail < 0) {
+        return SEMVER_OK;
+    }
+    return parse_version_tail(version->str + version->tail, semver);
+}
@@ -0,0 +1,264 @@
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "semver.h"
+#include "semver_epoch.h"
+#include "semver_live.h"
+#include "semver_sorted.h"
+#include "semver_threads.h"
+
+typedef struct live_block_t {
+    int count;
+    SemVersion versions[LIVE_BLOCK_SIZE];
+} LiveBlock;
+
+struct live_snapshot_t {
+    int count;
+    int block_count;
+    /* starts[i] - the rank of the first version of blocks[i] */
+    int* starts;
+    LiveBlock** blocks;
+};
+
+/* A live reader is the reader of the epoch domain of the index */
+struct live_index_t {
+    EpochDomain domain;
+    atomic_int count;
+    SemverMutex lock;
+};
+
+/* Allocates a snapshot with its arrays in one block of memory */
+static LiveSnapshot* alloc_snapshot(int block_count) {
+    LiveSnapshot* snapshot = malloc(sizeof(LiveSnapshot) + block_count * (sizeof(LiveBlock*) + sizeof(int)));
+    if (snapshot == NULL) {
+        return NULL;
+    }
+    snapshot->block_count = block_count;
+    snapshot->blocks = (LiveBlock**)(snapshot + 1);
+    snapshot->starts = (int*)(snapshot->blocks + block_count);
+    return snapshot;
+}
+
+LiveIndex* create_live_index() {
+    LiveIndex* index = calloc(1, sizeof(LiveIndex));
+    LiveSnapshot* snapshot = alloc_snapshot(0);
+    if (index == NULL || snapshot == NULL) {
+        free(index);
+        free(snapshot);
+        return NULL;
+    }
+
+    snapshot->count = 0;
+    init_epoch_domain(&index->domain, snapshot);
+    atomic_init(&index->count, 0);
+    semver_mutex_init(&index->lock);
+    return index;
+}
+
+void free_live_index(LiveIndex** index) {
+    if (index == NULL || *index == NULL) {
+        return;
+    }
+
+    LiveIndex* idx = *index;
+    LiveSnapshot* snapshot = epoch_current(&idx->domain);
+    for (int i = 0; i < snapshot->block_count; i++) {
+        free(snapshot->blocks[i]);
+    }
+    free(snapshot);
+    free_epoch_domain(&idx->domain);
+
+    semver_mutex_destroy(&idx->lock);
+    free(idx);
+    *index = NULL;
+}
+
+/* Returns the last block whose first version is not greater than ver,
+ * or 0 */
+static int find_block(const LiveSnapshot* snapshot, const SemVersion* ver) {
+    int lo = 0, hi = snapshot->block_count;
+    while (hi - lo > 1) {
+        int mid = lo + (hi - lo) / 2;
+        if (compare_versions(&snapshot->blocks[mid]->versions[0], ver) <= 0) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+/* Copies versions of block [from, to) to a new block and inserts ver at
+ * pos (relative to from, -1 - ver is not inserted) */
+static LiveBlock* copy_block(const LiveBlock* block, int from, int to, int pos, const SemVersion* ver) {
+    LiveBlock* copy = malloc(sizeof(LiveBlock));
+    if (copy == NULL) {
+        return NULL;
+    }
+
+    int count = to - from;
+    if (pos < 0) {
+        memcpy(copy->versions, block->versions + from, count * sizeof(SemVersion));
+    } else {
+        memcpy(copy->versions, block->versions + from, pos * sizeof(SemVersion));
+        copy->versions[pos] = *ver;
+        copy->versions[pos].cmp = COMPARE_NONE;
+        memcpy(copy->versions + pos + 1, block->versions + from + pos, (count - pos) * sizeof(SemVersion));
+        count++;
+    }
+    copy->count = count;
+    return copy;
+}
+
+static int insert_locked(LiveIndex* index, const SemVersion* ver, int* added) {
+    LiveSnapshot* old = epoch_current(&index->domain);
+    static const LiveBlock empty = { 0 };
+    int b = find_block(old, ver);
+    const LiveBlock* block = old->block_count > 0 ? old->blocks[b] : &empty;
+
+    /* the position after all versions that are not greater than ver */
+    int lo = 0, hi = block->count;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (compare_versions(&block->versions[mid], ver) <= 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (lo > 0 && compare_versions(&block->versions[lo - 1], ver) == 0) {
+        return SEMVER_OK;
+    }
+
+    LiveBlock* parts[2] = { NULL, NULL };
+    int part_count = 1;
+    if (block->count < LIVE_BLOCK_SIZE) {
+        parts[0] = copy_block(block, 0, block->count, lo, ver);
+    } else {
+        int half = LIVE_BLOCK_SIZE / 2;
+        part_count = 2;
+        parts[0] = copy_block(block, 0, half, lo <= half ? lo : -1, ver);
+        parts[1] = copy_block(block, half, block->count, lo > half ? lo - half : -1, ver);
+    }
+
+    int replaced = old->block_count > 0;
+    LiveSnapshot* snapshot = alloc_snapshot(old->block_count - replaced + part_count);
+    /* the old snapshot and block are retired after the new snapshot is
+     * published, so the records are allocated before */
+    if (parts[0] == NULL || (part_count == 2 && parts[1] == NULL) || snapshot == NULL ||
+            ! epoch_reserve(&index->domain, 1 + replaced)) {
+        free(parts[0]);
+        free(parts[1]);
+        free(snapshot);
+        return SEMVER_OUT_OF_MEMORY;
+    }
+
+    /* blocks before and after the changed one are shared with the old snapshot */
+    int tail = old->block_count - b - replaced;
+    memcpy(snapshot->blocks, old->blocks, b * sizeof(LiveBlock*));
+    memcpy(snapshot->starts, old->starts, b * sizeof(int));
+    memcpy(snapshot->blocks + b, parts, part_count * sizeof(LiveBlock*));
+    memcpy(snapshot->blocks + b + part_count, old->blocks + b + replaced, tail * sizeof(LiveBlock*));
+    for (int i = b; i < snapshot->block_count; i++) {
+        snapshot->starts[i] = i == 0 ? 0 : snapshot->starts[i - 1] + snapshot->blocks[i - 1]->count;
+    }
+    snapshot->count = old->count + 1;
+
+    epoch_publish(&index->domain, snapshot);
+    atomic_store_explicit(&index->count, snapshot->count, memory_order_relaxed);
+
+    epoch_retire(&index->domain, old, free);
+    if (replaced) {
+        epoch_retire(&index->domain, old->blocks[b], free);
+    }
+    epoch_advance(&index->domain);
+
+    if (added != NULL) {
+        *added = 1;
+    }
+    return SEMVER_OK;
+}
+
+int live_index_insert(LiveIndex* index, const SemVersion* ver, int* added) {
+    if (added != NULL) {
+        *added = 0;
+    }
+    if (index == NULL || ver == NULL) {
+        return SEMVER_INVALID_VERSION;
+    }
+
+    semver_mutex_lock(&index->lock);
+    int res = insert_locked(index, ver, added);
+    semver_mutex_unlock(&index->lock);
+    return res;
+}
+
+int live_index_count(LiveIndex* index) {
+    return index == NULL ? 0 : atomic_load_explicit(&index->count, memory_order_relaxed);
+}
+
+LiveReader* open_live_reader(LiveIndex* index) {
+    return index == NULL ? NULL : (LiveReader*)open_epoch_reader(&index->domain);
+}
+
+void close_live_reader(LiveReader** reader) {
+    if (reader == NULL || *reader == NULL) {
+        return;
+    }
+
+    close_epoch_reader((EpochReader*)*reader);
+    *reader = NULL;
+}
+
+const LiveSnapshot* live_reader_enter(LiveReader* reader) {
+    return reader == NULL ? NULL : epoch_enter((EpochReader*)reader);
+}
+
+void live_reader_exit(LiveReader* reader) {
+    if (reader != NULL) {
+        epoch_exit((EpochReader*)reader);
+    }
+}
+
+int live_snapshot_count(const LiveSnapshot* snapshot) {
+    return snapshot == NULL ? 0 : snapshot->count;
+}
+
+static const SemVersion* snapshot_at(const LiveSnapshot* snapshot, int idx) {
+    int lo = 0, hi = snapshot->block_count;
+    while (hi - lo > 1) {
+        int mid = lo + (hi - lo) / 2;
+        if (snapshot->starts[mid] <= idx) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    return &snapshot->blocks[lo]->versions[idx - snapshot->starts[lo]];
+}
+
+int live_snapshot_get(const LiveSnapshot* snapshot, int idx, SemVersion* version) {
+    if (snapshot == NULL || version == NULL || idx < 0 || idx >= snapshot->count) {
+        return SEMVER_INVALID_VERSION;
+    }
+
+    *version = *snapshot_at(snapshot, idx);
+    return SEMVER_OK;
+}
+
+static int compare_at(const void* array, int idx, const SemVersion* version) {
+    return compare_versions(snapshot_at(array, idx), version);
+}
+
+int live_snapshot_max_satisfying(const LiveSnapshot* snapshot, const char* version_list, SemVersion* version) {
+    if (snapshot == NULL || version_list == NULL) {
+        return -1;
+    }
+
+    int best = sorted_max_satisfying(snapshot, snapshot->count, compare_at, version_list);
+    if (best >= 0 && version != NULL) {
+        *version = *snapshot_at(snapshot, best);
+    }
+    return best;
+}
@@ -0,0 +1,27 @@
+/* Parts of parse_version and compare_versions shared by the library
+ * sources that work with version strings directly.
+ */
+#ifndef SEMVER_PARSE_20261019
+#define SEMVER_PARSE_20261019
+
+#include "semver.h"
+
+/* Reads the compare operator and the version numbers of str into version
+ * (it can be NULL) and sets res to SEMVER_OK or to the parse_version
+ * error. On success returns the pointer to the rest of str: '\0' or the
+ * '-' or '+' that starts the prerelease and build tail
+ */
+const char* parse_version_numbers(const char* str, SemVersion* version, int* res);
+
+/* Reads the tail returned by parse_version_numbers into the prerelease
+ * and build fields of version (it can be NULL). Returns SEMVER_OK or the
+ * parse_version error
+ */
+int parse_version_tail(const char* str, SemVersion* version);
+
+/* Compares prerelease strings of the same prerelease type the way
+ * compare_versions does
+ */
+int compare_prerelease_str(Prerelease type, const char* pre_a, const char* pre_b);
+
+#endif
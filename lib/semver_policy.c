@@ -0,0 +1,491 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "semver.h"
+#include "semver_blob.h"
+#include "semver_epoch.h"
+#include "semver_policy.h"
+#include "semver_threads.h"
+
+#define INITIAL_CAPACITY 16
+#define READ_CHUNK 4096
+
+typedef struct policy_rule_t {
+    int deny;
+    /* the compiled list in the data of the snapshot */
+    size_t offset;
+    size_t size;
+} PolicyRule;
+
+typedef struct policy_package_t {
+    size_t name;
+    int first;
+    int count;
+} PolicyPackage;
+
+struct policy_snapshot_t {
+    unsigned long long generation;
+    int package_count;
+    PolicyPackage* packages;
+    /* the package '*' or -1 */
+    int any;
+    /* package index + 1, 0 - empty slot */
+    int* slots;
+    unsigned int mask;
+    PolicyRule* rules;
+    /* package names and compiled lists */
+    unsigned char* data;
+};
+
+/* A policy reader is the reader of the epoch domain of the set */
+struct policy_set_t {
+    EpochDomain domain;
+    unsigned long long generation;
+    SemverMutex lock;
+};
+
+/* A rule while the policy is parsed: the package name points to the text */
+typedef struct parsed_rule_t {
+    const char* package;
+    size_t package_len;
+    int deny;
+    int line;
+    size_t offset;
+    size_t size;
+} ParsedRule;
+
+typedef struct policy_builder_t {
+    ParsedRule* rules;
+    int count;
+    int capacity;
+    unsigned char* data;
+    size_t used;
+    size_t data_capacity;
+} PolicyBuilder;
+
+static void free_policy_snapshot(void* ptr) {
+    PolicySnapshot* snapshot = ptr;
+    free(snapshot->packages);
+    free(snapshot->slots);
+    free(snapshot->rules);
+    free(snapshot->data);
+    free(snapshot);
+}
+
+static unsigned int name_hash(const char* name, size_t len) {
+    unsigned int hash = 2166136261u;
+    for (size_t i = 0; i < len; i++) {
+        hash ^= (unsigned char)name[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/* Returns the offset of size bytes added to the data, or (size_t)-1 if
+ * there is no memory */
+static size_t reserve_data(PolicyBuilder* b, size_t size) {
+    if (b->used + size > b->data_capacity) {
+        size_t capacity = b->data_capacity == 0 ? READ_CHUNK : b->data_capacity;
+        while (capacity < b->used + size) {
+            capacity *= 2;
+        }
+        unsigned char* data = realloc(b->data, capacity);
+        if (data == NULL) {
+            return (size_t)-1;
+        }
+        b->data = data;
+        b->data_capacity = capacity;
+    }
+    size_t offset = b->used;
+    b->used += size;
+    return offset;
+}
+
+static int is_blank(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+/* Parses one line of len characters (without the line end) */
+static int parse_rule(PolicyBuilder* b, const char* line, size_t len, int number) {
+    const char* end = line + len;
+    while (line < end && is_blank(*line)) {
+        line++;
+    }
+    while (end > line && is_blank(end[-1])) {
+        end--;
+    }
+    if (line == end || *line == '#') {
+        return SEMVER_OK;
+    }
+
+    const char* package = line;
+    while (line < end && ! is_blank(*line)) {
+        line++;
+    }
+    size_t package_len = line - package;
+    while (line < end && is_blank(*line)) {
+        line++;
+    }
+    const char* keyword = line;
+    while (line < end && ! is_blank(*line)) {
+        line++;
+    }
+    size_t keyword_len = line - keyword;
+    while (line < end && is_blank(*line)) {
+        line++;
+    }
+
+    int deny;
+    if (keyword_len == 4 && memcmp(keyword, "deny", 4) == 0) {
+        deny = 1;
+    } else if (keyword_len == 5 && memcmp(keyword, "allow", 5) == 0) {
+        deny = 0;
+    } else {
+        return SEMVER_INVALID_VERSION_LIST;
+    }
+    if (line == end) {
+        return SEMVER_INVALID_VERSION_LIST;
+    }
+
+    char* list = malloc(end - line + 1);
+    if (list == NULL) {
+        return SEMVER_OUT_OF_MEMORY;
+    }
+    memcpy(list, line, end - line);
+    list[end - line] = '\0';
+
+    size_t size = 0;
+    int res = compile_version_list(list, NULL, 0, &size);
+    size_t offset = 0;
+    if (res == SEMVER_BUFFER_TOO_SMALL) {
+        offset = reserve_data(b, size);
+        res = offset == (size_t)-1 ? SEMVER_OUT_OF_MEMORY : compile_version_list(list, b->data + offset, size, &size);
+    }
+    free(list);
+    if (res != SEMVER_OK) {
+        return res;
+    }
+
+    if (b->count == b->capacity) {
+        int capacity = b->capacity == 0 ? INITIAL_CAPACITY : b->capacity * 2;
+        ParsedRule* rules = realloc(b->rules, capacity * sizeof(ParsedRule));
+        if (rules == NULL) {
+            return SEMVER_OUT_OF_MEMORY;
+        }
+        b->rules = rules;
+        b->capacity = capacity;
+    }
+    ParsedRule* rule = &b->rules[b->count++];
+    rule->package = package;
+    rule->package_len = package_len;
+    rule->deny = deny;
+    rule->line = number;
+    rule->offset = offset;
+    rule->size = size;
+    return SEMVER_OK;
+}
+
+static int compare_packages(const ParsedRule* ra, const ParsedRule* rb) {
+    size_t len = ra->package_len < rb->package_len ? ra->package_len : rb->package_len;
+    int res = memcmp(ra->package, rb->package, len);
+    if (res != 0 || ra->package_len == rb->package_len) {
+        return res;
+    }
+    return ra->package_len < rb->package_len ? -1 : 1;
+}
+
+/* Rules of a package go together, deny rules first */
+static int compare_rules(const void* a, const void* b) {
+    const ParsedRule* ra = a;
+    const ParsedRule* rb = b;
+    int res = compare_packages(ra, rb);
+    if (res != 0) {
+        return res;
+    }
+    if (ra->deny != rb->deny) {
+        return rb->deny - ra->deny;
+    }
+    return ra->line - rb->line;
+}
+
+static const PolicyPackage* find_package(const PolicySnapshot* snapshot, const char* name, size_t len) {
+    unsigned int slot = name_hash(name, len) & snapshot->mask;
+    while (snapshot->slots[slot] != 0) {
+        const PolicyPackage* pkg = &snapshot->packages[snapshot->slots[slot] - 1];
+        const char* pkg_name = (const char*)snapshot->data + pkg->name;
+        if (strncmp(pkg_name, name, len) == 0 && pkg_name[len] == '\0') {
+            return pkg;
+        }
+        slot = (slot + 1) & snapshot->mask;
+    }
+    return NULL;
+}
+
+/* Builds a snapshot from the parsed rules, the data of the builder is
+ * moved to the snapshot */
+static PolicySnapshot* build_snapshot(PolicyBuilder* b) {
+    if (b->count > 1) {
+        qsort(b->rules, b->count, sizeof(ParsedRule), compare_rules);
+    }
+
+    int package_count = 0;
+    for (int i = 0; i < b->count; i++) {
+        package_count += i == 0 || compare_packages(&b->rules[i - 1], &b->rules[i]) != 0;
+    }
+    unsigned int slot_count = 1;
+    while (slot_count < 2 * (unsigned int)package_count) {
+        slot_count *= 2;
+    }
+
+    PolicySnapshot* snapshot = calloc(1, sizeof(PolicySnapshot));
+    if (snapshot == NULL) {
+        return NULL;
+    }
+    snapshot->packages = malloc((package_count > 0 ? package_count : 1) * sizeof(PolicyPackage));
+    snapshot->slots = calloc(slot_count, sizeof(int));
+    snapshot->rules = malloc((b->count > 0 ? b->count : 1) * sizeof(PolicyRule));
+    if (snapshot->packages == NULL || snapshot->slots == NULL || snapshot->rules == NULL) {
+        free_policy_snapshot(snapshot);
+        return NULL;
+    }
+    snapshot->mask = slot_count - 1;
+    snapshot->any = -1;
+
+    for (int i = 0; i < b->count; i++) {
+        const ParsedRule* rule = &b->rules[i];
+        if (i == 0 || compare_packages(&b->rules[i - 1], rule) != 0) {
+            size_t name = reserve_data(b, rule->package_len + 1);
+            if (name == (size_t)-1) {
+                free_policy_snapshot(snapshot);
+                return NULL;
+            }
+            memcpy(b->data + name, rule->package, rule->package_len);
+            b->data[name + rule->package_len] = '\0';
+
+            PolicyPackage* pkg = &snapshot->packages[snapshot->package_count++];
+            pkg->name = name;
+            pkg->first = i;
+            pkg->count = 0;
+            if (rule->package_len == 1 && rule->package[0] == '*') {
+                snapshot->any = snapshot->package_count - 1;
+            }
+        }
+        snapshot->packages[snapshot->package_count - 1].count++;
+        snapshot->rules[i].deny = rule->deny;
+        snapshot->rules[i].offset = rule->offset;
+        snapshot->rules[i].size = rule->size;
+    }
+
+    snapshot->data = b->data;
+    b->data = NULL;
+    for (int i = 0; i < snapshot->package_count; i++) {
+        const char* name = (const char*)snapshot->data + snapshot->packages[i].name;
+        unsigned int slot = name_hash(name, strlen(name)) & snapshot->mask;
+        while (snapshot->slots[slot] != 0) {
+            slot = (slot + 1) & snapshot->mask;
+        }
+        snapshot->slots[slot] = i + 1;
+    }
+    return snapshot;
+}
+
+static PolicySnapshot* compile_policy(const char* policy, size_t len, int* error, int* error_line) {
+    PolicyBuilder b = { 0 };
+    int res = SEMVER_OK;
+    int number = 1;
+    size_t start = 0;
+    for (size_t i = 0; i <= len && res == SEMVER_OK; i++) {
+        if (i == len || policy[i] == '\n') {
+            res = parse_rule(&b, policy + start, i - start, number);
+            if (res != SEMVER_OK) {
+                *error_line = number;
+            }
+            number++;
+            start = i + 1;
+        }
+    }
+
+    PolicySnapshot* snapshot = NULL;
+    if (res == SEMVER_OK) {
+        snapshot = build_snapshot(&b);
+        if (snapshot == NULL) {
+            res = SEMVER_OUT_OF_MEMORY;
+        }
+    }
+    free(b.rules);
+    free(b.data);
+    *error = res;
+    return snapshot;
+}
+
+PolicySet* create_policy_set() {
+    PolicySet* set = calloc(1, sizeof(PolicySet));
+    int error, line;
+    PolicySnapshot* snapshot = compile_policy("", 0, &error, &line);
+    if (set == NULL || snapshot == NULL) {
+        free(set);
+        if (snapshot != NULL) {
+            free_policy_snapshot(snapshot);
+        }
+        return NULL;
+    }
+
+    init_epoch_domain(&set->domain, snapshot);
+    semver_mutex_init(&set->lock);
+    return set;
+}
+
+void free_policy_set(PolicySet** set) {
+    if (set == NULL || *set == NULL) {
+        return;
+    }
+
+    PolicySet* s = *set;
+    free_policy_snapshot(epoch_current(&s->domain));
+    free_epoch_domain(&s->domain);
+    semver_mutex_destroy(&s->lock);
+    free(s);
+    *set = NULL;
+}
+
+int reload_policy_set(PolicySet* set, const char* policy, size_t len, int* error_line) {
+    int line = 0;
+    if (error_line != NULL) {
+        *error_line = 0;
+    }
+    if (set == NULL || policy == NULL) {
+        return SEMVER_INVALID_HANDLE;
+    }
+
+    /* the policy is compiled before the lock: reloads wait only for the
+     * swap, and checks do not wait at all */
+    int res;
+    PolicySnapshot* snapshot = compile_policy(policy, len, &res, &line);
+    if (snapshot == NULL) {
+        if (error_line != NULL) {
+            *error_line = line;
+        }
+        return res;
+    }
+
+    semver_mutex_lock(&set->lock);
+    if (! epoch_reserve(&set->domain, 1)) {
+        semver_mutex_unlock(&set->lock);
+        free_policy_snapshot(snapshot);
+        return SEMVER_OUT_OF_MEMORY;
+    }
+    snapshot->generation = ++set->generation;
+    PolicySnapshot* old = epoch_current(&set->domain);
+    epoch_publish(&set->domain, snapshot);
+    epoch_retire(&set->domain, old, free_policy_snapshot);
+    epoch_advance(&set->domain);
+    semver_mutex_unlock(&set->lock);
+    return SEMVER_OK;
+}
+
+int load_policy_file(PolicySet* set, const char* path, int* error_line) {
+    if (error_line != NULL) {
+        *error_line = 0;
+    }
+    if (path == NULL) {
+        return SEMVER_IO_ERROR;
+    }
+
+    FILE* f = fopen(path, "rb");
+    if (f == NULL) {
+        return SEMVER_IO_ERROR;
+    }
+
+    char* text = NULL;
+    size_t len = 0, capacity = 0;
+    int res = SEMVER_OK;
+    for (;;) {
+        if (len + READ_CHUNK > capacity) {
+            capacity = capacity == 0 ? READ_CHUNK * 4 : capacity * 2;
+            char* p = realloc(text, capacity);
+            if (p == NULL) {
+                res = SEMVER_OUT_OF_MEMORY;
+                break;
+            }
+            text = p;
+        }
+        size_t n = fread(text + len, 1, READ_CHUNK, f);
+        len += n;
+        if (n < READ_CHUNK) {
+            if (ferror(f)) {
+                res = SEMVER_IO_ERROR;
+            }
+            break;
+        }
+    }
+    fclose(f);
+
+    if (res == SEMVER_OK) {
+        res = reload_policy_set(set, text, len, error_line);
+    }
+    free(text);
+    return res;
+}
+
+PolicyReader* open_policy_reader(PolicySet* set) {
+    return set == NULL ? NULL : (PolicyReader*)open_epoch_reader(&set->domain);
+}
+
+void close_policy_reader(PolicyReader** reader) {
+    if (reader == NULL || *reader == NULL) {
+        return;
+    }
+
+    close_epoch_reader((EpochReader*)*reader);
+    *reader = NULL;
+}
+
+const PolicySnapshot* policy_reader_enter(PolicyReader* reader) {
+    return reader == NULL ? NULL : epoch_enter((EpochReader*)reader);
+}
+
+void policy_reader_exit(PolicyReader* reader) {
+    if (reader != NULL) {
+        epoch_exit((EpochReader*)reader);
+    }
+}
+
+unsigned long long policy_snapshot_generation(const PolicySnapshot* snapshot) {
+    return snapshot == NULL ? 0 : snapshot->generation;
+}
+
+/* Returns 1 if a deny rule of the package matches. Allow rules are
+ * checked only until one of them matches */
+static int check_package(const PolicySnapshot* snapshot, const PolicyPackage* pkg, const SemVersion* ver,
+        int* allows, int* allowed) {
+    const PolicyRule* rule = snapshot->rules + pkg->first;
+    const PolicyRule* end = rule + pkg->count;
+    for (; rule < end && rule->deny; rule++) {
+        if (check_version_blob(ver, snapshot->data + rule->offset, rule->size) == SEMVER_OK) {
+            return 1;
+        }
+    }
+    *allows += end - rule;
+    for (; rule < end && ! *allowed; rule++) {
+        *allowed = check_version_blob(ver, snapshot->data + rule->offset, rule->size) == SEMVER_OK;
+    }
+    return 0;
+}
+
+int check_policy(const PolicySnapshot* snapshot, const char* package, const SemVersion* ver) {
+    if (snapshot == NULL || package == NULL || ver == NULL) {
+        return SEMVER_INVALID_VERSION;
+    }
+
+    int allows = 0, allowed = 0;
+    if (snapshot->any >= 0 && check_package(snapshot, &snapshot->packages[snapshot->any], ver, &allows, &allowed)) {
+        return SEMVER_OUT_OF_RANGE;
+    }
+    const PolicyPackage* pkg = find_package(snapshot, package, strlen(package));
+    if (pkg != NULL && pkg - snapshot->packages != snapshot->any &&
+            check_package(snapshot, pkg, ver, &allows, &allowed)) {
+        return SEMVER_OUT_OF_RANGE;
+    }
+    return allows == 0 || allowed ? SEMVER_OK : SEMVER_OUT_OF_RANGE;
+}
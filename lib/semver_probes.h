@@ -0,0 +1,58 @@
+/* USDT probes (provider "semver") for perf, bpftrace, and systemtap.
+ *
+ * Probes are built only on Linux if SEMVER_USDT is defined, they need
+ * sys/sdt.h (systemtap-sdt-dev or systemtap-sdt-devel package). A probe is
+ * a single nop in the code; its arguments are computed only while a tracer
+ * is attached to it (the probe semaphore is not zero). Without SEMVER_USDT
+ * the macros do not add any code.
+ *
+ * Probe                          Arguments
+ * parse_version_entry            str, strlen(str)
+ * parse_version_return           strlen(str), result
+ * compare_versions_entry         ver_a, ver_b
+ * compare_versions_return        result
+ * check_version_entry            version_list, strlen(version_list)
+ * check_version_return           strlen(version_list), result, terms, ranges
+ * add_version_entry              version cmp, as_new
+ * add_version_return             added (1 or 0), range_size(range)
+ * complete_version_range_entry   version cmp
+ * complete_version_range_return  result
+ */
+#ifndef SEMVER_PROBES_20261019
+#define SEMVER_PROBES_20261019
+
+#include <string.h>
+
+#if defined(SEMVER_USDT) && defined(__linux__)
+
+#define _SDT_HAS_SEMAPHORES 1
+#include <sys/sdt.h>
+
+/* Defines the semaphore of a probe, every probe must be defined once in
+ * the file that fires it
+ */
+#define DEFINE_PROBE(name) \
+    __extension__ unsigned short semver_##name##_semaphore __attribute__((unused)) __attribute__((section(".probes")))
+#define PROBE_ENABLED(name) __builtin_expect(semver_##name##_semaphore != 0, 0)
+#define PROBE1(name, a) DTRACE_PROBE1(semver, name, a)
+#define PROBE2(name, a, b) DTRACE_PROBE2(semver, name, a, b)
+#define PROBE4(name, a, b, c, d) DTRACE_PROBE4(semver, name, a, b, c, d)
+
+#else
+
+#define DEFINE_PROBE(name) extern int semver_probes_disabled
+#define PROBE_ENABLED(name) 0
+#define PROBE1(name, a) ((void)0)
+#define PROBE2(name, a, b) ((void)0)
+#define PROBE4(name, a, b, c, d) ((void)0)
+
+#endif
+
+#define PROBE_STRLEN(str) ((str) == NULL ? 0 : strlen(str))
+
+/* Fires the probe with arguments if a tracer is attached to it */
+#define FIRE_PROBE1(name, a) do { if (PROBE_ENABLED(name)) { PROBE1(name, a); } } while (0)
+#define FIRE_PROBE2(name, a, b) do { if (PROBE_ENABLED(name)) { PROBE2(name, a, b); } } while (0)
+#define FIRE_PROBE4(name, a, b, c, d) do { if (PROBE_ENABLED(name)) { PROBE4(name, a, b, c, d); } } while (0)
+
+#endif
@@ -0,0 +1,168 @@
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "semver.h"
+#include "semver_search.h"
+
+/* Bits of every version number in a key */
+#define NUMBER_BITS 20
+#define NUMBER_MAX ((1u << NUMBER_BITS) - 1)
+/* The key does not describe the version completely: equal keys must be
+ * compared with compare_versions */
+#define KEY_TIE 1ull
+/* The keys of the nodes 4 levels down are 16 keys from 16 * k */
+#define PREFETCH_STRIDE 16
+
+struct version_search_t {
+    /* count + 1 keys in Eytzinger order, keys[0] is not used */
+    uint64_t* keys;
+    /* ranks[k] - the index of keys[k] version in the sorted array */
+    int* ranks;
+    const SemVersion* versions;
+    int count;
+};
+
+/* Packs major, minor, patch, and prerelease type from the highest bits
+ * to the lowest ones. A saturated number sets all bits of its field and
+ * all lower bits */
+static uint64_t pack_key(const SemVersion* ver) {
+    unsigned int numbers[PART_COUNT] = { ver->major, ver->minor, ver->patch };
+    uint64_t key = 0;
+    int shift = 64;
+
+    for (int i = 0; i < PART_COUNT; i++) {
+        shift -= NUMBER_BITS;
+        if (numbers[i] >= NUMBER_MAX) {
+            return key | (~(uint64_t)0 >> (64 - shift - NUMBER_BITS));
+        }
+        key |= (uint64_t)numbers[i] << shift;
+    }
+
+    key |= (uint64_t)ver->prerelease << 1;
+    if (ver->prerelease != PRERELEASE_NONE) {
+        key |= KEY_TIE;
+    }
+    return key;
+}
+
+/* Fills the subtree of node k with versions starting from rank, returns
+ * the rank of the next version */
+static int fill_subtree(VersionSearch* search, int rank, size_t k) {
+    if (k > (size_t)search->count) {
+        return rank;
+    }
+    rank = fill_subtree(search, rank, 2 * k);
+    search->keys[k] = pack_key(&search->versions[rank]);
+    search->ranks[k] = rank;
+    return fill_subtree(search, rank + 1, 2 * k + 1);
+}
+
+VersionSearch* build_version_search(const SemVersion* sorted, int count, int* error) {
+    int res = SEMVER_OK;
+    VersionSearch* search = NULL;
+
+    if (count < 0 || (sorted == NULL && count != 0)) {
+        res = SEMVER_INVALID_VERSION;
+    }
+    for (int i = 1; i < count && res == SEMVER_OK; i++) {
+        if (compare_versions(&sorted[i - 1], &sorted[i]) > 0) {
+            res = SEMVER_INVALID_VERSION;
+        }
+    }
+
+    if (res == SEMVER_OK) {
+        search = calloc(1, sizeof(VersionSearch));
+        if (search != NULL) {
+            search->keys = malloc((count + 1) * sizeof(uint64_t));
+            search->ranks = malloc((count + 1) * sizeof(int));
+        }
+        if (search == NULL || search->keys == NULL || search->ranks == NULL) {
+            free_version_search(&search);
+            res = SEMVER_OUT_OF_MEMORY;
+        }
+    }
+
+    if (search != NULL) {
+        search->versions = sorted;
+        search->count = count;
+        search->keys[0] = 0;
+        search->ranks[0] = count;
+        fill_subtree(search, 0, 1);
+    }
+
+    if (error != NULL) {
+        *error = res;
+    }
+    return search;
+}
+
+void free_version_search(VersionSearch** search) {
+    if (search == NULL || *search == NULL) {
+        return;
+    }
+
+    free((*search)->keys);
+    free((*search)->ranks);
+    free(*search);
+    *search = NULL;
+}
+
+/* Drops the right turns made after the last left one, and the left one */
+static unsigned long long drop_right_turns(unsigned long long k) {
+#ifdef __GNUC__
+    return k >> __builtin_ffsll(~k);
+#else
+    while (k & 1) {
+        k >>= 1;
+    }
+    return k >> 1;
+#endif
+}
+
+/* Descends the tree: goes right while the node is less than ver (or not
+ * greater than ver if upper is set). The answer is the last node where
+ * the search went left */
+static int search_bound(const VersionSearch* search, const SemVersion* ver, int upper) {
+    if (search == NULL || ver == NULL) {
+        return 0;
+    }
+
+    const uint64_t* keys = search->keys;
+    uint64_t key = pack_key(ver);
+    size_t count = search->count;
+    unsigned long long k = 1;
+
+    while (k <= count) {
+#ifdef __GNUC__
+        __builtin_prefetch(keys + k * PREFETCH_STRIDE);
+#endif
+        uint64_t node = keys[k];
+        int right;
+        if (node != key || (key & KEY_TIE) == 0) {
+            right = upper ? node <= key : node < key;
+        } else {
+            int cmp = compare_versions(&search->versions[search->ranks[k]], ver);
+            right = upper ? cmp <= 0 : cmp < 0;
+        }
+        k = 2 * k + right;
+    }
+
+    return search->ranks[drop_right_turns(k)];
+}
+
+int version_search_lower_bound(const VersionSearch* search, const SemVersion* ver) {
+    return search_bound(search, ver, 0);
+}
+
+int version_search_upper_bound(const VersionSearch* search, const SemVersion* ver) {
+    return search_bound(search, ver, 1);
+}
+
+int version_search_contains(const VersionSearch* search, const SemVersion* ver, int* rank) {
+    int found = search_bound(search, ver, 0);
+    if (rank != NULL) {
+        *rank = found;
+    }
+    return search != NULL && ver != NULL && found < search->count &&
+        compare_versions(&search->versions[found], ver) == 0;
+}
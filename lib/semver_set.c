@@ -0,0 +1,148 @@
+#include <string.h>
+
+#include "semver.h"
+#include "semver_set.h"
+
+/* After this number of versions in a row are taken from one array, the
+ * rest of its run is found with galloping search
+ */
+#define MIN_GALLOP 7
+
+/* which versions go to the result */
+#define EMIT_ONLY_A 1
+#define EMIT_ONLY_B 2
+#define EMIT_BOTH 4
+
+typedef struct set_output_t {
+    SemVersion* out;
+    int max_out;
+    int count;
+} SetOutput;
+
+int compare_set_versions(const SemVersion* ver_a, const SemVersion* ver_b, int flags) {
+    int res = compare_versions(ver_a, ver_b);
+    if (res != 0) {
+        return res < 0 ? -1 : 1;
+    }
+    if ((flags & VERSION_SET_COMPARE_BUILD) == 0 || ver_a == NULL || ver_b == NULL) {
+        return 0;
+    }
+
+    res = strncmp(ver_a->build_str, ver_b->build_str, MAX_BUILD_LEN);
+    return res < 0 ? -1 : (res > 0 ? 1 : 0);
+}
+
+static void emit(SetOutput* output, const SemVersion* versions, int count) {
+    int room = output->max_out - output->count;
+    if (room > 0 && output->out != NULL) {
+        memcpy(output->out + output->count, versions, (count < room ? count : room) * sizeof(SemVersion));
+    }
+    output->count += count;
+}
+
+/* Returns the index of the first version in [from, count) that is not less
+ * than key. versions[from] must be less than key. Steps grow twice on every
+ * probe and then the last step is searched with binary search
+ */
+static int gallop(const SemVersion* versions, int from, int count, const SemVersion* key, int flags) {
+    int less = from;
+    int step = 1;
+    while (less + step < count && compare_set_versions(&versions[less + step], key, flags) < 0) {
+        less += step;
+        step *= 2;
+    }
+
+    /* versions[less] < key, and versions[hi] >= key or hi == count */
+    int hi = less + step < count ? less + step : count;
+    while (hi - less > 1) {
+        int mid = less + (hi - less) / 2;
+        if (compare_set_versions(&versions[mid], key, flags) < 0) {
+            less = mid;
+        } else {
+            hi = mid;
+        }
+    }
+
+    return hi;
+}
+
+static int merge_sets(const SemVersion* set_a, int count_a, const SemVersion* set_b, int count_b, int flags,
+        int mode, SemVersion* out, int max_out, int* out_count) {
+    if ((set_a == NULL && count_a != 0) || (set_b == NULL && count_b != 0) || count_a < 0 || count_b < 0 ||
+            out_count == NULL) {
+        return SEMVER_INVALID_VERSION;
+    }
+
+    SetOutput output;
+    output.out = out;
+    output.max_out = out == NULL ? 0 : max_out;
+    output.count = 0;
+
+    int i = 0, j = 0;
+    int run_a = 0, run_b = 0;
+    while (i < count_a && j < count_b) {
+        int res = compare_set_versions(&set_a[i], &set_b[j], flags);
+        if (res < 0) {
+            int next = i + 1;
+            if (++run_a >= MIN_GALLOP) {
+                next = gallop(set_a, i, count_a, &set_b[j], flags);
+                run_a = 0;
+            }
+            if (mode & EMIT_ONLY_A) {
+                emit(&output, &set_a[i], next - i);
+            }
+            i = next;
+            run_b = 0;
+        } else if (res > 0) {
+            int next = j + 1;
+            if (++run_b >= MIN_GALLOP) {
+                next = gallop(set_b, j, count_b, &set_a[i], flags);
+                run_b = 0;
+            }
+            if (mode & EMIT_ONLY_B) {
+                emit(&output, &set_b[j], next - j);
+            }
+            j = next;
+            run_a = 0;
+        } else {
+            if (mode & EMIT_BOTH) {
+                emit(&output, &set_a[i], 1);
+            }
+            i++;
+            j++;
+            run_a = 0;
+            run_b = 0;
+        }
+    }
+
+    if ((mode & EMIT_ONLY_A) && i < count_a) {
+        emit(&output, &set_a[i], count_a - i);
+    }
+    if ((mode & EMIT_ONLY_B) && j < count_b) {
+        emit(&output, &set_b[j], count_b - j);
+    }
+
+    *out_count = output.count;
+    return output.count > output.max_out ? SEMVER_BUFFER_TOO_SMALL : SEMVER_OK;
+}
+
+int version_set_union(const SemVersion* set_a, int count_a, const SemVersion* set_b, int count_b, int flags,
+        SemVersion* out, int max_out, int* out_count) {
+    return merge_sets(set_a, count_a, set_b, count_b, flags, EMIT_ONLY_A | EMIT_ONLY_B | EMIT_BOTH,
+            out, max_out, out_count);
+}
+
+int version_set_intersection(const SemVersion* set_a, int count_a, const SemVersion* set_b, int count_b, int flags,
+        SemVersion* out, int max_out, int* out_count) {
+    return merge_sets(set_a, count_a, set_b, count_b, flags, EMIT_BOTH, out, max_out, out_count);
+}
+
+int version_set_difference(const SemVersion* set_a, int count_a, const SemVersion* set_b, int count_b, int flags,
+        SemVersion* out, int max_out, int* out_count) {
+    return merge_sets(set_a, count_a, set_b, count_b, flags, EMIT_ONLY_A, out, max_out, out_count);
+}
+
+int version_set_symmetric_difference(const SemVersion* set_a, int count_a, const SemVersion* set_b, int count_b,
+        int flags, SemVersion* out, int max_out, int* out_count) {
+    return merge_sets(set_a, count_a, set_b, count_b, flags, EMIT_ONLY_A | EMIT_ONLY_B, out, max_out, out_count);
+}
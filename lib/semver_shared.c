@@ -0,0 +1,394 @@
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include "semver.h"
+#include "semver_blob.h"
+#include "semver_check.h"
+#include "semver_shared.h"
+
+/* a process that opens a cache being created waits for its creator up to
+ * WAIT_ATTEMPTS milliseconds */
+#define WAIT_ATTEMPTS 1000
+#define ENTRY_HEADER_SIZE 8
+
+typedef struct cache_header_t {
+    /* stored last by the creator of the segment */
+    atomic_uint magic;
+    unsigned int format_version;
+    unsigned int slot_count;
+    unsigned int size;
+    unsigned int data_offset;
+    atomic_uint data_used;
+    atomic_uint entry_count;
+    unsigned int reserved;
+} CacheHeader;
+
+typedef struct cache_entry_t {
+    unsigned int list_len;
+    unsigned int blob_size;
+} CacheEntry;
+
+struct shared_cache_t {
+    unsigned char* data;
+    /* the mapped size, the segment size in the header is not larger */
+    size_t size;
+    CacheHeader* header;
+    atomic_ullong* slots;
+    /* the validated layout: other processes can write the header, so it
+     * is read only once when the cache is opened */
+    unsigned int slot_count;
+    unsigned int segment_size;
+    unsigned int data_offset;
+#ifdef _WIN32
+    HANDLE mapping;
+#endif
+};
+
+static unsigned int list_hash(const char* list, size_t len) {
+    unsigned int hash = 2166136261u;
+    for (size_t i = 0; i < len; i++) {
+        hash ^= (unsigned char)list[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static size_t align_up(size_t value, size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+static void sleep_briefly() {
+#ifdef _WIN32
+    Sleep(1);
+#else
+    struct timespec ts = { 0, 1000000 };
+    nanosleep(&ts, NULL);
+#endif
+}
+
+/* Maps the segment, created is set to 1 if this process created it */
+static int map_segment(const char* name, size_t size, SharedCache* cache, int* created) {
+#ifdef _WIN32
+    HANDLE mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, 0, (DWORD)size, name);
+    if (mapping == NULL) {
+        return SEMVER_IO_ERROR;
+    }
+    *created = GetLastError() != ERROR_ALREADY_EXISTS;
+    void* data = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+    MEMORY_BASIC_INFORMATION info;
+    if (data == NULL || VirtualQuery(data, &info, sizeof(info)) == 0) {
+        if (data != NULL) {
+            UnmapViewOfFile(data);
+        }
+        CloseHandle(mapping);
+        return SEMVER_IO_ERROR;
+    }
+    cache->mapping = mapping;
+    cache->data = data;
+    cache->size = *created ? size : info.RegionSize;
+#else
+    *created = 1;
+    int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd < 0 && errno == EEXIST) {
+        *created = 0;
+        fd = shm_open(name, O_RDWR, 0);
+    }
+    if (fd < 0) {
+        return SEMVER_IO_ERROR;
+    }
+
+    if (*created) {
+        if (ftruncate(fd, size) != 0) {
+            close(fd);
+            shm_unlink(name);
+            return SEMVER_IO_ERROR;
+        }
+    } else {
+        /* the creator may not have set the size yet */
+        struct stat st;
+        int attempts = 0;
+        while (fstat(fd, &st) == 0 && (size_t)st.st_size < sizeof(CacheHeader) && attempts++ < WAIT_ATTEMPTS) {
+            sleep_briefly();
+        }
+        if ((size_t)st.st_size < sizeof(CacheHeader) || (unsigned long long)st.st_size >= UINT_MAX) {
+            close(fd);
+            return SEMVER_IO_ERROR;
+        }
+        size = st.st_size;
+    }
+
+    void* data = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        if (*created) {
+            shm_unlink(name);
+        }
+        return SEMVER_IO_ERROR;
+    }
+    cache->data = data;
+    cache->size = size;
+#endif
+    return SEMVER_OK;
+}
+
+static void unmap_segment(SharedCache* cache) {
+#ifdef _WIN32
+    UnmapViewOfFile(cache->data);
+    CloseHandle(cache->mapping);
+#else
+    munmap(cache->data, cache->size);
+#endif
+}
+
+/* The slot table takes about 1/8 of the segment */
+static void init_segment(SharedCache* cache) {
+    CacheHeader* h = cache->header;
+    unsigned int slot_count = 16;
+    while (slot_count * 2 <= cache->size / 64) {
+        slot_count *= 2;
+    }
+
+    h->format_version = SHARED_CACHE_FORMAT;
+    h->slot_count = slot_count;
+    h->size = (unsigned int)cache->size;
+    h->data_offset = sizeof(CacheHeader) + slot_count * sizeof(unsigned long long);
+    atomic_store_explicit(&h->data_used, 0, memory_order_relaxed);
+    atomic_store_explicit(&h->entry_count, 0, memory_order_relaxed);
+    atomic_store_explicit(&h->magic, SHARED_CACHE_MAGIC, memory_order_release);
+}
+
+/* Checks the header and copies the layout to the cache */
+static int validate_segment(SharedCache* cache) {
+    int attempts = 0;
+    while (atomic_load_explicit(&cache->header->magic, memory_order_acquire) == 0 && attempts++ < WAIT_ATTEMPTS) {
+        sleep_briefly();
+    }
+
+    const volatile CacheHeader* h = cache->header;
+    unsigned int magic = atomic_load_explicit(&cache->header->magic, memory_order_acquire);
+    if (magic == 0) {
+        return SEMVER_IO_ERROR;
+    }
+    unsigned int format_version = h->format_version;
+    unsigned int slot_count = h->slot_count;
+    unsigned int size = h->size;
+    unsigned int data_offset = h->data_offset;
+    if (magic != SHARED_CACHE_MAGIC || format_version != SHARED_CACHE_FORMAT || size > cache->size ||
+        slot_count == 0 || (slot_count & (slot_count - 1)) != 0 ||
+        data_offset != sizeof(CacheHeader) + (unsigned long long)slot_count * sizeof(unsigned long long) ||
+        data_offset > size) {
+        return SEMVER_INVALID_BLOB;
+    }
+
+    cache->slot_count = slot_count;
+    cache->segment_size = size;
+    cache->data_offset = data_offset;
+    return SEMVER_OK;
+}
+
+int open_shared_cache(const char* name, size_t size, SharedCache** cache) {
+    if (name == NULL || cache == NULL || size < SHARED_CACHE_MIN_SIZE || size >= UINT_MAX) {
+        return SEMVER_IO_ERROR;
+    }
+    *cache = NULL;
+
+    SharedCache* c = calloc(1, sizeof(SharedCache));
+    if (c == NULL) {
+        return SEMVER_OUT_OF_MEMORY;
+    }
+
+    int created;
+    int res = map_segment(name, align_up(size, 8), c, &created);
+    if (res != SEMVER_OK) {
+        free(c);
+        return res;
+    }
+    c->header = (CacheHeader*)c->data;
+    c->slots = (atomic_ullong*)(c->data + sizeof(CacheHeader));
+
+    if (created) {
+        init_segment(c);
+    }
+    res = validate_segment(c);
+    if (res != SEMVER_OK) {
+        close_shared_cache(&c);
+        return res;
+    }
+
+    *cache = c;
+    return SEMVER_OK;
+}
+
+void close_shared_cache(SharedCache** cache) {
+    if (cache == NULL || *cache == NULL) {
+        return;
+    }
+
+    unmap_segment(*cache);
+    free(*cache);
+    *cache = NULL;
+}
+
+int remove_shared_cache(const char* name) {
+    if (name == NULL) {
+        return SEMVER_IO_ERROR;
+    }
+#ifdef _WIN32
+    return SEMVER_OK;
+#else
+    return shm_unlink(name) == 0 ? SEMVER_OK : SEMVER_IO_ERROR;
+#endif
+}
+
+/* Returns 1 and sets blob if the published word is the entry of list */
+static int match_entry(const SharedCache* cache, unsigned long long word, unsigned int hash, const char* list,
+        size_t len, const unsigned char** blob, size_t* size) {
+    if ((unsigned int)(word >> 32) != hash) {
+        return 0;
+    }
+
+    size_t offset = (unsigned int)word;
+    if (offset < cache->data_offset || offset + ENTRY_HEADER_SIZE > cache->segment_size) {
+        return 0;
+    }
+    /* the lengths are read once: the checked values are the used ones */
+    const volatile CacheEntry* entry = (const volatile CacheEntry*)(cache->data + offset);
+    size_t list_len = entry->list_len;
+    size_t blob_size = entry->blob_size;
+    size_t key_size = align_up(list_len + 1, 4);
+    const unsigned char* key = cache->data + offset + ENTRY_HEADER_SIZE;
+    if (list_len != len || offset + ENTRY_HEADER_SIZE + key_size + blob_size > cache->segment_size ||
+        memcmp(key, list, len) != 0) {
+        return 0;
+    }
+
+    *blob = key + key_size;
+    *size = blob_size;
+    return 1;
+}
+
+/* Reserves need bytes of the data area, returns the offset of the space
+ * from the segment start or 0 if the cache is full */
+static unsigned int reserve_entry(SharedCache* cache, size_t need) {
+    CacheHeader* h = cache->header;
+    size_t data_size = cache->segment_size - cache->data_offset;
+    unsigned int used = atomic_load_explicit(&h->data_used, memory_order_relaxed);
+    do {
+        if (used + need > data_size) {
+            return 0;
+        }
+    } while (! atomic_compare_exchange_weak_explicit(&h->data_used, &used, (unsigned int)(used + need),
+                memory_order_relaxed, memory_order_relaxed));
+    return cache->data_offset + used;
+}
+
+int shared_cache_get(SharedCache* cache, const char* version_list, const unsigned char** blob, size_t* size) {
+    if (cache == NULL) {
+        return SEMVER_INVALID_HANDLE;
+    }
+    if (version_list == NULL) {
+        return SEMVER_INVALID_VERSION_LIST;
+    }
+
+    const unsigned char* found_blob;
+    size_t found_size;
+    size_t len = strlen(version_list);
+    unsigned int hash = list_hash(version_list, len);
+    unsigned int mask = cache->slot_count - 1;
+    unsigned int slot = hash & mask;
+    unsigned int probes = 0;
+
+    unsigned long long word;
+    while (probes <= mask && (word = atomic_load_explicit(&cache->slots[slot], memory_order_acquire)) != 0) {
+        if (match_entry(cache, word, hash, version_list, len, &found_blob, &found_size)) {
+            *blob = found_blob;
+            *size = found_size;
+            return SEMVER_OK;
+        }
+        slot = (slot + 1) & mask;
+        probes++;
+    }
+    if (probes > mask) {
+        return SEMVER_BUFFER_TOO_SMALL;
+    }
+
+    size_t blob_size = 0;
+    int res = compile_version_list(version_list, NULL, 0, &blob_size);
+    if (res != SEMVER_BUFFER_TOO_SMALL) {
+        return res;
+    }
+    size_t key_size = align_up(len + 1, 4);
+    unsigned int offset = reserve_entry(cache, align_up(ENTRY_HEADER_SIZE + key_size + blob_size, 8));
+    if (offset == 0) {
+        return SEMVER_BUFFER_TOO_SMALL;
+    }
+
+    /* the entry is written before it is published: other processes do
+     * not see the reserved space until then */
+    CacheEntry* entry = (CacheEntry*)(cache->data + offset);
+    unsigned char* entry_blob = (unsigned char*)(entry + 1) + key_size;
+    entry->list_len = (unsigned int)len;
+    entry->blob_size = (unsigned int)blob_size;
+    memcpy(entry + 1, version_list, len + 1);
+    res = compile_version_list(version_list, entry_blob, blob_size, &blob_size);
+    if (res != SEMVER_OK) {
+        return res;
+    }
+
+    unsigned long long mine = ((unsigned long long)hash << 32) | offset;
+    for (; probes <= mask; probes++, slot = (slot + 1) & mask) {
+        word = 0;
+        if (atomic_compare_exchange_strong_explicit(&cache->slots[slot], &word, mine, memory_order_release,
+                    memory_order_acquire)) {
+            atomic_fetch_add_explicit(&cache->header->entry_count, 1, memory_order_relaxed);
+            *blob = entry_blob;
+            *size = blob_size;
+            return SEMVER_OK;
+        }
+        /* another process published the same list first */
+        if (match_entry(cache, word, hash, version_list, len, &found_blob, &found_size)) {
+            *blob = found_blob;
+            *size = found_size;
+            return SEMVER_OK;
+        }
+    }
+    return SEMVER_BUFFER_TOO_SMALL;
+}
+
+int check_version_shared(SharedCache* cache, const SemVersion* ver, const char* version_list) {
+    const unsigned char* blob;
+    size_t size;
+    int res = shared_cache_get(cache, version_list, &blob, &size);
+    if (res == SEMVER_OK) {
+        return check_version_blob(ver, blob, size);
+    }
+    return res == SEMVER_INVALID_VERSION_LIST ? res : check_version(ver, version_list);
+}
+
+void shared_cache_stats(const SharedCache* cache, SharedCacheStats* stats) {
+    if (stats == NULL) {
+        return;
+    }
+
+    memset(stats, 0, sizeof(SharedCacheStats));
+    if (cache != NULL) {
+        CacheHeader* h = cache->header;
+        stats->slot_count = cache->slot_count;
+        stats->entry_count = atomic_load_explicit(&h->entry_count, memory_order_relaxed);
+        stats->data_size = cache->segment_size - cache->data_offset;
+        stats->data_used = atomic_load_explicit(&h->data_used, memory_order_relaxed);
+    }
+}
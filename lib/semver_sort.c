@@ -0,0 +1,438 @@
+#include <string.h>
+#include <stdlib.h>
+
+#include "semver.h"
+#include "semver_sort.h"
+#include "semver_threads.h"
+
+/* Arrays smaller than this are not split between threads */
+#define MIN_PART_SIZE 8192
+/* Runs shorter than this are sorted with insertion sort */
+#define INSERTION_SORT_SIZE 24
+/* How many versions ahead are prefetched when versions are moved */
+#define GATHER_PREFETCH 16
+
+/* Numeric parts of a version and the index of the version */
+typedef struct sort_key_t {
+    unsigned int major;
+    unsigned int minor;
+    unsigned int patch;
+    int prerelease;
+    int index;
+} SortKey;
+
+/* Piece of a merge: keys of a and b that go to out */
+typedef struct merge_task_t {
+    const SortKey* a;
+    int count_a;
+    const SortKey* b;
+    int count_b;
+    SortKey* out;
+} MergeTask;
+
+typedef struct sort_context_t {
+    const SemVersion* versions;
+    int count;
+    int stable;
+    int parts;
+    SortKey* keys;
+    SortKey* buffer;
+    /* sort_versions moves versions through it */
+    SemVersion* values;
+    /* sort_version_indices reads and writes them */
+    int* indices;
+    MergeTask* tasks;
+    int task_count;
+    /* borders of sorted runs while merging */
+    int* bounds;
+} SortContext;
+
+static int compare_keys(const SemVersion* versions, const SortKey* key_a, const SortKey* key_b) {
+    if (key_a->major != key_b->major) {
+        return key_a->major > key_b->major ? 1 : -1;
+    }
+    if (key_a->minor != key_b->minor) {
+        return key_a->minor > key_b->minor ? 1 : -1;
+    }
+    if (key_a->patch != key_b->patch) {
+        return key_a->patch > key_b->patch ? 1 : -1;
+    }
+    if (key_a->prerelease != key_b->prerelease) {
+        return key_a->prerelease > key_b->prerelease ? 1 : -1;
+    }
+    if (key_a->prerelease == PRERELEASE_NONE) {
+        return 0;
+    }
+    return compare_versions(&versions[key_a->index], &versions[key_b->index]);
+}
+
+static void insertion_sort(const SemVersion* versions, SortKey* keys, int count) {
+    for (int i = 1; i < count; i++) {
+        SortKey key = keys[i];
+        int j = i;
+        while (j > 0 && compare_keys(versions, &keys[j - 1], &key) > 0) {
+            keys[j] = keys[j - 1];
+            j--;
+        }
+        keys[j] = key;
+    }
+}
+
+/* Stable merge of a and b to out */
+static void merge_runs(const SemVersion* versions, const SortKey* a, int count_a, const SortKey* b, int count_b,
+        SortKey* out) {
+    int i = 0, j = 0;
+    while (i < count_a && j < count_b) {
+        if (compare_keys(versions, &b[j], &a[i]) < 0) {
+            *out++ = b[j++];
+        } else {
+            *out++ = a[i++];
+        }
+    }
+    memcpy(out, a + i, (count_a - i) * sizeof(SortKey));
+    memcpy(out + count_a - i, b + j, (count_b - j) * sizeof(SortKey));
+}
+
+/* Bottom-up merge sort, buffer must have room for count keys */
+static void merge_sort(const SemVersion* versions, SortKey* keys, SortKey* buffer, int count) {
+    for (int i = 0; i < count; i += INSERTION_SORT_SIZE) {
+        insertion_sort(versions, keys + i, count - i < INSERTION_SORT_SIZE ? count - i : INSERTION_SORT_SIZE);
+    }
+
+    SortKey* src = keys;
+    SortKey* dst = buffer;
+    for (int width = INSERTION_SORT_SIZE; width < count; width *= 2) {
+        for (int lo = 0; lo < count; lo += 2 * width) {
+            int mid = lo + width < count ? lo + width : count;
+            int hi = lo + 2 * width < count ? lo + 2 * width : count;
+            merge_runs(versions, src + lo, mid - lo, src + mid, hi - mid, dst + lo);
+        }
+        SortKey* tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+
+    if (src != keys) {
+        memcpy(keys, src, count * sizeof(SortKey));
+    }
+}
+
+static void swap_keys(SortKey* a, SortKey* b) {
+    SortKey tmp = *a;
+    *a = *b;
+    *b = tmp;
+}
+
+/* Quick sort with median of three pivots. When recursion gets too deep
+ * the rest of the range is merge sorted, so the worst case is O(n log n)
+ */
+static void quick_sort(const SemVersion* versions, SortKey* keys, SortKey* buffer, int count, int depth) {
+    while (count > INSERTION_SORT_SIZE) {
+        if (depth-- == 0) {
+            merge_sort(versions, keys, buffer, count);
+            return;
+        }
+
+        int mid = count / 2;
+        if (compare_keys(versions, &keys[mid], &keys[0]) < 0) {
+            swap_keys(&keys[mid], &keys[0]);
+        }
+        if (compare_keys(versions, &keys[count - 1], &keys[mid]) < 0) {
+            swap_keys(&keys[count - 1], &keys[mid]);
+            if (compare_keys(versions, &keys[mid], &keys[0]) < 0) {
+                swap_keys(&keys[mid], &keys[0]);
+            }
+        }
+        SortKey pivot = keys[mid];
+
+        int i = 0, j = count - 1;
+        for (;;) {
+            /* bounds are checked in case compare_versions is not consistent */
+            while (i < count - 1 && compare_keys(versions, &keys[i], &pivot) < 0) {
+                i++;
+            }
+            while (j > 0 && compare_keys(versions, &pivot, &keys[j]) < 0) {
+                j--;
+            }
+            if (i >= j) {
+                break;
+            }
+            swap_keys(&keys[i++], &keys[j--]);
+        }
+
+        int left = j + 1;
+        if (left <= 0 || left >= count) {
+            /* no progress: compare_versions is not consistent for these keys */
+            merge_sort(versions, keys, buffer, count);
+            return;
+        }
+
+        /* recurse into the smaller half */
+        if (left < count - left) {
+            quick_sort(versions, keys, buffer, left, depth);
+            keys += left;
+            buffer += left;
+            count -= left;
+        } else {
+            quick_sort(versions, keys + left, buffer + left, count - left, depth);
+            count = left;
+        }
+    }
+
+    insertion_sort(versions, keys, count);
+}
+
+static int part_begin(const SortContext* ctx, int part) {
+    return (int)((long long)ctx->count * part / ctx->parts);
+}
+
+static void sort_part(void* arg, int part) {
+    SortContext* ctx = arg;
+    int begin = part_begin(ctx, part);
+    int end = part_begin(ctx, part + 1);
+
+    for (int i = begin; i < end; i++) {
+        int index = ctx->indices != NULL ? ctx->indices[i] : i;
+        const SemVersion* ver = &ctx->versions[index];
+        SortKey* key = &ctx->keys[i];
+        key->major = ver->major;
+        key->minor = ver->minor;
+        key->patch = ver->patch;
+        key->prerelease = ver->prerelease;
+        key->index = index;
+    }
+
+    if (ctx->stable) {
+        merge_sort(ctx->versions, ctx->keys + begin, ctx->buffer + begin, end - begin);
+    } else {
+        int depth = 0;
+        for (int n = end - begin; n > 0; n >>= 1) {
+            depth += 2;
+        }
+        quick_sort(ctx->versions, ctx->keys + begin, ctx->buffer + begin, end - begin, depth);
+    }
+}
+
+/* Returns how many of the first k merged keys come from a */
+static int co_rank(const SemVersion* versions, const SortKey* a, int count_a, const SortKey* b, int count_b, int k) {
+    int lo = k > count_b ? k - count_b : 0;
+    int hi = k < count_a ? k : count_a;
+    while (lo < hi) {
+        int i = lo + (hi - lo) / 2;
+        /* a[i] goes before b[k-i-1], so more keys of a are needed */
+        if (compare_keys(versions, &a[i], &b[k - i - 1]) <= 0) {
+            lo = i + 1;
+        } else {
+            hi = i;
+        }
+    }
+    return lo;
+}
+
+static void merge_part(void* arg, int part) {
+    SortContext* ctx = arg;
+    for (int t = part; t < ctx->task_count; t += ctx->parts) {
+        const MergeTask* task = &ctx->tasks[t];
+        merge_runs(ctx->versions, task->a, task->count_a, task->b, task->count_b, task->out);
+    }
+}
+
+/* Adds tasks that merge a and b to out in pieces of about the same size */
+static void split_merge(SortContext* ctx, const SortKey* a, int count_a, const SortKey* b, int count_b,
+        SortKey* out, int pieces) {
+    int total = count_a + count_b;
+    int prev_k = 0, prev_i = 0;
+    for (int p = 1; p <= pieces; p++) {
+        int k = (int)((long long)total * p / pieces);
+        int i = co_rank(ctx->versions, a, count_a, b, count_b, k);
+        /* pieces must not overlap even if compare_versions is not consistent */
+        if (i < prev_i) {
+            i = prev_i;
+        } else if (i > prev_i + k - prev_k) {
+            i = prev_i + k - prev_k;
+        }
+
+        MergeTask* task = &ctx->tasks[ctx->task_count++];
+        task->a = a + prev_i;
+        task->count_a = i - prev_i;
+        task->b = b + prev_k - prev_i;
+        task->count_b = (k - i) - (prev_k - prev_i);
+        task->out = out + prev_k;
+        prev_k = k;
+        prev_i = i;
+    }
+}
+
+static void gather_part(void* arg, int part) {
+    SortContext* ctx = arg;
+    int end = part_begin(ctx, part + 1);
+    if (ctx->values == NULL) {
+        for (int i = part_begin(ctx, part); i < end; i++) {
+            ctx->indices[i] = ctx->keys[i].index;
+        }
+        return;
+    }
+
+    for (int i = part_begin(ctx, part); i < end; i++) {
+#ifdef __GNUC__
+        /* versions are read in random order */
+        if (i + GATHER_PREFETCH < end) {
+            __builtin_prefetch(&ctx->versions[ctx->keys[i + GATHER_PREFETCH].index]);
+        }
+#endif
+        ctx->values[i] = ctx->versions[ctx->keys[i].index];
+    }
+}
+
+static void copy_part(void* arg, int part) {
+    SortContext* ctx = arg;
+    int begin = part_begin(ctx, part);
+    memcpy((SemVersion*)ctx->versions + begin, ctx->values + begin,
+            (part_begin(ctx, part + 1) - begin) * sizeof(SemVersion));
+}
+
+/* Merges sorted parts in rounds. Returns the array with the result */
+static SortKey* merge_parts(SortContext* ctx) {
+    int runs = ctx->parts;
+    int* bounds = ctx->bounds;
+    for (int r = 0; r <= runs; r++) {
+        bounds[r] = part_begin(ctx, r);
+    }
+
+    SortKey* src = ctx->keys;
+    SortKey* dst = ctx->buffer;
+    while (runs > 1) {
+        int pairs = runs / 2;
+        int splits = ctx->parts / pairs > 1 ? ctx->parts / pairs : 1;
+        ctx->task_count = 0;
+
+        for (int r = 0; r < runs; r += 2) {
+            int begin = bounds[r];
+            int mid = bounds[r + 1];
+            int end = r + 2 <= runs ? bounds[r + 2] : mid;
+            split_merge(ctx, src + begin, mid - begin, src + mid, end - mid, dst + begin, r + 1 < runs ? splits : 1);
+            bounds[r / 2] = begin;
+        }
+        run_parallel(ctx->parts, merge_part, ctx);
+
+        bounds[(runs + 1) / 2] = ctx->count;
+        runs = (runs + 1) / 2;
+        SortKey* tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+
+    return src;
+}
+
+/* Moves versions to their places in place following permutation cycles */
+static void permute_versions(SemVersion* versions, SortKey* keys, int count) {
+    for (int i = 0; i < count; i++) {
+        if (keys[i].index == i) {
+            continue;
+        }
+
+        SemVersion tmp = versions[i];
+        int j = i;
+        while (keys[j].index != i) {
+            int next = keys[j].index;
+            versions[j] = versions[next];
+            keys[j].index = j;
+            j = next;
+        }
+        versions[j] = tmp;
+        keys[j].index = j;
+    }
+}
+
+static int sort_keys(SortContext* ctx, int flags, int threads) {
+    if (threads < 1) {
+        threads = semver_cpu_count();
+    }
+    ctx->parts = ctx->count / MIN_PART_SIZE < threads ? ctx->count / MIN_PART_SIZE : threads;
+    if (ctx->parts < 1) {
+        ctx->parts = 1;
+    }
+    ctx->stable = (flags & VERSION_SORT_STABLE) != 0;
+    ctx->values = NULL;
+
+    ctx->keys = malloc(ctx->count * sizeof(SortKey));
+    ctx->buffer = malloc(ctx->count * sizeof(SortKey));
+    /* a round has at most parts pieces of merges and one run to copy */
+    ctx->tasks = malloc((ctx->parts + 1) * sizeof(MergeTask));
+    ctx->bounds = malloc((ctx->parts + 1) * sizeof(int));
+    if (ctx->keys == NULL || ctx->buffer == NULL || ctx->tasks == NULL || ctx->bounds == NULL) {
+        free(ctx->keys);
+        free(ctx->buffer);
+        free(ctx->tasks);
+        free(ctx->bounds);
+        return SEMVER_OUT_OF_MEMORY;
+    }
+
+    run_parallel(ctx->parts, sort_part, ctx);
+
+    SortKey* sorted = ctx->parts > 1 ? merge_parts(ctx) : ctx->keys;
+    if (sorted != ctx->keys) {
+        ctx->buffer = ctx->keys;
+        ctx->keys = sorted;
+    }
+    free(ctx->buffer);
+    free(ctx->tasks);
+    free(ctx->bounds);
+
+    return SEMVER_OK;
+}
+
+int sort_versions(SemVersion* versions, int count, int flags, int threads) {
+    if ((versions == NULL && count != 0) || count < 0) {
+        return SEMVER_INVALID_VERSION;
+    }
+    if (count < 2) {
+        return SEMVER_OK;
+    }
+
+    SortContext ctx;
+    ctx.versions = versions;
+    ctx.count = count;
+    ctx.indices = NULL;
+    int res = sort_keys(&ctx, flags, threads);
+    if (res != SEMVER_OK) {
+        return res;
+    }
+
+    ctx.values = malloc(count * sizeof(SemVersion));
+    if (ctx.values != NULL) {
+        run_parallel(ctx.parts, gather_part, &ctx);
+        run_parallel(ctx.parts, copy_part, &ctx);
+    } else {
+        /* no memory for a copy of versions */
+        permute_versions(versions, ctx.keys, count);
+    }
+
+    free(ctx.values);
+    free(ctx.keys);
+    return SEMVER_OK;
+}
+
+int sort_version_indices(const SemVersion* versions, int* indices, int count, int flags, int threads) {
+    if (((versions == NULL || indices == NULL) && count != 0) || count < 0) {
+        return SEMVER_INVALID_VERSION;
+    }
+    if (count < 2) {
+        return SEMVER_OK;
+    }
+
+    SortContext ctx;
+    ctx.versions = versions;
+    ctx.count = count;
+    ctx.indices = indices;
+    int res = sort_keys(&ctx, flags, threads);
+    if (res != SEMVER_OK) {
+        return res;
+    }
+
+    run_parallel(ctx.parts, gather_part, &ctx);
+
+    free(ctx.keys);
+    return SEMVER_OK;
+}
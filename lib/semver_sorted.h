@@ -0,0 +1,27 @@
+/* Search of sorted version arrays by the terms of version lists, shared
+ * by the library sources that keep sorted versions in their own layout.
+ */
+#ifndef SEMVER_SORTED_20261019
+#define SEMVER_SORTED_20261019
+
+#include "semver.h"
+
+/* Compares the version at idx of a sorted array with version, the sign
+ * is the one of compare_versions
+ */
+typedef int (*SortedCompare)(const void* array, int idx, const SemVersion* version);
+
+/* Returns the first index of the count versions of array that is greater
+ * than version (strict) or not less than version
+ */
+int sorted_bound(const void* array, int count, SortedCompare compare, const SemVersion* version, int strict);
+
+/* Returns the index of the highest version of array that meets
+ * version_list, -1 if there is none or the list is invalid. The list is
+ * walked once: limits of every term narrow the range of indices with
+ * binary search, then versions excluded with '!=' are skipped from the
+ * top of the range
+ */
+int sorted_max_satisfying(const void* array, int count, SortedCompare compare, const char* version_list);
+
+#endif
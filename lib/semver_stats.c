@@ -0,0 +1,347 @@
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "semver.h"
+#include "semver_stats.h"
+#include "semver_stats_hooks.h"
+
+static const char* entry_names[STATS_ENTRY_COUNT] = {
+    "parse_version", "compare_versions", "version_equals", "check_version", "walk_version_list",
+    "add_version", "complete_version_range", "compile_version_list", "check_version_blob",
+    "validate_version",
+};
+
+static const char* counter_names[STATS_COUNTER_COUNT] = {
+    "lists", "terms", "range_nodes", "allocations", "single_matches", "range_checks", "range_matches",
+};
+
+#ifdef SEMVER_STATS
+
+#include <stdatomic.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <time.h>
+#endif
+
+/* Statistics of one thread. Only the owner thread changes the counters,
+ * so a plain load and store is enough: atomics only make the values
+ * readable from other threads. When the thread exits the block is
+ * released, and the next new thread takes it over and keeps adding to
+ * its counters, so the sums of all blocks stay correct and the number of
+ * blocks is the largest number of threads that were alive at once
+ */
+typedef struct thread_stats_t {
+    atomic_ullong calls[STATS_ENTRY_COUNT];
+    atomic_ullong total_ns[STATS_ENTRY_COUNT];
+    atomic_ullong latency[STATS_ENTRY_COUNT][STATS_LATENCY_BUCKETS];
+    atomic_ullong counters[STATS_COUNTER_COUNT];
+    /* reset generation the counters belong to */
+    atomic_uint generation;
+    atomic_int in_use;
+    struct thread_stats_t* next;
+} ThreadStats;
+
+/* list of all thread blocks, new blocks are pushed to the head */
+static _Atomic(ThreadStats*) all_stats = NULL;
+/* reset_semver_stats increments it, and every thread zeroes its
+ * counters the next time it updates them
+ */
+static atomic_uint generation = 0;
+static _Thread_local ThreadStats* local_stats = NULL;
+
+static void release_local_stats(void* data) {
+    ThreadStats* stats = data;
+    local_stats = NULL;
+    if (stats != NULL) {
+        atomic_store_explicit(&stats->in_use, 0, memory_order_release);
+    }
+}
+
+/* Registers the block of the thread, so release_local_stats is called
+ * when the thread exits */
+#ifdef _WIN32
+static INIT_ONCE exit_once = INIT_ONCE_STATIC_INIT;
+static DWORD exit_slot = FLS_OUT_OF_INDEXES;
+
+static VOID WINAPI release_on_exit(PVOID data) {
+    release_local_stats(data);
+}
+
+static BOOL CALLBACK create_exit_slot(PINIT_ONCE once, PVOID param, PVOID* context) {
+    exit_slot = FlsAlloc(release_on_exit);
+    return TRUE;
+}
+
+static void watch_thread_exit(ThreadStats* stats) {
+    InitOnceExecuteOnce(&exit_once, create_exit_slot, NULL, NULL);
+    if (exit_slot != FLS_OUT_OF_INDEXES) {
+        FlsSetValue(exit_slot, stats);
+    }
+}
+#else
+static pthread_once_t exit_once = PTHREAD_ONCE_INIT;
+static pthread_key_t exit_key;
+static int exit_key_created = 0;
+
+static void create_exit_key() {
+    exit_key_created = pthread_key_create(&exit_key, release_local_stats) == 0;
+}
+
+static void watch_thread_exit(ThreadStats* stats) {
+    pthread_once(&exit_once, create_exit_key);
+    if (exit_key_created) {
+        pthread_setspecific(exit_key, stats);
+    }
+}
+#endif
+
+static void add(atomic_ullong* value, unsigned long long n) {
+    atomic_store_explicit(value, atomic_load_explicit(value, memory_order_relaxed) + n, memory_order_relaxed);
+}
+
+static void zero_stats(ThreadStats* stats) {
+    for (int i = 0; i < STATS_ENTRY_COUNT; i++) {
+        atomic_store_explicit(&stats->calls[i], 0, memory_order_relaxed);
+        atomic_store_explicit(&stats->total_ns[i], 0, memory_order_relaxed);
+        for (int b = 0; b < STATS_LATENCY_BUCKETS; b++) {
+            atomic_store_explicit(&stats->latency[i][b], 0, memory_order_relaxed);
+        }
+    }
+    for (int i = 0; i < STATS_COUNTER_COUNT; i++) {
+        atomic_store_explicit(&stats->counters[i], 0, memory_order_relaxed);
+    }
+}
+
+static ThreadStats* get_local_stats() {
+    unsigned int gen = atomic_load_explicit(&generation, memory_order_relaxed);
+    ThreadStats* stats = local_stats;
+
+    if (stats == NULL) {
+        for (ThreadStats* t = atomic_load(&all_stats); t != NULL && stats == NULL; t = t->next) {
+            int expected = 0;
+            if (atomic_compare_exchange_strong_explicit(&t->in_use, &expected, 1, memory_order_acquire,
+                        memory_order_relaxed)) {
+                stats = t;
+            }
+        }
+        if (stats == NULL) {
+            stats = calloc(1, sizeof(ThreadStats));
+            if (stats == NULL) {
+                return NULL;
+            }
+            zero_stats(stats);
+            atomic_init(&stats->generation, gen);
+            atomic_init(&stats->in_use, 1);
+
+            ThreadStats* head = atomic_load(&all_stats);
+            do {
+                stats->next = head;
+            } while (! atomic_compare_exchange_weak(&all_stats, &head, stats));
+        }
+        local_stats = stats;
+        watch_thread_exit(stats);
+    }
+
+    if (atomic_load_explicit(&stats->generation, memory_order_relaxed) != gen) {
+        zero_stats(stats);
+        atomic_store_explicit(&stats->generation, gen, memory_order_release);
+    }
+
+    return stats;
+}
+
+unsigned long long semver_stats_clock() {
+#ifdef _WIN32
+    static LARGE_INTEGER freq;
+    LARGE_INTEGER now;
+    if (freq.QuadPart == 0) {
+        QueryPerformanceFrequency(&freq);
+    }
+    QueryPerformanceCounter(&now);
+    return (unsigned long long)(now.QuadPart / freq.QuadPart) * 1000000000ull +
+        (unsigned long long)(now.QuadPart % freq.QuadPart) * 1000000000ull / freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+#endif
+}
+
+/* Returns the number of significant bits of ns: it is the index of the
+ * first bucket with 2^i > ns
+ */
+static int latency_bucket(unsigned long long ns) {
+#ifdef __GNUC__
+    int bucket = ns == 0 ? 0 : 64 - __builtin_clzll(ns);
+#else
+    int bucket = 0;
+    while (bucket < STATS_LATENCY_BUCKETS - 1 && ns >= (1ull << bucket)) {
+        bucket++;
+    }
+#endif
+    return bucket < STATS_LATENCY_BUCKETS ? bucket : STATS_LATENCY_BUCKETS - 1;
+}
+
+void semver_stats_record(int entry, unsigned long long started) {
+    unsigned long long ns = semver_stats_clock() - started;
+    ThreadStats* stats = get_local_stats();
+    if (stats == NULL) {
+        return;
+    }
+
+    add(&stats->calls[entry], 1);
+    add(&stats->total_ns[entry], ns);
+    add(&stats->latency[entry][latency_bucket(ns)], 1);
+}
+
+void semver_stats_count(int counter, unsigned long long n) {
+    ThreadStats* stats = get_local_stats();
+    if (stats != NULL) {
+        add(&stats->counters[counter], n);
+    }
+}
+
+int semver_stats_enabled() {
+    return 1;
+}
+
+void get_semver_stats(SemverStats* stats) {
+    if (stats == NULL) {
+        return;
+    }
+
+    memset(stats, 0, sizeof(SemverStats));
+    unsigned int gen = atomic_load(&generation);
+    for (ThreadStats* t = atomic_load(&all_stats); t != NULL; t = t->next) {
+        /* the thread has not updated its counters since the reset */
+        if (atomic_load_explicit(&t->generation, memory_order_acquire) != gen) {
+            continue;
+        }
+
+        for (int i = 0; i < STATS_ENTRY_COUNT; i++) {
+            stats->entries[i].calls += atomic_load_explicit(&t->calls[i], memory_order_relaxed);
+            stats->entries[i].total_ns += atomic_load_explicit(&t->total_ns[i], memory_order_relaxed);
+            for (int b = 0; b < STATS_LATENCY_BUCKETS; b++) {
+                stats->entries[i].latency[b] += atomic_load_explicit(&t->latency[i][b], memory_order_relaxed);
+            }
+        }
+        for (int i = 0; i < STATS_COUNTER_COUNT; i++) {
+            stats->counters[i] += atomic_load_explicit(&t->counters[i], memory_order_relaxed);
+        }
+    }
+}
+
+void reset_semver_stats() {
+    atomic_fetch_add(&generation, 1);
+}
+
+#else
+
+int semver_stats_enabled() {
+    return 0;
+}
+
+void get_semver_stats(SemverStats* stats) {
+    if (stats != NULL) {
+        memset(stats, 0, sizeof(SemverStats));
+    }
+}
+
+void reset_semver_stats() {
+}
+
+#endif
+
+const char* stats_entry_name(int entry) {
+    return (entry >= 0 && entry < STATS_ENTRY_COUNT) ? entry_names[entry] : NULL;
+}
+
+const char* stats_counter_name(int counter) {
+    return (counter >= 0 && counter < STATS_COUNTER_COUNT) ? counter_names[counter] : NULL;
+}
+
+typedef struct stats_writer_t {
+    char* buf;
+    size_t size;
+    size_t len;
+} StatsWriter;
+
+static void append(StatsWriter* w, const char* fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    int n = vsnprintf(w->len < w->size ? w->buf + w->len : NULL,
+            w->len < w->size ? w->size - w->len : 0, fmt, args);
+    va_end(args);
+    if (n > 0) {
+        w->len += n;
+    }
+}
+
+static void format_text(const SemverStats* stats, StatsWriter* w) {
+    for (int i = 0; i < STATS_ENTRY_COUNT; i++) {
+        const StatsEntryData* e = &stats->entries[i];
+        append(w, "%-24s calls %llu, total %llu ns\n", entry_names[i], e->calls, e->total_ns);
+        if (e->calls == 0) {
+            continue;
+        }
+        append(w, "    latency:");
+        for (int b = 0; b < STATS_LATENCY_BUCKETS; b++) {
+            if (e->latency[b] != 0) {
+                if (b < STATS_LATENCY_BUCKETS - 1) {
+                    append(w, " <%lluns:%llu", 1ull << b, e->latency[b]);
+                } else {
+                    append(w, " >=%lluns:%llu", 1ull << (b - 1), e->latency[b]);
+                }
+            }
+        }
+        append(w, "\n");
+    }
+    for (int i = 0; i < STATS_COUNTER_COUNT; i++) {
+        append(w, "%-24s %llu\n", counter_names[i], stats->counters[i]);
+    }
+}
+
+static void format_json(const SemverStats* stats, StatsWriter* w) {
+    append(w, "{\"entries\":{");
+    for (int i = 0; i < STATS_ENTRY_COUNT; i++) {
+        const StatsEntryData* e = &stats->entries[i];
+        append(w, "%s\"%s\":{\"calls\":%llu,\"total_ns\":%llu,\"latency\":[",
+                i == 0 ? "" : ",", entry_names[i], e->calls, e->total_ns);
+        for (int b = 0; b < STATS_LATENCY_BUCKETS; b++) {
+            append(w, "%s%llu", b == 0 ? "" : ",", e->latency[b]);
+        }
+        append(w, "]}");
+    }
+    append(w, "},\"counters\":{");
+    for (int i = 0; i < STATS_COUNTER_COUNT; i++) {
+        append(w, "%s\"%s\":%llu", i == 0 ? "" : ",", counter_names[i], stats->counters[i]);
+    }
+    append(w, "}}\n");
+}
+
+int format_semver_stats(const SemverStats* stats, int format, char* buf, size_t size) {
+    if (stats == NULL || (format != STATS_FORMAT_TEXT && format != STATS_FORMAT_JSON)) {
+        return -1;
+    }
+
+    StatsWriter w;
+    w.buf = buf;
+    w.size = buf == NULL ? 0 : size;
+    w.len = 0;
+
+    if (format == STATS_FORMAT_TEXT) {
+        format_text(stats, &w);
+    } else {
+        format_json(stats, &w);
+    }
+
+    if (buf != NULL && size > 0 && w.len >= size) {
+        buf[size - 1] = '\0';
+    }
+
+    return (int)w.len;
+}
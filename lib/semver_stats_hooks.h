@@ -0,0 +1,30 @@
+/* Statistics hooks for the library sources. Without SEMVER_STATS they
+ * expand to plain calls and do not add any code.
+ */
+#ifndef SEMVER_STATS_HOOKS_20261019
+#define SEMVER_STATS_HOOKS_20261019
+
+#include "semver_stats.h"
+
+#ifdef SEMVER_STATS
+
+unsigned long long semver_stats_clock();
+void semver_stats_record(int entry, unsigned long long started);
+void semver_stats_count(int counter, unsigned long long n);
+
+/* res = call, and the time of the call is added to the entry */
+#define STATS_TIMED(entry, res, call) do {                   \
+        unsigned long long started_ = semver_stats_clock(); \
+        (res) = (call);                                     \
+        semver_stats_record((entry), started_);             \
+    } while (0)
+#define STATS_COUNT(counter, n) semver_stats_count((counter), (n))
+
+#else
+
+#define STATS_TIMED(entry, res, call) ((res) = (call))
+#define STATS_COUNT(counter, n) ((void)0)
+
+#endif
+
+#endif
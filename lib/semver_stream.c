@@ -0,0 +1,315 @@
+#include <string.h>
+#include <limits.h>
+
+#include "semver.h"
+#include "semver_stream.h"
+
+enum {
+    /* leading spaces and 'v' */
+    STREAM_LEAD,
+    /* the first char of a two-char compare operator */
+    STREAM_BANG,
+    STREAM_EQ,
+    STREAM_GT,
+    STREAM_LT,
+    /* spaces before a number */
+    STREAM_NUM_START,
+    STREAM_NUM,
+    STREAM_PRERELEASE,
+    STREAM_BUILD,
+    /* trailing spaces after build */
+    STREAM_TRAIL,
+    /* the item is invalid, skip it till the delimiter */
+    STREAM_ERROR,
+};
+
+static const int part_errors[PART_COUNT] = { SEMVER_INVALID_MAJOR, SEMVER_INVALID_MINOR, SEMVER_INVALID_PATCH };
+
+static int is_delimiter(char c) {
+    return c == '\n' || c == '\r' || c == '\t' || c == ',';
+}
+
+static int is_valid_char(char c) {
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >='A' && c <= 'Z') || c == '.';
+}
+
+static int is_digit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+static void reset_item(VersionStream* stream) {
+    memset(&stream->item, 0, sizeof(VersionStreamItem));
+    stream->item.version.prerelease = PRERELEASE_NONE;
+    stream->item.offset = stream->offset;
+    stream->state = STREAM_LEAD;
+    stream->part = 0;
+    stream->number = 0;
+    stream->overflow = 0;
+    stream->pre_len = 0;
+    stream->build_len = 0;
+    stream->not_blank = 0;
+}
+
+void init_version_stream(VersionStream* stream) {
+    if (stream == NULL) {
+        return;
+    }
+
+    memset(stream, 0, sizeof(VersionStream));
+    reset_item(stream);
+}
+
+static void fail(VersionStream* stream, int error) {
+    stream->item.result = error;
+    stream->item.error_offset = stream->offset;
+    stream->state = STREAM_ERROR;
+}
+
+/* Stores the number that has just been read. Numbers are converted the
+ * same way parse_version does it: too big values turn into LONG_MAX
+ */
+static int finish_number(VersionStream* stream) {
+    unsigned long long value = stream->overflow ? (unsigned long long)LONG_MAX : stream->number;
+    unsigned int num = (unsigned int)value;
+    if (num == INVALID_NUMBER) {
+        return 0;
+    }
+
+    if (stream->part == 0) {
+        stream->item.version.major = num;
+    } else if (stream->part == 1) {
+        stream->item.version.minor = num;
+    } else {
+        stream->item.version.patch = num;
+    }
+    return 1;
+}
+
+static void finish_prerelease(VersionStream* stream) {
+    static const char* prevalues[] = { "alpha", "beta", "rc" };
+    static const int prereleases[] = { PRERELEASE_ALPHA, PRERELEASE_BETA, PRERELEASE_RC };
+
+    SemVersion* ver = &stream->item.version;
+    ver->prerelease = PRERELEASE_BASIC;
+    for (int i = 0; i < sizeof(prereleases) / sizeof(prereleases[0]); i++) {
+        if (strncmp(ver->prerelease_str, prevalues[i], strlen(prevalues[i])) == 0) {
+            ver->prerelease = prereleases[i];
+            break;
+        }
+    }
+}
+
+static void set_compare(VersionStream* stream, VersionCompare cmp) {
+    stream->item.version.cmp = cmp;
+    stream->state = STREAM_NUM_START;
+}
+
+/* Processes one byte of an item */
+static void step(VersionStream* stream, char c) {
+    SemVersion* ver = &stream->item.version;
+
+    if (c != ' ') {
+        stream->not_blank = 1;
+    }
+
+    switch (stream->state) {
+        case STREAM_LEAD:
+            if (c == ' ' || c == 'v' || c == 'V') {
+                return;
+            } else if (is_digit(c)) {
+                stream->state = STREAM_NUM;
+                stream->number = c - '0';
+            } else if (c == '!') {
+                stream->state = STREAM_BANG;
+            } else if (c == '=') {
+                stream->state = STREAM_EQ;
+            } else if (c == '>') {
+                stream->state = STREAM_GT;
+            } else if (c == '<') {
+                stream->state = STREAM_LT;
+            } else if (c == '^') {
+                set_compare(stream, COMPARE_MAJOR);
+            } else if (c == '~') {
+                set_compare(stream, COMPARE_MINOR);
+            } else {
+                fail(stream, SEMVER_INVALID_MAJOR);
+            }
+            return;
+
+        case STREAM_BANG:
+            if (c == '=') {
+                set_compare(stream, COMPARE_NEQUAL);
+            } else {
+                fail(stream, SEMVER_INVALID_MAJOR);
+            }
+            return;
+
+        case STREAM_EQ:
+        case STREAM_GT:
+        case STREAM_LT:
+            if (c == '=') {
+                set_compare(stream, stream->state == STREAM_EQ ? COMPARE_EQUAL :
+                        (stream->state == STREAM_GT ? COMPARE_GREATEROREQUAL : COMPARE_LESSOREQUAL));
+                return;
+            }
+            set_compare(stream, stream->state == STREAM_EQ ? COMPARE_EQUAL :
+                    (stream->state == STREAM_GT ? COMPARE_GREATER : COMPARE_LESS));
+            /* the char belongs to the number */
+            step(stream, c);
+            return;
+
+        case STREAM_NUM_START:
+            if (c == ' ') {
+                return;
+            } else if (is_digit(c)) {
+                stream->state = STREAM_NUM;
+                stream->number = c - '0';
+                stream->overflow = 0;
+            } else {
+                fail(stream, part_errors[stream->part]);
+            }
+            return;
+
+        case STREAM_NUM:
+            if (is_digit(c)) {
+                if (! stream->overflow) {
+                    if (stream->number > ((unsigned long long)LONG_MAX - (c - '0')) / 10) {
+                        stream->overflow = 1;
+                    } else {
+                        stream->number = stream->number * 10 + (c - '0');
+                    }
+                }
+                return;
+            }
+            if (! finish_number(stream)) {
+                fail(stream, part_errors[stream->part]);
+            } else if (stream->part < PART_COUNT - 1) {
+                if (c == '.') {
+                    stream->part++;
+                    stream->state = STREAM_NUM_START;
+                } else {
+                    fail(stream, part_errors[stream->part]);
+                }
+            } else if (c == '-') {
+                stream->state = STREAM_PRERELEASE;
+            } else if (c == '+') {
+                stream->state = STREAM_BUILD;
+            } else {
+                fail(stream, SEMVER_INVALID_PATCH);
+            }
+            return;
+
+        case STREAM_PRERELEASE:
+            if (is_valid_char(c)) {
+                if (stream->pre_len < MAX_PRERELEASE_LEN - 1) {
+                    ver->prerelease_str[stream->pre_len++] = c;
+                }
+            } else if (c == '+') {
+                finish_prerelease(stream);
+                stream->state = STREAM_BUILD;
+            } else {
+                fail(stream, SEMVER_INVALID_PRERELEASE);
+            }
+            return;
+
+        case STREAM_BUILD:
+            if (is_valid_char(c)) {
+                if (stream->build_len < MAX_BUILD_LEN) {
+                    ver->build_str[stream->build_len++] = c;
+                }
+            } else if (c == ' ') {
+                stream->state = STREAM_TRAIL;
+            } else {
+                fail(stream, SEMVER_INVALID_BUILD);
+            }
+            return;
+
+        case STREAM_TRAIL:
+            if (c != ' ') {
+                fail(stream, SEMVER_INVALID_BUILD);
+            }
+            return;
+
+        default:
+            return;
+    }
+}
+
+/* Finishes the current item. Returns 0 if the item is blank and must not be reported */
+static int end_item(VersionStream* stream) {
+    VersionStreamItem* item = &stream->item;
+    item->length = stream->offset - item->offset;
+
+    switch (stream->state) {
+        case STREAM_LEAD:
+            if (! stream->not_blank) {
+                return 0;
+            }
+            fail(stream, SEMVER_INVALID_MAJOR);
+            break;
+        case STREAM_BANG:
+        case STREAM_EQ:
+        case STREAM_GT:
+        case STREAM_LT:
+            fail(stream, SEMVER_INVALID_MAJOR);
+            break;
+        case STREAM_NUM_START:
+            fail(stream, part_errors[stream->part]);
+            break;
+        case STREAM_NUM:
+            if (! finish_number(stream) || stream->part < PART_COUNT - 1) {
+                fail(stream, part_errors[stream->part]);
+            }
+            break;
+        case STREAM_PRERELEASE:
+            finish_prerelease(stream);
+            break;
+        default:
+            break;
+    }
+
+    return 1;
+}
+
+int feed_version_stream(VersionStream* stream, const char* chunk, size_t len,
+        VersionStreamCallback callback, void* data) {
+    if (stream == NULL || callback == NULL || (chunk == NULL && len != 0)) {
+        return SEMVER_INVALID_VERSION;
+    }
+
+    for (size_t i = 0; i < len; i++) {
+        char c = chunk[i];
+        if (! is_delimiter(c)) {
+            step(stream, c);
+            stream->offset++;
+            continue;
+        }
+
+        int report = end_item(stream);
+        stream->offset++;
+        if (report) {
+            int res = callback(&stream->item, data);
+            if (res != SEMVER_OK) {
+                reset_item(stream);
+                return res;
+            }
+        }
+        reset_item(stream);
+    }
+
+    return SEMVER_OK;
+}
+
+int finish_version_stream(VersionStream* stream, VersionStreamCallback callback, void* data) {
+    if (stream == NULL || callback == NULL) {
+        return SEMVER_INVALID_VERSION;
+    }
+
+    int res = SEMVER_OK;
+    if (end_item(stream)) {
+        res = callback(&stream->item, data);
+    }
+    reset_item(stream);
+
+    return res;
+}
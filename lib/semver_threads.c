@@ -0,0 +1,124 @@
+#include <stdlib.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#include "semver_threads.h"
+
+typedef struct parallel_part_t {
+    void (*fn)(void* arg, int part);
+    void* arg;
+    int part;
+    int started;
+#ifdef _WIN32
+    HANDLE thread;
+#else
+    pthread_t thread;
+#endif
+} ParallelPart;
+
+#ifdef _WIN32
+static DWORD WINAPI part_main(LPVOID data) {
+    ParallelPart* p = data;
+    p->fn(p->arg, p->part);
+    return 0;
+}
+
+static int start_part(ParallelPart* p) {
+    p->thread = CreateThread(NULL, 0, part_main, p, 0, NULL);
+    return p->thread != NULL;
+}
+
+static void join_part(ParallelPart* p) {
+    WaitForSingleObject(p->thread, INFINITE);
+    CloseHandle(p->thread);
+}
+
+int semver_cpu_count() {
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? (int)info.dwNumberOfProcessors : 1;
+}
+
+void semver_mutex_init(SemverMutex* mutex) {
+    InitializeCriticalSection(mutex);
+}
+
+void semver_mutex_destroy(SemverMutex* mutex) {
+    DeleteCriticalSection(mutex);
+}
+
+void semver_mutex_lock(SemverMutex* mutex) {
+    EnterCriticalSection(mutex);
+}
+
+void semver_mutex_unlock(SemverMutex* mutex) {
+    LeaveCriticalSection(mutex);
+}
+#else
+static void* part_main(void* data) {
+    ParallelPart* p = data;
+    p->fn(p->arg, p->part);
+    return NULL;
+}
+
+static int start_part(ParallelPart* p) {
+    return pthread_create(&p->thread, NULL, part_main, p) == 0;
+}
+
+static void join_part(ParallelPart* p) {
+    pthread_join(p->thread, NULL);
+}
+
+int semver_cpu_count() {
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (int)count : 1;
+}
+
+void semver_mutex_init(SemverMutex* mutex) {
+    pthread_mutex_init(mutex, NULL);
+}
+
+void semver_mutex_destroy(SemverMutex* mutex) {
+    pthread_mutex_destroy(mutex);
+}
+
+void semver_mutex_lock(SemverMutex* mutex) {
+    pthread_mutex_lock(mutex);
+}
+
+void semver_mutex_unlock(SemverMutex* mutex) {
+    pthread_mutex_unlock(mutex);
+}
+#endif
+
+void run_parallel(int parts, void (*fn)(void* arg, int part), void* arg) {
+    ParallelPart* p = parts > 1 ? calloc(parts, sizeof(ParallelPart)) : NULL;
+    if (p == NULL) {
+        for (int i = 0; i < parts; i++) {
+            fn(arg, i);
+        }
+        return;
+    }
+
+    for (int i = 1; i < parts; i++) {
+        p[i].fn = fn;
+        p[i].arg = arg;
+        p[i].part = i;
+        p[i].started = start_part(&p[i]);
+    }
+    fn(arg, 0);
+
+    for (int i = 1; i < parts; i++) {
+        if (p[i].started) {
+            join_part(&p[i]);
+        } else {
+            fn(arg, i);
+        }
+    }
+
+    free(p);
+}
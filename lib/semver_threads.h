@@ -0,0 +1,30 @@
+/* Thread helpers for the library sources: pthreads on Linux and other
+ * POSIX systems, Windows threads on Windows.
+ */
+#ifndef SEMVER_THREADS_20261019
+#define SEMVER_THREADS_20261019
+
+#ifdef _WIN32
+#include <windows.h>
+typedef CRITICAL_SECTION SemverMutex;
+#else
+#include <pthread.h>
+typedef pthread_mutex_t SemverMutex;
+#endif
+
+/* Calls fn(arg, part) for every part in [0, parts). Part 0 runs in the
+ * calling thread, and every other part runs in its own thread. If a
+ * thread cannot be started, its part runs in the calling thread after
+ * part 0. Returns when all parts are done.
+ */
+void run_parallel(int parts, void (*fn)(void* arg, int part), void* arg);
+
+/* Returns the number of online processors, at least 1 */
+int semver_cpu_count();
+
+void semver_mutex_init(SemverMutex* mutex);
+void semver_mutex_destroy(SemverMutex* mutex);
+void semver_mutex_lock(SemverMutex* mutex);
+void semver_mutex_unlock(SemverMutex* mutex);
+
+#endif
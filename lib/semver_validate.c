@@ -0,0 +1,222 @@
+#include <string.h>
+#include <limits.h>
+
+#include "semver.h"
+#include "semver_validate.h"
+#include "semver_stats_hooks.h"
+
+/* byte classes */
+enum {
+    C_OTHER,
+    /* the end of the string or the delimiter, it never comes from the class table */
+    C_END,
+    C_SPACE,
+    C_V,
+    C_DIGIT,
+    C_DOT,
+    /* latin letters except 'v' and 'V' */
+    C_LETTER,
+    C_MINUS,
+    C_PLUS,
+    C_BANG,
+    C_EQ,
+    C_GT,
+    C_LT,
+    C_CARET,
+    C_TILDE,
+    CLASS_COUNT
+};
+
+/* validator states */
+enum {
+    /* leading spaces and 'v' */
+    S_LEAD,
+    /* '!' that must be followed by '=' */
+    S_BANG,
+    /* '=', '<', or '>' that can be followed by '=' */
+    S_OP,
+    /* spaces before major, major, spaces before minor, etc */
+    S_MAJOR_START,
+    S_MAJOR,
+    S_MINOR_START,
+    S_MINOR,
+    S_PATCH_START,
+    S_PATCH,
+    S_PRERELEASE,
+    S_BUILD,
+    /* trailing spaces after build */
+    S_TRAIL,
+    S_ACCEPT,
+    S_REJECT,
+    STATE_COUNT
+};
+
+static const unsigned char byte_classes[256] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    2, 9, 0, 0, 0, 0, 0, 0, 0, 0, 0, 8, 0, 7, 5, 0,
+    4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 0, 0, 12, 10, 11, 0,
+    0, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+    6, 6, 6, 6, 6, 6, 3, 6, 6, 6, 6, 0, 0, 0, 13, 0,
+    0, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+    6, 6, 6, 6, 6, 6, 3, 6, 6, 6, 6, 0, 0, 0, 14, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+};
+
+#define R S_REJECT
+#define A S_ACCEPT
+
+static const unsigned char transitions[STATE_COUNT][CLASS_COUNT] = {
+    /*                 other end  space         v              digit          dot            letter         minus          plus     bang    eq             gt    lt    caret          tilde */
+    /* LEAD */        { R,    R,   S_LEAD,        S_LEAD,        S_MAJOR,       R,             R,             R,             R,       S_BANG, S_OP,          S_OP, S_OP, S_MAJOR_START, S_MAJOR_START },
+    /* BANG */        { R,    R,   R,             R,             R,             R,             R,             R,             R,       R,      S_MAJOR_START, R,    R,    R,             R },
+    /* OP */          { R,    R,   S_MAJOR_START, R,             S_MAJOR,       R,             R,             R,             R,       R,      S_MAJOR_START, R,    R,    R,             R },
+    /* MAJOR_START */ { R,    R,   S_MAJOR_START, R,             S_MAJOR,       R,             R,             R,             R,       R,      R,             R,    R,    R,             R },
+    /* MAJOR */       { R,    R,   R,             R,             S_MAJOR,       S_MINOR_START, R,             R,             R,       R,      R,             R,    R,    R,             R },
+    /* MINOR_START */ { R,    R,   S_MINOR_START, R,             S_MINOR,       R,             R,             R,             R,       R,      R,             R,    R,    R,             R },
+    /* MINOR */       { R,    R,   R,             R,             S_MINOR,       S_PATCH_START, R,             R,             R,       R,      R,             R,    R,    R,             R },
+    /* PATCH_START */ { R,    R,   S_PATCH_START, R,             S_PATCH,       R,             R,             R,             R,       R,      R,             R,    R,    R,             R },
+    /* PATCH */       { R,    A,   R,             R,             S_PATCH,       R,             R,             S_PRERELEASE,  S_BUILD, R,      R,             R,    R,    R,             R },
+    /* PRERELEASE */  { R,    A,   R,             S_PRERELEASE,  S_PRERELEASE,  S_PRERELEASE,  S_PRERELEASE,  R,             S_BUILD, R,      R,             R,    R,    R,             R },
+    /* BUILD */       { R,    A,   S_TRAIL,       S_BUILD,       S_BUILD,       S_BUILD,       S_BUILD,       R,             R,       R,      R,             R,    R,    R,             R },
+    /* TRAIL */       { R,    A,   S_TRAIL,       R,             R,             R,             R,             R,             R,       R,      R,             R,    R,    R,             R },
+    /* ACCEPT */      { A,    A,   A,             A,             A,             A,             A,             A,             A,       A,      A,             A,    A,    A,             A },
+    /* REJECT */      { R,    R,   R,             R,             R,             R,             R,             R,             R,       R,      R,             R,    R,    R,             R },
+};
+
+#undef R
+#undef A
+
+/* the error returned when validation fails in the state */
+static const int state_errors[STATE_COUNT] = {
+    SEMVER_INVALID_MAJOR, SEMVER_INVALID_MAJOR, SEMVER_INVALID_MAJOR,
+    SEMVER_INVALID_MAJOR, SEMVER_INVALID_MAJOR,
+    SEMVER_INVALID_MINOR, SEMVER_INVALID_MINOR,
+    SEMVER_INVALID_PATCH, SEMVER_INVALID_PATCH,
+    SEMVER_INVALID_PRERELEASE, SEMVER_INVALID_BUILD, SEMVER_INVALID_BUILD,
+    SEMVER_OK, SEMVER_INVALID_VERSION,
+};
+
+/* Numbers shorter than this cannot be equal to INVALID_NUMBER */
+#define MIN_CHECKED_DIGITS 10
+
+static int is_number_state(int state) {
+    return state == S_MAJOR || state == S_MINOR || state == S_PATCH;
+}
+
+/* Returns 0 if parse_version would reject the number: it converts numbers
+ * with atol, so too big values turn into LONG_MAX and then to unsigned int
+ */
+static int is_valid_number(const unsigned char* digits, size_t len) {
+    unsigned long long value = 0;
+    for (size_t i = 0; i < len; i++) {
+        if (value > ((unsigned long long)LONG_MAX - (digits[i] - '0')) / 10) {
+            value = LONG_MAX;
+            break;
+        }
+        value = value * 10 + (digits[i] - '0');
+    }
+
+    return (unsigned int)value != INVALID_NUMBER;
+}
+
+/* Runs the validator from the start of str till the first byte equal to
+ * delimiter (use -1 for no delimiter) or till len bytes are processed.
+ * *offset gets the offset of the byte where validation stopped
+ */
+static int run_validator(const unsigned char* str, size_t len, int delimiter, size_t* offset) {
+    int state = S_LEAD;
+    size_t num_start = 0;
+
+    for (size_t i = 0; ; i++) {
+        int cls = (i == len || str[i] == delimiter) ? C_END : byte_classes[str[i]];
+        int next = transitions[state][cls];
+        if (next == state) {
+            continue;
+        }
+
+        if (is_number_state(state) && i - num_start >= MIN_CHECKED_DIGITS &&
+            ! is_valid_number(str + num_start, i - num_start)) {
+            next = S_REJECT;
+        }
+        if (next == S_REJECT || next == S_ACCEPT) {
+            *offset = i;
+            return next == S_ACCEPT ? SEMVER_OK : state_errors[state];
+        }
+        if (is_number_state(next)) {
+            num_start = i;
+        }
+        state = next;
+    }
+}
+
+int validate_version(const char* str, size_t* error_offset) {
+    if (str == NULL) {
+        return SEMVER_INVALID_VERSION;
+    }
+
+    size_t offset;
+    int res;
+    STATS_TIMED(STATS_VALIDATE_VERSION, res, run_validator((const unsigned char*)str, (size_t)-1, '\0', &offset));
+    if (res != SEMVER_OK && error_offset != NULL) {
+        *error_offset = offset;
+    }
+
+    return res;
+}
+
+int validate_version_len(const char* str, size_t len, size_t* error_offset) {
+    if (str == NULL && len != 0) {
+        return SEMVER_INVALID_VERSION;
+    }
+
+    size_t offset;
+    int res = run_validator((const unsigned char*)str, len, -1, &offset);
+    if (res != SEMVER_OK && error_offset != NULL) {
+        *error_offset = offset;
+    }
+
+    return res;
+}
+
+size_t validate_version_buffer(const char* buf, size_t len, char delimiter,
+        VersionValidation* results, size_t max_results) {
+    if (buf == NULL) {
+        return 0;
+    }
+
+    const unsigned char* p = (const unsigned char*)buf;
+    size_t pos = 0;
+    size_t count = 0;
+
+    while (pos < len) {
+        size_t offset;
+        int res = run_validator(p + pos, len - pos, (unsigned char)delimiter, &offset);
+
+        /* a failed item is skipped till its delimiter */
+        size_t end = pos + offset;
+        if (res != SEMVER_OK) {
+            const unsigned char* delim = memchr(p + end, (unsigned char)delimiter, len - end);
+            end = (delim == NULL) ? len : (size_t)(delim - p);
+        }
+
+        if (results != NULL && count < max_results) {
+            VersionValidation* item = &results[count];
+            item->offset = pos;
+            item->length = end - pos;
+            item->result = res;
+            item->error_offset = (res == SEMVER_OK) ? 0 : pos + offset;
+        }
+        count++;
+        pos = end + 1;
+    }
+
+    return count;
+}
@@ -0,0 +1,513 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <limits.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include "semver.h"
+#include "ver_catalog.h"
+#include "semver_sorted.h"
+
+typedef struct catalog_entry_t {
+    char* package;
+    SemVersion version;
+} CatalogEntry;
+
+struct catalog_builder_t {
+    CatalogEntry* entries;
+    int count;
+    int capacity;
+};
+
+/* FNV-1a hash of package name */
+static unsigned int name_hash(const char* name) {
+    unsigned int hash = 2166136261u;
+    while (*name != '\0') {
+        hash ^= (unsigned char)*name++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static unsigned int align4(unsigned int value) {
+    return (value + 3) & ~3u;
+}
+
+CatalogBuilder* init_catalog_builder() {
+    CatalogBuilder* builder = calloc(1, sizeof(CatalogBuilder));
+    return builder;
+}
+
+void free_catalog_builder(CatalogBuilder** builder) {
+    if (builder == NULL || *builder == NULL) {
+        return;
+    }
+
+    for (int i = 0; i < (*builder)->count; i++) {
+        free((*builder)->entries[i].package);
+    }
+    free((*builder)->entries);
+    free(*builder);
+
+    *builder = NULL;
+}
+
+int catalog_builder_add(CatalogBuilder* builder, const char* package, const SemVersion* version) {
+    if (builder == NULL || package == NULL || version == NULL) {
+        return SEMVER_INVALID_VERSION;
+    }
+
+    if (builder->count == builder->capacity) {
+        int capacity = builder->capacity == 0 ? 64 : builder->capacity * 2;
+        CatalogEntry* entries = realloc(builder->entries, capacity * sizeof(CatalogEntry));
+        if (entries == NULL) {
+            return SEMVER_OUT_OF_MEMORY;
+        }
+        builder->entries = entries;
+        builder->capacity = capacity;
+    }
+
+    char* name = malloc(strlen(package) + 1);
+    if (name == NULL) {
+        return SEMVER_OUT_OF_MEMORY;
+    }
+    strcpy(name, package);
+
+    CatalogEntry* entry = &builder->entries[builder->count++];
+    entry->package = name;
+    entry->version = *version;
+    entry->version.cmp = COMPARE_NONE;
+
+    return SEMVER_OK;
+}
+
+static int compare_entries(const void* a, const void* b) {
+    const CatalogEntry* ea = a;
+    const CatalogEntry* eb = b;
+
+    int res = strcmp(ea->package, eb->package);
+    if (res != 0) {
+        return res;
+    }
+    res = compare_versions(&ea->version, &eb->version);
+    if (res != 0) {
+        return res;
+    }
+    return strncmp(ea->version.build_str, eb->version.build_str, MAX_BUILD_LEN);
+}
+
+/* Appends NUL-terminated string to the pool and returns its offset.
+ * Empty strings are not stored: they all share offset 0
+ */
+static unsigned int pool_add(char* pool, unsigned int* size, const char* str, unsigned int len) {
+    if (len == 0) {
+        return 0;
+    }
+
+    unsigned int offset = *size;
+    memcpy(pool + offset, str, len);
+    pool[offset + len] = '\0';
+    *size += len + 1;
+    return offset;
+}
+
+int catalog_builder_write(CatalogBuilder* builder, const char* path) {
+    if (builder == NULL || path == NULL) {
+        return SEMVER_INVALID_VERSION;
+    }
+
+    qsort(builder->entries, builder->count, sizeof(CatalogEntry), compare_entries);
+
+    /* drop exact duplicates and count packages */
+    int unique = 0;
+    unsigned int package_count = 0;
+    unsigned int strings_size = 1;
+    for (int i = 0; i < builder->count; i++) {
+        CatalogEntry* e = &builder->entries[i];
+        if (unique > 0 && compare_entries(&builder->entries[unique - 1], e) == 0) {
+            free(e->package);
+            continue;
+        }
+        if (unique == 0 || strcmp(builder->entries[unique - 1].package, e->package) != 0) {
+            package_count++;
+            strings_size += strlen(e->package) + 1;
+        }
+        strings_size += strlen(e->version.prerelease_str) + 1;
+        strings_size += strnlen(e->version.build_str, MAX_BUILD_LEN) + 1;
+        builder->entries[unique++] = *e;
+    }
+    builder->count = unique;
+
+    unsigned int bucket_count = 16;
+    while (bucket_count < package_count * 2) {
+        bucket_count *= 2;
+    }
+
+    CatalogHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = CATALOG_MAGIC;
+    header.format_version = CATALOG_FORMAT_VERSION;
+    header.package_count = package_count;
+    header.version_count = unique;
+    header.bucket_count = bucket_count;
+    header.directory_offset = sizeof(CatalogHeader);
+    header.packages_offset = header.directory_offset + bucket_count * sizeof(unsigned int);
+    header.versions_offset = header.packages_offset + package_count * sizeof(CatalogPackage);
+    header.strings_offset = header.versions_offset + unique * sizeof(CatalogVersion);
+
+    unsigned int* directory = calloc(bucket_count, sizeof(unsigned int));
+    CatalogPackage* packages = calloc(package_count + 1, sizeof(CatalogPackage));
+    CatalogVersion* versions = calloc(unique + 1, sizeof(CatalogVersion));
+    char* strings = calloc(strings_size, sizeof(char));
+    if (directory == NULL || packages == NULL || versions == NULL || strings == NULL) {
+        free(directory);
+        free(packages);
+        free(versions);
+        free(strings);
+        return SEMVER_OUT_OF_MEMORY;
+    }
+
+    unsigned int used = 1;
+    int pkg = -1;
+    for (int i = 0; i < unique; i++) {
+        CatalogEntry* e = &builder->entries[i];
+        if (pkg < 0 || strcmp(builder->entries[i - 1].package, e->package) != 0) {
+            pkg++;
+            packages[pkg].name_offset = pool_add(strings, &used, e->package, strlen(e->package));
+            packages[pkg].name_hash = name_hash(e->package);
+            packages[pkg].first_version = i;
+
+            unsigned int bucket = packages[pkg].name_hash & (bucket_count - 1);
+            while (directory[bucket] != 0) {
+                bucket = (bucket + 1) & (bucket_count - 1);
+            }
+            directory[bucket] = pkg + 1;
+        }
+        packages[pkg].version_count++;
+
+        CatalogVersion* v = &versions[i];
+        v->major = e->version.major;
+        v->minor = e->version.minor;
+        v->patch = e->version.patch;
+        v->prerelease = (unsigned char)e->version.prerelease;
+        v->prerelease_offset = pool_add(strings, &used, e->version.prerelease_str,
+                strlen(e->version.prerelease_str));
+        v->build_offset = pool_add(strings, &used, e->version.build_str,
+                strnlen(e->version.build_str, MAX_BUILD_LEN));
+    }
+
+    header.strings_size = align4(used);
+    header.file_size = header.strings_offset + header.strings_size;
+
+    int res = SEMVER_OK;
+    FILE* f = fopen(path, "wb");
+    if (f == NULL) {
+        res = SEMVER_IO_ERROR;
+    } else {
+        static const char padding[4] = { 0, 0, 0, 0 };
+        if (fwrite(&header, sizeof(header), 1, f) != 1 ||
+            fwrite(directory, sizeof(unsigned int), bucket_count, f) != bucket_count ||
+            fwrite(packages, sizeof(CatalogPackage), package_count, f) != package_count ||
+            fwrite(versions, sizeof(CatalogVersion), unique, f) != (size_t)unique ||
+            fwrite(strings, 1, used, f) != used ||
+            fwrite(padding, 1, header.strings_size - used, f) != header.strings_size - used) {
+            res = SEMVER_IO_ERROR;
+        }
+        if (fclose(f) != 0) {
+            res = SEMVER_IO_ERROR;
+        }
+    }
+
+    free(directory);
+    free(packages);
+    free(versions);
+    free(strings);
+
+    return res;
+}
+
+static int validate_catalog(VersionCatalog* catalog) {
+    if (catalog->size < sizeof(CatalogHeader)) {
+        return SEMVER_INVALID_CATALOG;
+    }
+
+    const CatalogHeader* h = (const CatalogHeader*)catalog->data;
+    if (h->magic != CATALOG_MAGIC || h->format_version != CATALOG_FORMAT_VERSION ||
+        h->file_size != catalog->size) {
+        return SEMVER_INVALID_CATALOG;
+    }
+
+    /* sections must follow each other and fit the file */
+    unsigned long long dir_end = (unsigned long long)h->directory_offset +
+        (unsigned long long)h->bucket_count * sizeof(unsigned int);
+    unsigned long long pkg_end = (unsigned long long)h->packages_offset +
+        (unsigned long long)h->package_count * sizeof(CatalogPackage);
+    unsigned long long ver_end = (unsigned long long)h->versions_offset +
+        (unsigned long long)h->version_count * sizeof(CatalogVersion);
+    unsigned long long str_end = (unsigned long long)h->strings_offset + h->strings_size;
+
+    if (h->directory_offset < sizeof(CatalogHeader) || dir_end > h->packages_offset ||
+        pkg_end > h->versions_offset || ver_end > h->strings_offset || str_end > catalog->size ||
+        h->strings_size == 0 || (h->directory_offset & 3) != 0 || (h->packages_offset & 3) != 0 ||
+        (h->versions_offset & 3) != 0 || h->bucket_count == 0 ||
+        (h->bucket_count & (h->bucket_count - 1)) != 0 || h->bucket_count < h->package_count) {
+        return SEMVER_INVALID_CATALOG;
+    }
+
+    catalog->header = h;
+    catalog->directory = (const unsigned int*)(catalog->data + h->directory_offset);
+    catalog->packages = (const CatalogPackage*)(catalog->data + h->packages_offset);
+    catalog->versions = (const CatalogVersion*)(catalog->data + h->versions_offset);
+    catalog->strings = (const char*)(catalog->data + h->strings_offset);
+
+    if (catalog->strings[h->strings_size - 1] != '\0') {
+        return SEMVER_INVALID_CATALOG;
+    }
+
+    for (unsigned int i = 0; i < h->bucket_count; i++) {
+        if (catalog->directory[i] > h->package_count) {
+            return SEMVER_INVALID_CATALOG;
+        }
+    }
+    for (unsigned int i = 0; i < h->package_count; i++) {
+        const CatalogPackage* p = &catalog->packages[i];
+        if (p->name_offset >= h->strings_size ||
+            (unsigned long long)p->first_version + p->version_count > h->version_count) {
+            return SEMVER_INVALID_CATALOG;
+        }
+    }
+
+    return SEMVER_OK;
+}
+
+int open_version_catalog(const char* path, VersionCatalog** catalog) {
+    if (path == NULL || catalog == NULL) {
+        return SEMVER_IO_ERROR;
+    }
+    *catalog = NULL;
+
+    VersionCatalog* cat = calloc(1, sizeof(VersionCatalog));
+    if (cat == NULL) {
+        return SEMVER_OUT_OF_MEMORY;
+    }
+
+#ifdef _WIN32
+    FILE* f = fopen(path, "rb");
+    if (f == NULL) {
+        free(cat);
+        return SEMVER_IO_ERROR;
+    }
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    unsigned char* data = (size > 0 && size < UINT_MAX) ? malloc(size) : NULL;
+    if (data == NULL || fread(data, 1, size, f) != (size_t)size) {
+        free(data);
+        fclose(f);
+        free(cat);
+        return data == NULL ? SEMVER_OUT_OF_MEMORY : SEMVER_IO_ERROR;
+    }
+    fclose(f);
+    cat->data = data;
+    cat->size = (unsigned int)size;
+    cat->mapped = 0;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        free(cat);
+        return SEMVER_IO_ERROR;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0 || (unsigned long long)st.st_size >= UINT_MAX) {
+        close(fd);
+        free(cat);
+        return SEMVER_IO_ERROR;
+    }
+    void* data = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        free(cat);
+        return SEMVER_IO_ERROR;
+    }
+    cat->data = data;
+    cat->size = (unsigned int)st.st_size;
+    cat->mapped = 1;
+#endif
+
+    int res = validate_catalog(cat);
+    if (res != SEMVER_OK) {
+        close_version_catalog(&cat);
+        return res;
+    }
+
+    *catalog = cat;
+    return SEMVER_OK;
+}
+
+void close_version_catalog(VersionCatalog** catalog) {
+    if (catalog == NULL || *catalog == NULL) {
+        return;
+    }
+
+#ifdef _WIN32
+    free((void*)(*catalog)->data);
+#else
+    if ((*catalog)->mapped) {
+        munmap((void*)(*catalog)->data, (*catalog)->size);
+    } else {
+        free((void*)(*catalog)->data);
+    }
+#endif
+    free(*catalog);
+
+    *catalog = NULL;
+}
+
+static const CatalogPackage* get_package(const VersionCatalog* catalog, int pkg) {
+    if (catalog == NULL || pkg < 0 || (unsigned int)pkg >= catalog->header->package_count) {
+        return NULL;
+    }
+    return &catalog->packages[pkg];
+}
+
+/* Returns a string from the pool. Broken offsets give an empty string */
+static const char* pool_string(const VersionCatalog* catalog, unsigned int offset) {
+    if (offset >= catalog->header->strings_size) {
+        return "";
+    }
+    return catalog->strings + offset;
+}
+
+int catalog_find_package(const VersionCatalog* catalog, const char* package) {
+    if (catalog == NULL || package == NULL) {
+        return -1;
+    }
+
+    unsigned int hash = name_hash(package);
+    unsigned int mask = catalog->header->bucket_count - 1;
+    unsigned int bucket = hash & mask;
+
+    for (unsigned int probe = 0; probe < catalog->header->bucket_count; probe++) {
+        unsigned int idx = catalog->directory[bucket];
+        if (idx == 0) {
+            break;
+        }
+        const CatalogPackage* p = &catalog->packages[idx - 1];
+        if (p->name_hash == hash && strcmp(pool_string(catalog, p->name_offset), package) == 0) {
+            return idx - 1;
+        }
+        bucket = (bucket + 1) & mask;
+    }
+
+    return -1;
+}
+
+const char* catalog_package_name(const VersionCatalog* catalog, int pkg) {
+    const CatalogPackage* p = get_package(catalog, pkg);
+    if (p == NULL) {
+        return NULL;
+    }
+    return pool_string(catalog, p->name_offset);
+}
+
+int catalog_version_count(const VersionCatalog* catalog, int pkg) {
+    const CatalogPackage* p = get_package(catalog, pkg);
+    if (p == NULL) {
+        return 0;
+    }
+    return p->version_count;
+}
+
+static void unpack_version(const VersionCatalog* catalog, const CatalogVersion* packed, SemVersion* version) {
+    memset(version, 0, sizeof(SemVersion));
+    version->major = packed->major;
+    version->minor = packed->minor;
+    version->patch = packed->patch;
+    version->prerelease = packed->prerelease <= PRERELEASE_NONE ? packed->prerelease : PRERELEASE_NONE;
+    strncpy(version->prerelease_str, pool_string(catalog, packed->prerelease_offset), MAX_PRERELEASE_LEN - 1);
+    strncpy(version->build_str, pool_string(catalog, packed->build_offset), MAX_BUILD_LEN);
+}
+
+/* Compares a packed version with the given one without unpacking it
+ * unless numeric parts are equal
+ */
+static int compare_packed(const VersionCatalog* catalog, const CatalogVersion* packed, const SemVersion* version) {
+    if (packed->major != version->major) {
+        return packed->major > version->major ? 1 : -1;
+    }
+    if (packed->minor != version->minor) {
+        return packed->minor > version->minor ? 1 : -1;
+    }
+    if (packed->patch != version->patch) {
+        return packed->patch > version->patch ? 1 : -1;
+    }
+    if (packed->prerelease == PRERELEASE_NONE && version->prerelease == PRERELEASE_NONE) {
+        return 0;
+    }
+
+    SemVersion tmp;
+    unpack_version(catalog, packed, &tmp);
+    return compare_versions(&tmp, version);
+}
+
+int catalog_get_version(const VersionCatalog* catalog, int pkg, int idx, SemVersion* version) {
+    const CatalogPackage* p = get_package(catalog, pkg);
+    if (p == NULL || version == NULL || idx < 0 || (unsigned int)idx >= p->version_count) {
+        return SEMVER_OUT_OF_RANGE;
+    }
+
+    unpack_version(catalog, &catalog->versions[p->first_version + idx], version);
+    return SEMVER_OK;
+}
+
+/* Versions of a package for the sorted search */
+typedef struct package_versions_t {
+    const VersionCatalog* catalog;
+    const CatalogVersion* base;
+} PackageVersions;
+
+static int compare_at(const void* array, int idx, const SemVersion* version) {
+    const PackageVersions* pv = array;
+    return compare_packed(pv->catalog, &pv->base[idx], version);
+}
+
+int catalog_lower_bound(const VersionCatalog* catalog, int pkg, const SemVersion* version) {
+    const CatalogPackage* p = get_package(catalog, pkg);
+    if (p == NULL || version == NULL) {
+        return -1;
+    }
+
+    PackageVersions pv = { catalog, &catalog->versions[p->first_version] };
+    return sorted_bound(&pv, (int)p->version_count, compare_at, version, 0);
+}
+
+int catalog_contains(const VersionCatalog* catalog, int pkg, const SemVersion* version) {
+    int idx = catalog_lower_bound(catalog, pkg, version);
+    if (idx < 0 || idx >= catalog_version_count(catalog, pkg)) {
+        return 0;
+    }
+
+    const CatalogPackage* p = get_package(catalog, pkg);
+    return compare_packed(catalog, &catalog->versions[p->first_version + idx], version) == 0;
+}
+
+int catalog_max_satisfying(const VersionCatalog* catalog, int pkg, const char* version_list,
+        SemVersion* version) {
+    const CatalogPackage* p = get_package(catalog, pkg);
+    if (p == NULL || version_list == NULL) {
+        return -1;
+    }
+
+    PackageVersions pv = { catalog, &catalog->versions[p->first_version] };
+    int best = sorted_max_satisfying(&pv, (int)p->version_count, compare_at, version_list);
+    if (best >= 0 && version != NULL) {
+        unpack_version(catalog, &pv.base[best], version);
+    }
+    return best;
+}
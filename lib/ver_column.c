@@ -0,0 +1,531 @@
+#include <string.h>
+#include <stdlib.h>
+
+#include "semver.h"
+#include "ver_column.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#define STRING_SIZE (MAX_PRERELEASE_LEN + MAX_BUILD_LEN)
+#define INITIAL_CAPACITY 64
+
+VersionColumn* init_version_column() {
+    return calloc(1, sizeof(VersionColumn));
+}
+
+void free_version_column(VersionColumn** column) {
+    if (column == NULL || *column == NULL) {
+        return;
+    }
+
+    VersionColumn* col = *column;
+    free(col->major);
+    free(col->minor);
+    free(col->patch);
+    free(col->prerelease);
+    free(col->str_id);
+    free(col->strings);
+    free(col->string_table);
+    free(col);
+    *column = NULL;
+}
+
+static int grow_rows(VersionColumn* col) {
+    int capacity = col->capacity == 0 ? INITIAL_CAPACITY : col->capacity * 2;
+
+    unsigned int* major = realloc(col->major, capacity * sizeof(unsigned int));
+    if (major == NULL) {
+        return 0;
+    }
+    col->major = major;
+    unsigned int* minor = realloc(col->minor, capacity * sizeof(unsigned int));
+    if (minor == NULL) {
+        return 0;
+    }
+    col->minor = minor;
+    unsigned int* patch = realloc(col->patch, capacity * sizeof(unsigned int));
+    if (patch == NULL) {
+        return 0;
+    }
+    col->patch = patch;
+    unsigned char* prerelease = realloc(col->prerelease, capacity);
+    if (prerelease == NULL) {
+        return 0;
+    }
+    col->prerelease = prerelease;
+    unsigned int* str_id = realloc(col->str_id, capacity * sizeof(unsigned int));
+    if (str_id == NULL) {
+        return 0;
+    }
+    col->str_id = str_id;
+
+    col->capacity = capacity;
+    return 1;
+}
+
+/* FNV-1a */
+static unsigned int string_hash(const char* str) {
+    unsigned int hash = 2166136261u;
+    for (int i = 0; i < STRING_SIZE; i++) {
+        hash ^= (unsigned char)str[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static int rehash_strings(VersionColumn* col, int size) {
+    int* table = calloc(size, sizeof(int));
+    if (table == NULL) {
+        return 0;
+    }
+
+    for (int id = 0; id < col->string_count; id++) {
+        unsigned int slot = string_hash(col->strings[id]) & (size - 1);
+        while (table[slot] != 0) {
+            slot = (slot + 1) & (size - 1);
+        }
+        table[slot] = id + 1;
+    }
+
+    free(col->string_table);
+    col->string_table = table;
+    col->table_size = size;
+    return 1;
+}
+
+/* Returns the id of the version strings, adds them if they are new.
+ * Returns -1 if there is no memory
+ */
+static int intern_strings(VersionColumn* col, const SemVersion* version) {
+    char str[STRING_SIZE];
+    memset(str, 0, sizeof(str));
+    strncpy(str, version->prerelease_str, MAX_PRERELEASE_LEN);
+    strncpy(str + MAX_PRERELEASE_LEN, version->build_str, MAX_BUILD_LEN);
+
+    if (col->string_table == NULL) {
+        if (col->strings == NULL) {
+            col->strings = calloc(INITIAL_CAPACITY, STRING_SIZE);
+            if (col->strings == NULL) {
+                return -1;
+            }
+            col->string_capacity = INITIAL_CAPACITY;
+            /* id 0 is always empty strings */
+            col->string_count = 1;
+        }
+        if (! rehash_strings(col, INITIAL_CAPACITY * 2)) {
+            return -1;
+        }
+    }
+
+    unsigned int mask = col->table_size - 1;
+    unsigned int slot = string_hash(str) & mask;
+    while (col->string_table[slot] != 0) {
+        int id = col->string_table[slot] - 1;
+        if (memcmp(col->strings[id], str, STRING_SIZE) == 0) {
+            return id;
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    if (col->string_count == col->string_capacity) {
+        int capacity = col->string_capacity * 2;
+        char (*strings)[STRING_SIZE] = realloc(col->strings, (size_t)capacity * STRING_SIZE);
+        if (strings == NULL) {
+            return -1;
+        }
+        col->strings = strings;
+        col->string_capacity = capacity;
+    }
+
+    int id = col->string_count++;
+    memcpy(col->strings[id], str, STRING_SIZE);
+    /* the table is kept at most half full */
+    if (col->string_count * 2 > col->table_size) {
+        if (! rehash_strings(col, col->table_size * 2)) {
+            col->string_count--;
+            return -1;
+        }
+    } else {
+        col->string_table[slot] = id + 1;
+    }
+
+    return id;
+}
+
+static int store_row(VersionColumn* col, int idx, const SemVersion* version) {
+    int id = intern_strings(col, version);
+    if (id < 0) {
+        return SEMVER_OUT_OF_MEMORY;
+    }
+
+    col->major[idx] = version->major;
+    col->minor[idx] = version->minor;
+    col->patch[idx] = version->patch;
+    col->prerelease[idx] = (unsigned char)version->prerelease;
+    col->str_id[idx] = id;
+    return SEMVER_OK;
+}
+
+int version_column_append(VersionColumn* column, const SemVersion* version) {
+    if (column == NULL || version == NULL) {
+        return SEMVER_INVALID_VERSION;
+    }
+    if (column->count == column->capacity && ! grow_rows(column)) {
+        return SEMVER_OUT_OF_MEMORY;
+    }
+
+    int res = store_row(column, column->count, version);
+    if (res == SEMVER_OK) {
+        column->count++;
+    }
+    return res;
+}
+
+static void load_row(const VersionColumn* col, int idx, SemVersion* version) {
+    memset(version, 0, sizeof(SemVersion));
+    version->major = col->major[idx];
+    version->minor = col->minor[idx];
+    version->patch = col->patch[idx];
+    version->prerelease = col->prerelease[idx];
+    version->cmp = COMPARE_NONE;
+    if (col->str_id[idx] != 0) {
+        const char* str = col->strings[col->str_id[idx]];
+        memcpy(version->prerelease_str, str, MAX_PRERELEASE_LEN);
+        memcpy(version->build_str, str + MAX_PRERELEASE_LEN, MAX_BUILD_LEN);
+    }
+}
+
+int version_column_get(const VersionColumn* column, int idx, SemVersion* version) {
+    if (column == NULL || version == NULL || idx < 0 || idx >= column->count) {
+        return SEMVER_INVALID_VERSION;
+    }
+
+    load_row(column, idx, version);
+    return SEMVER_OK;
+}
+
+int version_column_set(VersionColumn* column, int idx, const SemVersion* version) {
+    if (column == NULL || version == NULL || idx < 0 || idx >= column->count) {
+        return SEMVER_INVALID_VERSION;
+    }
+
+    return store_row(column, idx, version);
+}
+
+int version_column_gather(const VersionColumn* column, const int* indices, int count, SemVersion* versions) {
+    if (column == NULL || (count > 0 && (indices == NULL || versions == NULL))) {
+        return SEMVER_INVALID_VERSION;
+    }
+
+    for (int i = 0; i < count; i++) {
+        if (indices[i] < 0 || indices[i] >= column->count) {
+            return SEMVER_INVALID_VERSION;
+        }
+        load_row(column, indices[i], &versions[i]);
+    }
+    return SEMVER_OK;
+}
+
+int version_column_scatter(VersionColumn* column, const int* indices, int count, const SemVersion* versions) {
+    if (column == NULL || (count > 0 && (indices == NULL || versions == NULL))) {
+        return SEMVER_INVALID_VERSION;
+    }
+
+    for (int i = 0; i < count; i++) {
+        if (indices[i] < 0 || indices[i] >= column->count) {
+            return SEMVER_INVALID_VERSION;
+        }
+        int res = store_row(column, indices[i], &versions[i]);
+        if (res != SEMVER_OK) {
+            return res;
+        }
+    }
+    return SEMVER_OK;
+}
+
+/* Compares a row with a version the same way compare_versions does */
+static int compare_row(const VersionColumn* col, int idx, const SemVersion* version) {
+    if (col->major[idx] != version->major) {
+        return col->major[idx] > version->major ? 1 : -1;
+    }
+    if (col->minor[idx] != version->minor) {
+        return col->minor[idx] > version->minor ? 1 : -1;
+    }
+    if (col->patch[idx] != version->patch) {
+        return col->patch[idx] > version->patch ? 1 : -1;
+    }
+    if (col->prerelease[idx] != version->prerelease) {
+        return col->prerelease[idx] > version->prerelease ? 1 : -1;
+    }
+    if (version->prerelease == PRERELEASE_NONE) {
+        return 0;
+    }
+
+    SemVersion row;
+    load_row(col, idx, &row);
+    return compare_versions(&row, version);
+}
+
+static int row_fits(const VersionColumn* col, int idx, const SemVersion* lower, const SemVersion* upper) {
+    if (lower != NULL) {
+        int cmp = compare_row(col, idx, lower);
+        if (cmp < 0 || (cmp == 0 && lower->cmp == COMPARE_GREATER)) {
+            return 0;
+        }
+    }
+    if (upper != NULL) {
+        int cmp = compare_row(col, idx, upper);
+        if (cmp > 0 || (cmp == 0 && upper->cmp == COMPARE_LESS)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+#ifdef __SSE2__
+
+/* Unsigned numbers are compared as signed ones after flipping the sign bit */
+#define SIGN_BIT ((int)0x80000000u)
+
+static __m128i load_biased(const unsigned int* p) {
+    return _mm_xor_si128(_mm_loadu_si128((const __m128i*)p), _mm_set1_epi32(SIGN_BIT));
+}
+
+static __m128i bias(unsigned int value) {
+    return _mm_set1_epi32((int)(value ^ 0x80000000u));
+}
+
+/* Compares 4 rows with a version by major, minor, and patch: gt gets
+ * lanes where a row is greater, eq - lanes where they are equal
+ */
+static void compare_numbers(const VersionColumn* col, int idx, const SemVersion* version, __m128i* gt, __m128i* eq) {
+    __m128i major = load_biased(col->major + idx);
+    __m128i minor = load_biased(col->minor + idx);
+    __m128i patch = load_biased(col->patch + idx);
+    __m128i v_major = bias(version->major);
+    __m128i v_minor = bias(version->minor);
+    __m128i v_patch = bias(version->patch);
+
+    __m128i eq_major = _mm_cmpeq_epi32(major, v_major);
+    __m128i eq_minor = _mm_cmpeq_epi32(minor, v_minor);
+    __m128i eq_patch = _mm_cmpeq_epi32(patch, v_patch);
+    __m128i gt_patch = _mm_cmpgt_epi32(patch, v_patch);
+    __m128i gt_minor = _mm_or_si128(_mm_cmpgt_epi32(minor, v_minor), _mm_and_si128(eq_minor, gt_patch));
+    *gt = _mm_or_si128(_mm_cmpgt_epi32(major, v_major), _mm_and_si128(eq_major, gt_minor));
+    *eq = _mm_and_si128(eq_major, _mm_and_si128(eq_minor, eq_patch));
+}
+
+/* Returns a 4-bit mask of rows that surely fit and stores a mask of rows
+ * that must be checked with row_fits
+ */
+static int filter4(const VersionColumn* col, int idx, const SemVersion* lower, const SemVersion* upper, int* unsure) {
+    __m128i sure = _mm_set1_epi32(-1);
+    __m128i maybe = _mm_setzero_si128();
+
+    if (lower != NULL) {
+        __m128i gt, eq;
+        compare_numbers(col, idx, lower, &gt, &eq);
+        maybe = _mm_or_si128(maybe, _mm_and_si128(sure, eq));
+        sure = gt;
+    }
+    if (upper != NULL) {
+        __m128i gt, eq;
+        compare_numbers(col, idx, upper, &gt, &eq);
+        __m128i lt = _mm_andnot_si128(_mm_or_si128(gt, eq), _mm_set1_epi32(-1));
+        /* rows equal to upper by numbers and fitting lower surely or maybe */
+        maybe = _mm_or_si128(_mm_and_si128(maybe, _mm_or_si128(lt, eq)), _mm_and_si128(sure, eq));
+        sure = _mm_and_si128(sure, lt);
+    }
+
+    *unsure = _mm_movemask_ps(_mm_castsi128_ps(maybe));
+    return _mm_movemask_ps(_mm_castsi128_ps(sure));
+}
+
+#endif
+
+static int run_filter(const VersionColumn* col, int begin, int end,
+        const SemVersion* lower, const SemVersion* upper, int* indices) {
+    if (col == NULL || begin < 0 || end > col->count || begin > end) {
+        return -1;
+    }
+    if ((lower != NULL && lower->cmp != COMPARE_GREATER && lower->cmp != COMPARE_GREATEROREQUAL) ||
+        (upper != NULL && upper->cmp != COMPARE_LESS && upper->cmp != COMPARE_LESSOREQUAL)) {
+        return -1;
+    }
+
+    int found = 0;
+    int i = begin;
+#ifdef __SSE2__
+    for (; i + 4 <= end; i += 4) {
+        int unsure;
+        int mask = filter4(col, i, lower, upper, &unsure);
+        for (int lane = 0; unsure != 0; lane++, unsure >>= 1) {
+            if ((unsure & 1) && row_fits(col, i + lane, lower, upper)) {
+                mask |= 1 << lane;
+            }
+        }
+        if (indices == NULL) {
+            found += (mask & 1) + ((mask >> 1) & 1) + ((mask >> 2) & 1) + ((mask >> 3) & 1);
+            continue;
+        }
+        for (int lane = 0; mask != 0; lane++, mask >>= 1) {
+            if (mask & 1) {
+                indices[found++] = i + lane;
+            }
+        }
+    }
+#endif
+    for (; i < end; i++) {
+        if (row_fits(col, i, lower, upper)) {
+            if (indices != NULL) {
+                indices[found] = i;
+            }
+            found++;
+        }
+    }
+
+    return found;
+}
+
+int version_column_filter(const VersionColumn* column, int begin, int end,
+        const SemVersion* lower, const SemVersion* upper, int* indices) {
+    if (indices == NULL) {
+        return -1;
+    }
+    return run_filter(column, begin, end, lower, upper, indices);
+}
+
+int version_column_count(const VersionColumn* column, int begin, int end,
+        const SemVersion* lower, const SemVersion* upper) {
+    return run_filter(column, begin, end, lower, upper, NULL);
+}
+
+#ifdef __SSE2__
+
+/* Returns lanes of 4 rows that are stable (if stable_only is set) and
+ * have the given major, minor, and patch (if they are not NULL)
+ */
+static __m128i rows_mask(const VersionColumn* col, int idx, int stable_only,
+        const unsigned int* major, const unsigned int* minor, const unsigned int* patch) {
+    __m128i mask = _mm_set1_epi32(-1);
+    if (stable_only) {
+        int ranks;
+        memcpy(&ranks, col->prerelease + idx, sizeof(ranks));
+        __m128i r = _mm_cvtsi32_si128(ranks);
+        r = _mm_unpacklo_epi16(_mm_unpacklo_epi8(r, _mm_setzero_si128()), _mm_setzero_si128());
+        mask = _mm_cmpeq_epi32(r, _mm_set1_epi32(PRERELEASE_NONE));
+    }
+    if (major != NULL) {
+        mask = _mm_and_si128(mask, _mm_cmpeq_epi32(load_biased(col->major + idx), bias(*major)));
+    }
+    if (minor != NULL) {
+        mask = _mm_and_si128(mask, _mm_cmpeq_epi32(load_biased(col->minor + idx), bias(*minor)));
+    }
+    if (patch != NULL) {
+        mask = _mm_and_si128(mask, _mm_cmpeq_epi32(load_biased(col->patch + idx), bias(*patch)));
+    }
+    return mask;
+}
+
+#endif
+
+static int row_selected(const VersionColumn* col, int idx, int stable_only,
+        const unsigned int* major, const unsigned int* minor, const unsigned int* patch) {
+    return (! stable_only || col->prerelease[idx] == PRERELEASE_NONE) &&
+        (major == NULL || col->major[idx] == *major) &&
+        (minor == NULL || col->minor[idx] == *minor) &&
+        (patch == NULL || col->patch[idx] == *patch);
+}
+
+/* Finds the maximum of values over rows in [begin, end) that are stable
+ * (if stable_only is set) and have the given major (if major is not NULL)
+ * and minor (if minor is not NULL). Returns 0 if there are no such rows
+ */
+static int masked_max(const VersionColumn* col, int begin, int end, int stable_only,
+        const unsigned int* values, const unsigned int* major, const unsigned int* minor, unsigned int* max) {
+    int found = 0;
+    unsigned int best = 0;
+    int i = begin;
+
+#ifdef __SSE2__
+    __m128i vmax = _mm_set1_epi32(SIGN_BIT);
+    __m128i any = _mm_setzero_si128();
+    for (; i + 4 <= end; i += 4) {
+        __m128i mask = rows_mask(col, i, stable_only, major, minor, NULL);
+        /* rows out of the mask get the smallest value */
+        __m128i v = _mm_or_si128(_mm_and_si128(mask, load_biased(values + i)),
+                _mm_andnot_si128(mask, _mm_set1_epi32(SIGN_BIT)));
+        __m128i greater = _mm_cmpgt_epi32(v, vmax);
+        vmax = _mm_or_si128(_mm_and_si128(greater, v), _mm_andnot_si128(greater, vmax));
+        any = _mm_or_si128(any, mask);
+    }
+
+    if (_mm_movemask_ps(_mm_castsi128_ps(any)) != 0) {
+        unsigned int lanes[4];
+        _mm_storeu_si128((__m128i*)lanes, vmax);
+        found = 1;
+        for (int lane = 0; lane < 4; lane++) {
+            unsigned int value = lanes[lane] ^ 0x80000000u;
+            if (value > best) {
+                best = value;
+            }
+        }
+    }
+#endif
+
+    for (; i < end; i++) {
+        if (! row_selected(col, i, stable_only, major, minor, NULL)) {
+            continue;
+        }
+        if (! found || values[i] > best) {
+            best = values[i];
+        }
+        found = 1;
+    }
+
+    *max = best;
+    return found;
+}
+
+int version_column_argmax(const VersionColumn* column, int begin, int end, int stable_only) {
+    if (column == NULL || begin < 0 || end > column->count || begin >= end) {
+        return -1;
+    }
+
+    /* at first find the greatest major, minor, and patch, then compare
+     * only rows that have them
+     */
+    unsigned int major, minor, patch;
+    if (! masked_max(column, begin, end, stable_only, column->major, NULL, NULL, &major)) {
+        return -1;
+    }
+    masked_max(column, begin, end, stable_only, column->minor, &major, NULL, &minor);
+    masked_max(column, begin, end, stable_only, column->patch, &major, &minor, &patch);
+
+    int best = -1;
+    SemVersion best_ver;
+    int i = begin;
+#ifdef __SSE2__
+    for (; i + 4 <= end; i += 4) {
+        __m128i mask = rows_mask(column, i, stable_only, &major, &minor, &patch);
+        int lanes = _mm_movemask_ps(_mm_castsi128_ps(mask));
+        for (int lane = 0; lanes != 0; lane++, lanes >>= 1) {
+            if ((lanes & 1) && (best == -1 || compare_row(column, i + lane, &best_ver) > 0)) {
+                best = i + lane;
+                load_row(column, best, &best_ver);
+            }
+        }
+    }
+#endif
+    for (; i < end; i++) {
+        if (row_selected(column, i, stable_only, &major, &minor, &patch) &&
+            (best == -1 || compare_row(column, i, &best_ver) > 0)) {
+            best = i;
+            load_row(column, i, &best_ver);
+        }
+    }
+
+    return best;
+}
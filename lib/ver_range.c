@@ -2,9 +2,15 @@
 
 #include "semver.h"
 #include "ver_range.h"
+#include "semver_stats_hooks.h"
+#include "semver_probes.h"
 
 VersionRange* init_version_range() {
     VersionRange* range = calloc(1, sizeof(VersionRange));
+    if (range != NULL) {
+        STATS_COUNT(STATS_RANGE_NODES, 1);
+        STATS_COUNT(STATS_ALLOCATIONS, 1);
+    }
     return range;
 }
 
@@ -25,7 +31,7 @@ void free_version_range(VersionRange** range) {
     *range = NULL;
 }
 
-VersionRange* add_version(VersionRange* range, SemVersion* version, int as_new) {
+static VersionRange* add_version_impl(VersionRange* range, SemVersion* version, int as_new) {
     if (version == NULL || range == NULL) {
         return NULL;
     }
@@ -47,6 +53,7 @@ VersionRange* add_version(VersionRange* range, SemVersion* version, int as_new)
                 if (tmp->min_ver == NULL) {
                     return NULL;
                 }
+                STATS_COUNT(STATS_ALLOCATIONS, 1);
                 *tmp->min_ver = *version;
                 return tmp;
             } else if (tmp->max_ver == NULL && (version->cmp == COMPARE_LESSOREQUAL || version->cmp == COMPARE_LESS)) {
@@ -54,6 +61,7 @@ VersionRange* add_version(VersionRange* range, SemVersion* version, int as_new)
                 if (tmp->max_ver == NULL) {
                     return NULL;
                 }
+                STATS_COUNT(STATS_ALLOCATIONS, 1);
                 *tmp->max_ver = *version;
                 return tmp;
             }
@@ -71,6 +79,8 @@ VersionRange* add_version(VersionRange* range, SemVersion* version, int as_new)
         if (new_range == NULL) {
             return NULL;
         }
+        STATS_COUNT(STATS_RANGE_NODES, 1);
+        STATS_COUNT(STATS_ALLOCATIONS, 1);
         last_range->next = new_range;
     }
 
@@ -78,6 +88,7 @@ VersionRange* add_version(VersionRange* range, SemVersion* version, int as_new)
     if (clone == NULL) {
         return NULL;
     }
+    STATS_COUNT(STATS_ALLOCATIONS, 1);
     *clone = *version;
 
     if (version->cmp == COMPARE_GREATER || version->cmp == COMPARE_GREATEROREQUAL) {
@@ -89,7 +100,7 @@ VersionRange* add_version(VersionRange* range, SemVersion* version, int as_new)
     return new_range;
 }
 
-int complete_version_range(VersionRange* item, SemVersion* version) {
+static int complete_version_range_impl(VersionRange* item, SemVersion* version) {
     if (item == NULL) {
         return SEMVER_INVALID_RANGE_ITEM;
     }
@@ -109,6 +120,7 @@ int complete_version_range(VersionRange* item, SemVersion* version) {
     if (clone == NULL) {
         return SEMVER_OUT_OF_MEMORY;
     }
+    STATS_COUNT(STATS_ALLOCATIONS, 1);
     *clone = *version;
 
     if (version->cmp == COMPARE_GREATER || version->cmp == COMPARE_GREATEROREQUAL) {
@@ -120,6 +132,27 @@ int complete_version_range(VersionRange* item, SemVersion* version) {
     return SEMVER_OK;
 }
 
+DEFINE_PROBE(add_version_entry);
+DEFINE_PROBE(add_version_return);
+DEFINE_PROBE(complete_version_range_entry);
+DEFINE_PROBE(complete_version_range_return);
+
+VersionRange* add_version(VersionRange* range, SemVersion* version, int as_new) {
+    VersionRange* res;
+    FIRE_PROBE2(add_version_entry, version == NULL ? COMPARE_NONE : version->cmp, as_new);
+    STATS_TIMED(STATS_ADD_VERSION, res, add_version_impl(range, version, as_new));
+    FIRE_PROBE2(add_version_return, res != NULL, range_size(range));
+    return res;
+}
+
+int complete_version_range(VersionRange* item, SemVersion* version) {
+    int res;
+    FIRE_PROBE1(complete_version_range_entry, version == NULL ? COMPARE_NONE : version->cmp);
+    STATS_TIMED(STATS_COMPLETE_VERSION_RANGE, res, complete_version_range_impl(item, version));
+    FIRE_PROBE1(complete_version_range_return, res);
+    return res;
+}
+
 int range_size(const VersionRange* range) {
     if (range == NULL) {
         return 0;
@@ -0,0 +1,180 @@
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include "semver.h"
+#include "semver_check.h"
+#include "semver_intern.h"
+#include "semver_adaptive.h"
+
+#include "unittest.h"
+#include "testutils.h"
+
+int tests_run = 0;
+
+#define THREAD_COUNT 4
+#define THREAD_CHECKS 20000
+/* more than one per set of thread-local counters */
+#define COLLIDING_COUNT 48
+
+static const char* lists[] = {
+    ">=1.2.0,<2.0.0", "^1.4.0", "~2.3.1", "1.0.0 - 1.9.9,3.0.0", "!=1.5.0", "*", "<=1.11.0,>=1.14.1",
+    "2.0.0-rc.1 - 2.0.0", ">1.0.0,<1.5.0,>=3.0.0", "1.0.0,^2.0.0", "", "1.0.0-beta.2,1.0.0-beta.10",
+};
+static const char* versions[] = {
+    "1.2.3", "1.5.0", "2.3.4", "0.9.1", "2.0.0-rc.2", "1.17.0", "3.0.0", "1.12.3-beta.31+345", "1.4.0", "1.0.0",
+    "2.5.0", "1.0.0-beta.10",
+};
+
+static const char* hot_list = "1.0.0,1.1.0,1.2.0,^2.0.0,^3.0.0,^4.0.0,^5.0.0";
+
+static char* test_check() {
+    int same = 1;
+    for (int i = 0; i < sizeof(lists) / sizeof(lists[0]); i++) {
+        int error;
+        AdaptiveConstraint* c = compile_adaptive_constraint(lists[i], &error);
+        same &= c != NULL && error == SEMVER_OK;
+        for (int n = 0; n < 3 * ADAPTIVE_PERIOD; n++) {
+            SemVersion ver;
+            const char* v = versions[n % (sizeof(versions) / sizeof(versions[0]))];
+            parse_version(v, &ver);
+            same &= check_adaptive_constraint(c, &ver) == check_version(&ver, lists[i]);
+        }
+        free_adaptive_constraint(&c);
+    }
+    mu_assert("Check as check_version", same);
+
+    int error;
+    mu_assert("Invalid list", compile_adaptive_constraint(">=1.0.0,<<2.0.0", &error) == NULL &&
+            error == SEMVER_INVALID_VERSION_LIST);
+
+    return 0;
+}
+
+static char* test_reorder() {
+    AdaptiveConstraint* c = compile_adaptive_constraint(hot_list, NULL);
+    int order[ADAPTIVE_MAX_TERMS];
+    mu_assert("Terms", adaptive_constraint_order(c, order, ADAPTIVE_MAX_TERMS) == 7);
+    mu_assert("Initial order", order[0] == 0 && order[6] == 6);
+
+    SemVersion ver;
+    parse_version("5.1.0", &ver);
+    for (int i = 0; i < ADAPTIVE_PERIOD; i++) {
+        check_adaptive_constraint(c, &ver);
+    }
+    adaptive_constraint_order(c, order, ADAPTIVE_MAX_TERMS);
+    mu_assert("Hot term goes first", order[0] == 6);
+    mu_assert("Single versions are cheaper", order[1] == 0 && order[2] == 1 && order[3] == 2);
+    mu_assert("Still matches", check_adaptive_constraint(c, &ver) == SEMVER_OK);
+    free_adaptive_constraint(&c);
+
+    ConstraintTable* table = init_constraint_table();
+    unsigned int h;
+    intern_constraint(table, hot_list, &h);
+    const InternedConstraint* interned = get_constraint(table, h);
+    c = create_adaptive_constraint(interned->terms, interned->term_count);
+    mu_assert("From interned list", c != NULL && check_adaptive_constraint(c, &ver) == SEMVER_OK);
+    free_adaptive_constraint(&c);
+    free_constraint_table(&table);
+
+    return 0;
+}
+
+static char* test_colliding() {
+    AdaptiveConstraint* all[COLLIDING_COUNT];
+    for (int i = 0; i < COLLIDING_COUNT; i++) {
+        all[i] = compile_adaptive_constraint(hot_list, NULL);
+    }
+
+    /* ids of the constraints differ by 16, the checks alternate */
+    SemVersion ver;
+    parse_version("5.1.0", &ver);
+    for (int n = 0; n < ADAPTIVE_PERIOD; n++) {
+        for (int i = 0; i < COLLIDING_COUNT; i += 16) {
+            check_adaptive_constraint(all[i], &ver);
+        }
+    }
+
+    int reordered = 1;
+    for (int i = 0; i < COLLIDING_COUNT; i += 16) {
+        int order[ADAPTIVE_MAX_TERMS];
+        adaptive_constraint_order(all[i], order, ADAPTIVE_MAX_TERMS);
+        reordered &= order[0] == 6;
+    }
+    mu_assert("Colliding constraints keep their counters", reordered);
+
+    for (int i = 0; i < COLLIDING_COUNT; i++) {
+        free_adaptive_constraint(&all[i]);
+    }
+    return 0;
+}
+
+typedef struct thread_arg_t {
+    AdaptiveConstraint* c;
+    int seed;
+    int same;
+} ThreadArg;
+
+static void* run_checks(void* data) {
+    ThreadArg* arg = data;
+    unsigned int seed = arg->seed;
+    arg->same = 1;
+    for (int i = 0; i < THREAD_CHECKS; i++) {
+        char str[32];
+        SemVersion ver;
+        /* every thread has its own hot term */
+        unsigned int r = next_random(&seed);
+        snprintf(str, sizeof(str), "%u.%u.0", r % 4 == 0 ? r % 7 : (unsigned)arg->seed + 1, (r >> 4) % 3);
+        parse_version(str, &ver);
+        arg->same &= check_adaptive_constraint(arg->c, &ver) == check_version(&ver, hot_list);
+    }
+    return NULL;
+}
+
+static char* test_threads() {
+    AdaptiveConstraint* c = compile_adaptive_constraint(hot_list, NULL);
+    pthread_t threads[THREAD_COUNT];
+    ThreadArg args[THREAD_COUNT];
+    for (int i = 0; i < THREAD_COUNT; i++) {
+        args[i].c = c;
+        args[i].seed = i + 1;
+        pthread_create(&threads[i], NULL, run_checks, &args[i]);
+    }
+    int same = 1;
+    for (int i = 0; i < THREAD_COUNT; i++) {
+        pthread_join(threads[i], NULL);
+        same &= args[i].same;
+    }
+    mu_assert("Concurrent checks", same);
+
+    int order[ADAPTIVE_MAX_TERMS];
+    int seen = 0;
+    adaptive_constraint_order(c, order, ADAPTIVE_MAX_TERMS);
+    for (int i = 0; i < 7; i++) {
+        seen |= 1 << order[i];
+    }
+    mu_assert("Order is a permutation", seen == 0x7F);
+
+    free_adaptive_constraint(&c);
+    return 0;
+}
+
+static char* all_tests() {
+    mu_run_test("Adaptive check", test_check);
+    mu_run_test("Adaptive reorder", test_reorder);
+    mu_run_test("Adaptive colliding", test_colliding);
+    mu_run_test("Adaptive threads", test_threads);
+    return 0;
+}
+
+int main (int argc, char** argv) {
+    char *result = all_tests();
+     if (result != 0) {
+         printf("%s\n", result);
+     }
+     else {
+         printf("ALL TESTS PASSED\n");
+     }
+     printf("Tests run: %d\n", tests_run);
+
+     return result != 0;
+}
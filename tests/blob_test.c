@@ -0,0 +1,96 @@
+#include <stdio.h>
+#include <string.h>
+#include "semver.h"
+#include "semver_check.h"
+#include "semver_blob.h"
+
+#include "unittest.h"
+
+int tests_run = 0;
+
+static const char* lists[] = {
+    "1.13.3", "1.12.3-beta.31+345,,", "*", "", ">1.11.3", ">=1.12.3", "!=1.12.3-beta.31",
+    ">=1.11.0,<=1.14.1", "<=1.11.0,>=1.14.1", "^1.10.12", "~1.12.1", "~1.14.12",
+    "1.11.1,1.0.1,1.12.3-beta.31+345", "1.12.3-alpha - 1.12.3-beta.40", "1.12.3-alpha - 1.12.3-beta.4",
+    "^1.12.3,1.16.1 - 1.17.0,", "1.16.1 - 1.17.0,0.10.3 - 5.13.9,1.2.15 - 1.2.70",
+    ">1.5.0,>=1.1.0,<1.2.0", ">=1.1.0,>1.5.0,<1.2.0", "1.0.0 - ",
+};
+
+static const char* versions[] = {
+    "1.12.3-beta.31+345", "1.12.3", "1.1.5", "1.6.0", "2.0.0-rc.1", "0.10.3", "1.17.0", "1.12.3-alpha.1",
+};
+
+static char* test_blob_matches_check() {
+    unsigned char blob[1024];
+
+    for (int i = 0; i < sizeof(lists) / sizeof(lists[0]); i++) {
+        size_t size = 0;
+        int res = compile_version_list(lists[i], blob, sizeof(blob), &size);
+        mu_assert("List compiled", res == SEMVER_OK);
+        mu_assert("Blob is valid", validate_version_blob(blob, size) == SEMVER_OK);
+
+        for (int j = 0; j < sizeof(versions) / sizeof(versions[0]); j++) {
+            SemVersion ver;
+            parse_version(versions[j], &ver);
+            mu_assert("Blob check equals check_version",
+                    check_version_blob(&ver, blob, size) == check_version(&ver, lists[i]));
+        }
+    }
+
+    return 0;
+}
+
+static char* test_blob_errors() {
+    unsigned char blob[1024];
+    size_t size = 0;
+
+    int res = compile_version_list("1.0.0,>=2.x.0", blob, sizeof(blob), &size);
+    mu_assert("Invalid list", res == SEMVER_INVALID_VERSION_LIST);
+    res = compile_version_list(NULL, blob, sizeof(blob), &size);
+    mu_assert("NULL list", res == SEMVER_INVALID_VERSION_LIST);
+
+    res = compile_version_list(">=1.0.0,<2.0.0,3.0.0", NULL, 0, &size);
+    mu_assert("Size only", res == SEMVER_BUFFER_TOO_SMALL && size > VERSION_BLOB_HEADER_SIZE);
+    res = compile_version_list(">=1.0.0,<2.0.0,3.0.0", blob, size - 1, &size);
+    mu_assert("Buffer too small", res == SEMVER_BUFFER_TOO_SMALL);
+    res = compile_version_list(">=1.0.0,<2.0.0,3.0.0", blob, size, &size);
+    mu_assert("Exact buffer", res == SEMVER_OK);
+
+    SemVersion ver;
+    parse_version("1.5.0", &ver);
+    mu_assert("Valid blob", validate_version_blob(blob, size) == SEMVER_OK);
+    mu_assert("Truncated blob", validate_version_blob(blob, size - 4) == SEMVER_INVALID_BLOB);
+    mu_assert("Check truncated blob", check_version_blob(&ver, blob, size - 4) == SEMVER_INVALID_BLOB);
+
+    blob[size - 20] ^= 0x5A;
+    mu_assert("Corrupted blob", validate_version_blob(blob, size) == SEMVER_INVALID_BLOB);
+    blob[size - 20] ^= 0x5A;
+
+    blob[VERSION_BLOB_HEADER_SIZE] = 0xFF;
+    mu_assert("Broken term offset", validate_version_blob(blob, size) == SEMVER_INVALID_BLOB);
+    mu_assert("Check broken term offset", check_version_blob(&ver, blob, size) == SEMVER_INVALID_BLOB);
+
+    mu_assert("NULL version", check_version_blob(NULL, blob, size) == SEMVER_INVALID_VERSION);
+    mu_assert("NULL blob", check_version_blob(&ver, NULL, 0) == SEMVER_INVALID_BLOB);
+
+    return 0;
+}
+
+static char* all_tests() {
+    mu_run_test("Blob matches check_version", test_blob_matches_check);
+    mu_run_test("Blob errors", test_blob_errors);
+    return 0;
+}
+
+int main (int argc, char** argv) {
+    char *result = all_tests();
+     if (result != 0) {
+         printf("%s\n", result);
+     }
+     else {
+         printf("ALL TESTS PASSED\n");
+     }
+     printf("Tests run: %d\n", tests_run);
+
+     return result != 0;
+}
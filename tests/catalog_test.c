@@ -0,0 +1,231 @@
+#include <stdio.h>
+#include <string.h>
+#include "semver.h"
+#include "semver_check.h"
+#include "ver_catalog.h"
+
+#include "unittest.h"
+#include "testutils.h"
+
+#define CATALOG_FILE "catalog_test.bin"
+#define RANDOM_VERSIONS 3000
+#define RANDOM_CHECKS 2000
+#define RANDOM_LISTS 2000
+
+int tests_run = 0;
+
+static char* add(CatalogBuilder* builder, const char* package, const char* version) {
+    SemVersion ver;
+    mu_assert("Version parsed", parse_version(version, &ver) == SEMVER_OK);
+    mu_assert("Version added", catalog_builder_add(builder, package, &ver) == SEMVER_OK);
+    return 0;
+}
+
+static char* test_build_catalog() {
+    static const char* versions[][2] = {
+        { "alpha", "1.2.0" }, { "alpha", "1.0.0" }, { "alpha", "1.2.0-beta.2" },
+        { "alpha", "2.0.0-rc.1+b77" }, { "alpha", "1.10.3" }, { "alpha", "1.0.0" },
+        { "beta", "0.1.0" }, { "beta", "0.1.1+build5" }, { "gamma", "3.0.0" },
+    };
+
+    CatalogBuilder* builder = init_catalog_builder();
+    mu_assert("Builder initialized", builder != NULL);
+    for (int i = 0; i < sizeof(versions) / sizeof(versions[0]); i++) {
+        char* msg = add(builder, versions[i][0], versions[i][1]);
+        if (msg != 0) {
+            return msg;
+        }
+    }
+    int res = catalog_builder_write(builder, CATALOG_FILE);
+    mu_assert("Catalog written", res == SEMVER_OK);
+    free_catalog_builder(&builder);
+    mu_assert("Builder freed", builder == NULL);
+
+    return 0;
+}
+
+static char* test_lookup() {
+    VersionCatalog* catalog = NULL;
+    int res = open_version_catalog(CATALOG_FILE, &catalog);
+    mu_assert("Catalog opened", res == SEMVER_OK && catalog != NULL);
+
+    int alpha = catalog_find_package(catalog, "alpha");
+    int beta = catalog_find_package(catalog, "beta");
+    mu_assert("Package alpha found", alpha >= 0);
+    mu_assert("Package beta found", beta >= 0 && beta != alpha);
+    mu_assert("Package name", strcmp(catalog_package_name(catalog, beta), "beta") == 0);
+    mu_assert("Unknown package", catalog_find_package(catalog, "delta") == -1);
+    mu_assert("Duplicates removed", catalog_version_count(catalog, alpha) == 5);
+
+    SemVersion ver, prev;
+    catalog_get_version(catalog, alpha, 0, &prev);
+    for (int i = 1; i < catalog_version_count(catalog, alpha); i++) {
+        catalog_get_version(catalog, alpha, i, &ver);
+        mu_assert("Versions sorted", compare_versions(&prev, &ver) < 0);
+        prev = ver;
+    }
+    mu_assert("Prerelease unpacked", ver.prerelease == PRERELEASE_RC && strcmp(ver.prerelease_str, "rc.1") == 0);
+    mu_assert("Build unpacked", strcmp(ver.build_str, "b77") == 0);
+
+    parse_version("1.2.0", &ver);
+    mu_assert("Contains 1.2.0", catalog_contains(catalog, alpha, &ver));
+    mu_assert("Lower bound 1.2.0", catalog_lower_bound(catalog, alpha, &ver) == 2);
+    parse_version("1.2.0-beta.2+x", &ver);
+    mu_assert("Contains 1.2.0-beta.2", catalog_contains(catalog, alpha, &ver));
+    parse_version("1.2.0-beta.3", &ver);
+    mu_assert("Does not contain 1.2.0-beta.3", ! catalog_contains(catalog, alpha, &ver));
+    parse_version("9.0.0", &ver);
+    mu_assert("Lower bound after all", catalog_lower_bound(catalog, alpha, &ver) == 5);
+
+    int idx = catalog_max_satisfying(catalog, alpha, ">=1.0.0,<1.11.0", &ver);
+    mu_assert("Max satisfying >=1.0.0,<1.11.0", idx == 3 && ver.minor == 10 && ver.patch == 3);
+    idx = catalog_max_satisfying(catalog, alpha, "^1.0.0", &ver);
+    mu_assert("Max satisfying ^1.0.0", idx == 4 && ver.prerelease == PRERELEASE_RC);
+    idx = catalog_max_satisfying(catalog, alpha, "1.0.0 - 1.2.0", NULL);
+    mu_assert("Max satisfying range", idx == 2);
+    idx = catalog_max_satisfying(catalog, beta, ">=1.0.0", NULL);
+    mu_assert("Nothing satisfies", idx == -1);
+
+    close_version_catalog(&catalog);
+    mu_assert("Catalog closed", catalog == NULL);
+
+    return 0;
+}
+
+/* Writes a catalog with a single package "delta" of random versions */
+static char* write_random_catalog(unsigned int* seed) {
+    static SemVersion versions[RANDOM_VERSIONS];
+    random_versions(seed, versions, RANDOM_VERSIONS, 4, 10, 10, RANDOM_BUILDS);
+
+    CatalogBuilder* builder = init_catalog_builder();
+    mu_assert("Random catalog builder initialized", builder != NULL);
+    for (int i = 0; i < RANDOM_VERSIONS; i++) {
+        mu_assert("Random version added", catalog_builder_add(builder, "delta", &versions[i]) == SEMVER_OK);
+    }
+    mu_assert("Random catalog written", catalog_builder_write(builder, CATALOG_FILE) == SEMVER_OK);
+    free_catalog_builder(&builder);
+    return 0;
+}
+
+static char* test_random_lookup() {
+    unsigned int seed = 5;
+    char* msg = write_random_catalog(&seed);
+    if (msg != 0) {
+        return msg;
+    }
+
+    VersionCatalog* catalog = NULL;
+    mu_assert("Random catalog opened", open_version_catalog(CATALOG_FILE, &catalog) == SEMVER_OK);
+    int delta = catalog_find_package(catalog, "delta");
+    int count = catalog_version_count(catalog, delta);
+
+    int same = 1;
+    for (int i = 0; i < RANDOM_CHECKS; i++) {
+        SemVersion ver, cur;
+        random_versions(&seed, &ver, 1, 4, 10, 10, 0);
+        int lower = 0, found = 0;
+        for (int idx = 0; idx < count; idx++) {
+            catalog_get_version(catalog, delta, idx, &cur);
+            int cmp = compare_versions(&cur, &ver);
+            lower += cmp < 0;
+            found |= cmp == 0;
+        }
+        same &= catalog_lower_bound(catalog, delta, &ver) == lower && catalog_contains(catalog, delta, &ver) == found;
+    }
+    mu_assert("Same as comparing every version", same);
+
+    close_version_catalog(&catalog);
+    remove(CATALOG_FILE);
+    return 0;
+}
+
+/* The highest version that meets the list, checked one by one */
+static int reference_max_satisfying(const VersionCatalog* catalog, int pkg, const char* list) {
+    for (int idx = catalog_version_count(catalog, pkg) - 1; idx >= 0; idx--) {
+        SemVersion ver;
+        catalog_get_version(catalog, pkg, idx, &ver);
+        int res = check_version(&ver, list);
+        if (res == SEMVER_OK) {
+            return idx;
+        } else if (res != SEMVER_OUT_OF_RANGE) {
+            return -1;
+        }
+    }
+    return -1;
+}
+
+static char* test_max_satisfying() {
+    static const char* operators[] = { "", "=", "!=", ">", ">=", "<", "<=", "^", "~" };
+    unsigned int seed = 5;
+    char* msg = write_random_catalog(&seed);
+    if (msg != 0) {
+        return msg;
+    }
+
+    VersionCatalog* catalog = NULL;
+    mu_assert("Random catalog opened", open_version_catalog(CATALOG_FILE, &catalog) == SEMVER_OK);
+    int delta = catalog_find_package(catalog, "delta");
+
+    int same = 1;
+    for (int i = 0; i < RANDOM_LISTS; i++) {
+        char list[256] = "";
+        int count = 1 + next_random(&seed) % 4;
+        for (int j = 0; j < count; j++) {
+            char ver[64], item[80];
+            random_version_string(&seed, ver, sizeof(ver), 4, 10, 10, 0);
+            snprintf(item, sizeof(item), "%s%s%s", j == 0 ? "" : (next_random(&seed) % 3 ? "," : " "),
+                    operators[next_random(&seed) % (sizeof(operators) / sizeof(operators[0]))], ver);
+            strcat(list, item);
+        }
+
+        int idx = catalog_max_satisfying(catalog, delta, list, NULL);
+        int expected = reference_max_satisfying(catalog, delta, list);
+        if (idx != expected) {
+            printf("%s: %d, expected %d\n", list, idx, expected);
+            same = 0;
+        }
+    }
+    mu_assert("Same as checking every version", same);
+
+    close_version_catalog(&catalog);
+    remove(CATALOG_FILE);
+    return 0;
+}
+
+static char* test_invalid_catalog() {
+    VersionCatalog* catalog = NULL;
+    FILE* f = fopen(CATALOG_FILE, "wb");
+    mu_assert("Create file", f != NULL);
+    fputs("this is not a catalog, but it is long enough to have a header", f);
+    fclose(f);
+
+    int res = open_version_catalog(CATALOG_FILE, &catalog);
+    mu_assert("Invalid catalog", res == SEMVER_INVALID_CATALOG && catalog == NULL);
+    res = open_version_catalog("no_such_catalog.bin", &catalog);
+    mu_assert("Missing catalog", res == SEMVER_IO_ERROR && catalog == NULL);
+
+    remove(CATALOG_FILE);
+    return 0;
+}
+
+static char* all_tests() {
+    mu_run_test("Building catalog", test_build_catalog);
+    mu_run_test("Catalog lookup", test_lookup);
+    mu_run_test("Catalog random lookup", test_random_lookup);
+    mu_run_test("Catalog max satisfying", test_max_satisfying);
+    mu_run_test("Invalid catalog", test_invalid_catalog);
+    return 0;
+}
+
+int main (int argc, char** argv) {
+    char *result = all_tests();
+     if (result != 0) {
+         printf("%s\n", result);
+     }
+     else {
+         printf("ALL TESTS PASSED\n");
+     }
+     printf("Tests run: %d\n", tests_run);
+
+     return result != 0;
+}
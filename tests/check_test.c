@@ -0,0 +1,226 @@
+#include <stdio.h>
+#include <string.h>
+#include "semver.h"
+#include "semver_check.h"
+
+#include "unittest.h"
+#include "testutils.h"
+
+int tests_run = 0;
+
+#define LIST_COUNT 3000
+#define MAX_ITEMS 20
+
+static const char* operators[] = { "", "", "=", "!=", ">", ">=", "<", "<=", "^", "~" };
+static const char* items[] = {
+    "1.0.0", "1.2.3", "1.5.0", "2.0.0", "2.0.0-rc.1", "2.3.4", "0.9.1", "1.4.0-alpha.1", "3.0.0",
+    "1.0.0-beta.0123456789abcdefghijklmnopqrstuvwxyz0123456789abcdefghijklmnopqrstuvwxyz",
+};
+static const char* versions[] = {
+    "1.0.0", "1.2.3", "1.3.0", "1.5.0", "1.9.9", "2.0.0", "2.0.0-rc.1", "2.0.0-alpha", "2.3.4", "2.3.9", "0.9.1",
+    "0.1.0", "1.4.0-alpha.2", "3.0.0", "3.1.0", "1.0.0-beta.01",
+};
+
+typedef struct reference_t {
+    const SemVersion* ver;
+    int ranges;
+} Reference;
+
+static int match_term(const SemVersion* items, int count, void* data) {
+    Reference* ref = data;
+    if (count > 1 || (count == 1 && items[0].cmp != COMPARE_NEQUAL && items[0].cmp != COMPARE_NONE &&
+                items[0].cmp != COMPARE_EQUAL)) {
+        ref->ranges++;
+    }
+    for (int i = 0; i < count; i++) {
+        if (! version_equals(ref->ver, &items[i])) {
+            return SEMVER_OK;
+        }
+    }
+    return -100;
+}
+
+/* check_version result computed from the terms of walk_version_list */
+static int reference_check(const SemVersion* ver, const char* list) {
+    Reference ref = { ver, 0 };
+    int res = walk_version_list(list, match_term, &ref);
+    if (res == -100) {
+        return SEMVER_OK;
+    }
+    return (res == SEMVER_OK || ref.ranges > 0) ? SEMVER_OUT_OF_RANGE : res;
+}
+
+static void build_list(unsigned int* seed, char* list, size_t size) {
+    int count = 1 + next_random(seed) % MAX_ITEMS;
+    list[0] = '\0';
+    for (int i = 0; i < count; i++) {
+        const char* op = operators[next_random(seed) % (sizeof(operators) / sizeof(operators[0]))];
+        const char* item = items[next_random(seed) % (sizeof(items) / sizeof(items[0]))];
+        int kind = next_random(seed) % 16;
+        char buf[128];
+        if (kind == 0) {
+            snprintf(buf, sizeof(buf), "%s - %s", item, items[next_random(seed) % 4]);
+        } else if (kind == 1 && i == count - 1) {
+            snprintf(buf, sizeof(buf), "x%s", item);
+        } else {
+            snprintf(buf, sizeof(buf), "%s%s", op, item);
+        }
+        if (i > 0) {
+            strncat(list, kind == 2 ? " - " : ",", size - strlen(list) - 1);
+        }
+        strncat(list, buf, size - strlen(list) - 1);
+    }
+}
+
+static char* test_check() {
+    static const char* lists[] = {
+        "*", " *", "", ",", "1.0.0 -", "1.0.0 - ", "- 1.0.0", ">1.0.0,<1.2.0,>2.0.0,<2.3.4", "<2.0.0,<1.0.0,>1.5.0",
+        ">1.0.0,>1.1.0,>1.2.0,>1.3.0,>1.4.0,>1.5.0,>1.6.0,>1.7.0,>1.8.0,>1.9.0,<1.0.5",
+        ">=1.0.0,<<2.0.0", "^1.0.0,garbage", "garbage,^1.0.0", ">=2.0.0,x,<3.0.0", "1.0.0 - 2.0.0 - 3.0.0",
+    };
+    int same = 1;
+    for (int i = 0; i < sizeof(lists) / sizeof(lists[0]); i++) {
+        for (int j = 0; j < sizeof(versions) / sizeof(versions[0]); j++) {
+            SemVersion ver;
+            parse_version(versions[j], &ver);
+            same &= check_version(&ver, lists[i]) == reference_check(&ver, lists[i]);
+        }
+    }
+    mu_assert("Same result for special lists", same);
+
+    unsigned int seed = 11;
+    for (int i = 0; i < LIST_COUNT; i++) {
+        char list[4096];
+        build_list(&seed, list, sizeof(list));
+        for (int j = 0; j < sizeof(versions) / sizeof(versions[0]); j++) {
+            SemVersion ver;
+            parse_version(versions[j], &ver);
+            int res = check_version(&ver, list);
+            int expected = reference_check(&ver, list);
+            if (res != expected) {
+                printf("%s %s: %d, expected %d\n", versions[j], list, res, expected);
+                same = 0;
+            }
+        }
+    }
+    mu_assert("Same result for random lists", same);
+
+    return 0;
+}
+
+/* A version fits a compound list if it meets every comparator of any
+ * group; a comparator is checked as a one-item list */
+static int reference_compound(const SemVersion* ver, const char* list) {
+    char groups[4096];
+    strcpy(groups, list);
+    for (char* group = strtok(groups, "|"); group != NULL; group = strtok(NULL, "|")) {
+        char comparators[1024];
+        strcpy(comparators, group);
+        int fits = 1;
+        int items = 0;
+        char* saved;
+        for (char* c = strtok_r(comparators, " ", &saved); c != NULL; c = strtok_r(NULL, " ", &saved)) {
+            items++;
+            fits &= check_version(ver, c) == SEMVER_OK;
+        }
+        if (items > 0 && fits) {
+            return SEMVER_OK;
+        }
+    }
+    return SEMVER_OUT_OF_RANGE;
+}
+
+static void build_compound_list(unsigned int* seed, char* list, size_t size) {
+    int groups = 1 + next_random(seed) % 4;
+    list[0] = '\0';
+    for (int i = 0; i < groups; i++) {
+        if (i > 0) {
+            strncat(list, " || ", size - strlen(list) - 1);
+        }
+        int count = 1 + next_random(seed) % 4;
+        for (int j = 0; j < count; j++) {
+            const char* op = operators[next_random(seed) % (sizeof(operators) / sizeof(operators[0]))];
+            const char* item = items[next_random(seed) % (sizeof(items) / sizeof(items[0]))];
+            char buf[128];
+            snprintf(buf, sizeof(buf), "%s%s%s", j > 0 ? " " : "", op, item);
+            strncat(list, buf, size - strlen(list) - 1);
+        }
+    }
+}
+
+static char* test_compound() {
+    static const struct {
+        const char* list;
+        const char* version;
+        int expected;
+    } cases[] = {
+        { ">=1.2.0 <2.0.0 || ^3.1.0", "1.5.0", SEMVER_OK },
+        { ">=1.2.0 <2.0.0 || ^3.1.0", "2.0.0", SEMVER_OUT_OF_RANGE },
+        { ">=1.2.0 <2.0.0 || ^3.1.0", "3.4.0", SEMVER_OK },
+        { ">=1.2.0 <2.0.0 || ^3.1.0", "3.0.9", SEMVER_OUT_OF_RANGE },
+        { ">= 1.2.0 < 2.0.0", "1.9.9", SEMVER_OK },
+        { "1.0.0 - 2.0.0 !=1.5.0", "1.5.0", SEMVER_OUT_OF_RANGE },
+        { "1.0.0 - 2.0.0 !=1.5.0", "1.5.1", SEMVER_OK },
+        { "!=1.0.0 !=2.0.0", "1.0.0", SEMVER_OUT_OF_RANGE },
+        { "!=1.0.0 !=2.0.0", "1.2.0", SEMVER_OK },
+        { "1.2.3 >1.0.0", "1.2.3", SEMVER_OK },
+        { "1.2.3 <1.0.0", "1.2.3", SEMVER_OUT_OF_RANGE },
+        { ">2.0.0 <1.0.0 || 0.9.1", "0.9.1", SEMVER_OK },
+        { "* || 1.0.0", "5.0.0", SEMVER_OK },
+        { "1.0.0 ||", "1.0.0", SEMVER_OK },
+        { "1.0.0 || 2.0.0,3.0.0", "3.0.0", SEMVER_OK },
+        { "1.0.0 || x2.0.0", "1.0.0", SEMVER_OK },
+        { "1.0.0 || x2.0.0", "2.0.0", SEMVER_INVALID_VERSION_LIST },
+        { "1.0.0 | 2.0.0", "2.0.0", SEMVER_INVALID_VERSION_LIST },
+        { "^1.0.0 || >=3.0.0 x", "2.0.0", SEMVER_OUT_OF_RANGE },
+    };
+    int same = 1;
+    for (int i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        SemVersion ver;
+        parse_version(cases[i].version, &ver);
+        int res = check_version(&ver, cases[i].list);
+        if (res != cases[i].expected) {
+            printf("%s %s: %d, expected %d\n", cases[i].version, cases[i].list, res, cases[i].expected);
+            same = 0;
+        }
+    }
+    mu_assert("Compound lists", same);
+
+    unsigned int seed = 17;
+    for (int i = 0; i < LIST_COUNT; i++) {
+        char list[4096];
+        build_compound_list(&seed, list, sizeof(list));
+        for (int j = 0; j < sizeof(versions) / sizeof(versions[0]); j++) {
+            SemVersion ver;
+            parse_version(versions[j], &ver);
+            int res = check_version(&ver, list);
+            int expected = reference_compound(&ver, list);
+            if (res != expected) {
+                printf("%s %s: %d, expected %d\n", versions[j], list, res, expected);
+                same = 0;
+            }
+        }
+    }
+    mu_assert("Compound lists are the same as their comparators", same);
+
+    return 0;
+}
+
+static char* all_tests() {
+    mu_run_test("One pass check", test_check);
+    mu_run_test("Compound lists", test_compound);
+    return 0;
+}
+
+int main (int argc, char** argv) {
+    char *result = all_tests();
+     if (result != 0) {
+         printf("%s\n", result);
+     }
+     else {
+         printf("ALL TESTS PASSED\n");
+     }
+     printf("Tests run: %d\n", tests_run);
+
+     return result != 0;
+}
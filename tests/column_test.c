@@ -0,0 +1,159 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "semver.h"
+#include "ver_column.h"
+
+#include "unittest.h"
+#include "testutils.h"
+
+int tests_run = 0;
+
+#define ROW_COUNT 1001
+
+static const unsigned int numbers[] = { 0, 1, 2, 3, 0x7fffffff, 0x80000000, 0xfffffffe };
+
+static SemVersion versions[ROW_COUNT];
+
+static VersionColumn* build_column() {
+    unsigned int seed = 42;
+    VersionColumn* col = init_version_column();
+    for (int i = 0; i < ROW_COUNT; i++) {
+        char str[128];
+        const char* pre = random_prerelease(&seed);
+        snprintf(str, sizeof(str), "%u.%u.%u%s%s%s",
+                numbers[next_random(&seed) % 4], numbers[next_random(&seed) % 7], numbers[next_random(&seed) % 7],
+                *pre ? "-" : "", pre, (i % 5 == 0) ? "+build.5" : "");
+        parse_version(str, &versions[i]);
+        version_column_append(col, &versions[i]);
+    }
+    return col;
+}
+
+static char* test_gather_scatter() {
+    VersionColumn* col = build_column();
+    mu_assert("All rows added", col != NULL && col->count == ROW_COUNT);
+    mu_assert("Strings are interned", col->string_count <= 2 * sizeof(test_prereleases) / sizeof(test_prereleases[0]));
+
+    int same = 1;
+    for (int i = 0; i < ROW_COUNT; i++) {
+        SemVersion ver;
+        version_column_get(col, i, &ver);
+        same &= memcmp(&ver, &versions[i], sizeof(SemVersion)) == 0;
+    }
+    mu_assert("Rows are read back", same);
+
+    int indices[] = { 7, 3, 500 };
+    SemVersion gathered[3];
+    mu_assert("Gather", version_column_gather(col, indices, 3, gathered) == SEMVER_OK &&
+            memcmp(&gathered[1], &versions[3], sizeof(SemVersion)) == 0);
+
+    parse_version("9.9.9-rc.3+b", &gathered[0]);
+    mu_assert("Scatter", version_column_scatter(col, indices, 3, gathered) == SEMVER_OK);
+    SemVersion ver;
+    version_column_get(col, 7, &ver);
+    mu_assert("Scattered row", memcmp(&ver, &gathered[0], sizeof(SemVersion)) == 0);
+    version_column_set(col, 7, &versions[7]);
+
+    mu_assert("Out of range row", version_column_get(col, ROW_COUNT, &ver) == SEMVER_INVALID_VERSION);
+    indices[2] = -1;
+    mu_assert("Invalid gather index", version_column_gather(col, indices, 3, gathered) == SEMVER_INVALID_VERSION);
+
+    free_version_column(&col);
+    mu_assert("Column freed", col == NULL);
+    return 0;
+}
+
+static char* test_filter() {
+    static const char* bounds[][2] = {
+        { ">=1.0.0", "<2.0.0" }, { ">1.2.0", "<=2147483647.0.0" }, { ">=0.2147483648.0-beta.2", NULL },
+        { NULL, "<1.3.0-rc" }, { ">=2.0.0-alpha", "<=2.1.2147483648" }, { NULL, NULL }, { ">3.4294967294.0", NULL },
+    };
+    VersionColumn* col = build_column();
+    int indices[ROW_COUNT];
+
+    int matched = 1;
+    for (int b = 0; b < sizeof(bounds) / sizeof(bounds[0]); b++) {
+        SemVersion lower, upper;
+        if (bounds[b][0] != NULL) {
+            parse_version(bounds[b][0], &lower);
+        }
+        if (bounds[b][1] != NULL) {
+            parse_version(bounds[b][1], &upper);
+        }
+        const SemVersion* lo = bounds[b][0] ? &lower : NULL;
+        const SemVersion* up = bounds[b][1] ? &upper : NULL;
+
+        /* odd range borders check the scalar tail */
+        int begin = b;
+        int end = ROW_COUNT - b;
+        int found = version_column_filter(col, begin, end, lo, up, indices);
+        int expected = 0;
+        for (int i = begin; i < end; i++) {
+            if ((lo == NULL || version_equals(&versions[i], lo)) && (up == NULL || version_equals(&versions[i], up))) {
+                matched &= expected < found && indices[expected] == i;
+                expected++;
+            }
+        }
+        matched &= found == expected && version_column_count(col, begin, end, lo, up) == expected;
+    }
+    mu_assert("Filter gives the same rows as version_equals", matched);
+
+    SemVersion eq;
+    parse_version("=1.0.0", &eq);
+    mu_assert("Invalid bound", version_column_count(col, 0, ROW_COUNT, &eq, NULL) == -1);
+    mu_assert("Invalid rows", version_column_count(col, 0, ROW_COUNT + 1, NULL, NULL) == -1);
+
+    free_version_column(&col);
+    return 0;
+}
+
+static int reference_argmax(int begin, int end, int stable_only) {
+    int best = -1;
+    for (int i = begin; i < end; i++) {
+        if (stable_only && versions[i].prerelease != PRERELEASE_NONE) {
+            continue;
+        }
+        if (best == -1 || compare_versions(&versions[i], &versions[best]) > 0) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+static char* test_argmax() {
+    VersionColumn* col = build_column();
+
+    int matched = 1;
+    for (int begin = 0; begin < ROW_COUNT; begin += 37) {
+        for (int len = 1; begin + len <= ROW_COUNT; len = len * 3 + 1) {
+            matched &= version_column_argmax(col, begin, begin + len, 0) == reference_argmax(begin, begin + len, 0);
+            matched &= version_column_argmax(col, begin, begin + len, 1) == reference_argmax(begin, begin + len, 1);
+        }
+    }
+    mu_assert("Argmax is the same as a linear search", matched);
+    mu_assert("Empty rows", version_column_argmax(col, 5, 5, 0) == -1);
+
+    free_version_column(&col);
+    return 0;
+}
+
+static char* all_tests() {
+    mu_run_test("Column gather and scatter", test_gather_scatter);
+    mu_run_test("Column filter", test_filter);
+    mu_run_test("Column argmax", test_argmax);
+    return 0;
+}
+
+int main (int argc, char** argv) {
+    char *result = all_tests();
+     if (result != 0) {
+         printf("%s\n", result);
+     }
+     else {
+         printf("ALL TESTS PASSED\n");
+     }
+     printf("Tests run: %d\n", tests_run);
+
+     return result != 0;
+}
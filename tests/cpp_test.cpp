@@ -0,0 +1,147 @@
+#include <stdio.h>
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "semver.hpp"
+
+#include "unittest.h"
+
+int tests_run = 0;
+
+static char* test_version() {
+    semver::Version ver("1.2.3-beta.4+build.5");
+    mu_assert("Parts", ver.major() == 1 && ver.minor() == 2 && ver.patch() == 3 && ver.prerelease() == PRERELEASE_BETA);
+    mu_assert("Strings", ver.prerelease_str() == "beta.4" && ver.build_str() == "build.5");
+
+    std::string_view line = "1.0.0 trailing text";
+    mu_assert("Parse a part of string", semver::Version::try_parse(line.substr(0, 5)).has_value());
+    mu_assert("Embedded NUL", !semver::Version::try_parse(std::string_view("1.0.0\0x", 7)).has_value());
+
+    int error = SEMVER_OK;
+    mu_assert("Invalid version", !semver::Version::try_parse("1.x.0", &error) && error == SEMVER_INVALID_MINOR);
+    bool thrown = false;
+    try {
+        semver::Version::parse("1.0");
+    } catch (const semver::Error& e) {
+        thrown = e.code() != SEMVER_OK;
+    }
+    mu_assert("Error is thrown", thrown);
+    std::string long_str = "1.0.0-" + std::string(200, 'a');
+    mu_assert("Long string", semver::Version::try_parse(long_str, &error) && error == SEMVER_OK);
+    mu_assert("Messages", std::strcmp(semver::Error::message(SEMVER_INVALID_HANDLE), "invalid handle") == 0 &&
+            std::strcmp(semver::Error::message(SEMVER_IO_ERROR), "semver error") != 0);
+
+    mu_assert("Satisfies", ver.satisfies(">=1.2.0,<2.0.0") && !ver.satisfies("^2.0.0"));
+    mu_assert("Meets", ver.meets(semver::Version(">1.2.2")));
+
+    return 0;
+}
+
+static char* test_ordering() {
+    std::vector<semver::Version> versions;
+    for (const char* s : { "1.0.0", "1.0.0-rc.1", "0.9.9", "1.0.0-alpha", "1.0.0+b2", "2.0.0-dev" }) {
+        versions.emplace_back(s);
+    }
+    std::sort(versions.begin(), versions.end());
+
+    bool sorted = true;
+    for (size_t i = 1; i < versions.size(); i++) {
+        sorted = sorted && compare_versions(&versions[i - 1].c_version(), &versions[i].c_version()) <= 0;
+    }
+    mu_assert("Sorted with compare_versions", sorted);
+    mu_assert("Build is ignored", semver::Version("1.0.0+a") == semver::Version("1.0.0+b"));
+    mu_assert("Prerelease is less", semver::Version("1.0.0-rc.1") < semver::Version("1.0.0"));
+#if defined(__cpp_impl_three_way_comparison)
+    mu_assert("Weak ordering", (semver::Version("1.0.0+a") <=> semver::Version("1.0.0")) == 0);
+#endif
+
+    std::unordered_set<semver::Version> set(versions.begin(), versions.end());
+    mu_assert("Hash set", set.size() == versions.size() - 1 && set.count(semver::Version("1.0.0+x")) == 1);
+
+    return 0;
+}
+
+static char* test_range_list() {
+    semver::RangeList list;
+    VersionRange* item = list.add(semver::Version(">=1.0.0"));
+    list.complete(item, semver::Version("<2.0.0"));
+    list.add(semver::Version(">3.0.0"), true);
+    mu_assert("Range size", list.size() == 2);
+    mu_assert("Contains", list.contains(semver::Version("1.5.0")) && list.contains(semver::Version("4.0.0")));
+    mu_assert("Does not contain", !list.contains(semver::Version("2.5.0")));
+
+    semver::RangeList moved(std::move(list));
+    mu_assert("Moved", list.get() == nullptr && moved.size() == 2);
+
+    bool thrown = false;
+    try {
+        moved.add(semver::Version("=1.0.0"));
+    } catch (const semver::Error& e) {
+        thrown = true;
+    }
+    mu_assert("Invalid limit", thrown);
+
+    return 0;
+}
+
+static char* test_constraint() {
+    static const char* lists[] = {
+        ">=1.2.0,<2.0.0", "^1.4.0", "~2.3.1", "1.0.0 - 1.9.9,3.0.0", "!=1.5.0", "*", "<=1.11.0,>=1.14.1",
+        "2.0.0-rc.1 - 2.0.0", ">1.0.0,<1.5.0,>=3.0.0",
+    };
+    static const char* versions[] = {
+        "1.2.3", "1.5.0", "2.3.4", "0.9.1", "2.0.0-rc.2", "1.17.0", "3.0.0", "1.12.3-beta.31+345", "1.4.0",
+    };
+
+    bool same = true;
+    for (const char* list : lists) {
+        semver::Constraint constraint(list);
+        for (const char* v : versions) {
+            semver::Version ver(v);
+            same = same && constraint.matches(ver) == ver.satisfies(list);
+        }
+    }
+    mu_assert("Constraint matches as check_version", same);
+
+#if defined(__cpp_lib_memory_resource)
+    char buf[4096];
+    std::pmr::monotonic_buffer_resource pool(buf, sizeof(buf), std::pmr::null_memory_resource());
+    semver::pmr::Constraint pooled(">=1.2.0,<2.0.0,3.0.0", &pool);
+    mu_assert("PMR constraint", pooled.size() == 2 && pooled.matches(semver::Version("3.0.0")) &&
+            pooled.get_allocator().resource() == &pool);
+#endif
+
+    semver::Constraint constraint("1.0.0");
+    bool thrown = false;
+    try {
+        constraint.assign(">=1.0.0,<<2.0.0");
+    } catch (const semver::Error& e) {
+        thrown = e.code() == SEMVER_INVALID_VERSION_LIST;
+    }
+    mu_assert("Invalid list", thrown && constraint.size() == 1);
+
+    return 0;
+}
+
+static char* all_tests() {
+    mu_run_test("C++ version", test_version);
+    mu_run_test("C++ ordering", test_ordering);
+    mu_run_test("C++ range list", test_range_list);
+    mu_run_test("C++ constraint", test_constraint);
+    return 0;
+}
+
+int main (int argc, char** argv) {
+    char *result = all_tests();
+     if (result != 0) {
+         printf("%s\n", result);
+     }
+     else {
+         printf("ALL TESTS PASSED\n");
+     }
+     printf("Tests run: %d\n", tests_run);
+
+     return result != 0;
+}
@@ -0,0 +1,123 @@
+#include <stdio.h>
+#include <string.h>
+#include "semver.h"
+#include "semver_group.h"
+
+#include "unittest.h"
+#include "testutils.h"
+
+int tests_run = 0;
+
+#define VERSION_COUNT 50000
+#define MAX_GROUPS 1024
+
+static SemVersion versions[VERSION_COUNT];
+
+/* Checks groups against a linear scan of all versions */
+static int check_groups(const VersionGroup* groups, int group_count, VersionGrouping grouping, int filter) {
+    int total = 0;
+    for (int g = 0; g < group_count; g++) {
+        if (g > 0 && (groups[g].major < groups[g-1].major ||
+                (groups[g].major == groups[g-1].major && groups[g].minor <= groups[g-1].minor))) {
+            return 0;
+        }
+
+        int best = -1;
+        int count = 0;
+        for (int i = 0; i < VERSION_COUNT; i++) {
+            const SemVersion* ver = &versions[i];
+            if ((filter & (1 << ver->prerelease)) == 0 ||
+                    (grouping != GROUP_ALL && ver->major != groups[g].major) ||
+                    (grouping == GROUP_BY_MINOR && ver->minor != groups[g].minor)) {
+                continue;
+            }
+            count++;
+            if (best == -1 || compare_versions(ver, &versions[best]) > 0) {
+                best = i;
+            }
+        }
+        if (best != groups[g].latest || count != groups[g].count) {
+            return 0;
+        }
+        total += count;
+    }
+
+    int expected = 0;
+    for (int i = 0; i < VERSION_COUNT; i++) {
+        expected += (filter & (1 << versions[i].prerelease)) != 0;
+    }
+    return total == expected;
+}
+
+static char* test_grouping() {
+    static const int filters[] = {
+        VERSION_FILTER_ANY, VERSION_FILTER_RELEASE, VERSION_FILTER_RC | VERSION_FILTER_RELEASE, VERSION_FILTER_OTHER,
+    };
+    VersionGroup groups[MAX_GROUPS];
+    int group_count;
+    unsigned int seed = 7;
+    random_versions(&seed, versions, VERSION_COUNT, 12, 20, 50, 0);
+
+    int matched = 1;
+    for (int grouping = GROUP_ALL; grouping <= GROUP_BY_MINOR; grouping++) {
+        for (int f = 0; f < sizeof(filters) / sizeof(filters[0]); f++) {
+            int res = group_latest_versions(versions, VERSION_COUNT, grouping, filters[f],
+                    groups, MAX_GROUPS, &group_count);
+            matched &= res == SEMVER_OK && check_groups(groups, group_count, grouping, filters[f]);
+        }
+    }
+    mu_assert("Groups are the same as a linear scan gives", matched);
+
+    group_latest_versions(versions, VERSION_COUNT, GROUP_BY_MINOR, VERSION_FILTER_ANY, groups, MAX_GROUPS, &group_count);
+    mu_assert("Group per minor version", group_count == 12 * 20);
+    mu_assert("Small buffer", group_latest_versions(versions, VERSION_COUNT, GROUP_BY_MAJOR, VERSION_FILTER_ANY,
+                groups, 5, &group_count) == SEMVER_BUFFER_TOO_SMALL && group_count == 12);
+    mu_assert("No versions", group_latest_versions(versions, 0, GROUP_ALL, VERSION_FILTER_ANY,
+                groups, MAX_GROUPS, &group_count) == SEMVER_OK && group_count == 0);
+    mu_assert("Invalid arguments", group_latest_versions(NULL, 5, GROUP_ALL, VERSION_FILTER_ANY,
+                groups, MAX_GROUPS, &group_count) == SEMVER_INVALID_VERSION);
+
+    return 0;
+}
+
+static char* test_parallel() {
+    VersionGroup serial[MAX_GROUPS];
+    VersionGroup parallel[MAX_GROUPS];
+    int serial_count, parallel_count;
+    unsigned int seed = 7;
+    random_versions(&seed, versions, VERSION_COUNT, 12, 20, 50, 0);
+
+    int matched = 1;
+    for (int grouping = GROUP_ALL; grouping <= GROUP_BY_MINOR; grouping++) {
+        for (int threads = 1; threads <= 8; threads *= 2) {
+            group_latest_versions(versions, VERSION_COUNT, grouping, VERSION_FILTER_ANY,
+                    serial, MAX_GROUPS, &serial_count);
+            int res = group_latest_versions_parallel(versions, VERSION_COUNT, grouping, VERSION_FILTER_ANY,
+                    parallel, MAX_GROUPS, &parallel_count, threads);
+            matched &= res == SEMVER_OK && serial_count == parallel_count &&
+                memcmp(serial, parallel, serial_count * sizeof(VersionGroup)) == 0;
+        }
+    }
+    mu_assert("Parallel groups are the same as serial ones", matched);
+
+    return 0;
+}
+
+static char* all_tests() {
+    mu_run_test("Group latest versions", test_grouping);
+    mu_run_test("Group latest versions in parallel", test_parallel);
+    return 0;
+}
+
+int main (int argc, char** argv) {
+    char *result = all_tests();
+     if (result != 0) {
+         printf("%s\n", result);
+     }
+     else {
+         printf("ALL TESTS PASSED\n");
+     }
+     printf("Tests run: %d\n", tests_run);
+
+     return result != 0;
+}
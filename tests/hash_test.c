@@ -0,0 +1,147 @@
+#include <stdio.h>
+#include <string.h>
+#include "semver.h"
+#include "semver_hash.h"
+
+#include "unittest.h"
+#include "testutils.h"
+
+int tests_run = 0;
+
+#define VERSION_COUNT 3000
+
+static SemVersion versions[VERSION_COUNT];
+
+static char* test_hash() {
+    static const char* equal[][2] = {
+        { "1.0.0+a", "1.0.0+b" }, { "1.0.0-rc.01", "1.0.0-rc.1" }, { "1.0.0-beta.2", "1.0.0-betax.2" },
+        { "1.0.0-rc.1a", "1.0.0-rc.1b" }, { "2.1.0-dev.abc", "2.1.0-dev.ab" },
+    };
+    SemVersion ver_a, ver_b;
+    for (int i = 0; i < sizeof(equal) / sizeof(equal[0]); i++) {
+        parse_version(equal[i][0], &ver_a);
+        parse_version(equal[i][1], &ver_b);
+        mu_assert("Versions are equal", compare_versions(&ver_a, &ver_b) == 0);
+        mu_assert("Equal versions have the same hash", hash_version(&ver_a, 0) == hash_version(&ver_b, 0));
+    }
+
+    parse_version("1.0.0+a", &ver_a);
+    parse_version("1.0.0+b", &ver_b);
+    mu_assert("Build is hashed", hash_version(&ver_a, VERSION_HASH_BUILD) != hash_version(&ver_b, VERSION_HASH_BUILD));
+    mu_assert("Build is compared", ! version_hash_equals(&ver_a, &ver_b, VERSION_HASH_BUILD));
+
+    unsigned int seed = 5;
+    random_versions(&seed, versions, VERSION_COUNT, 3, 3, 5, RANDOM_BUILDS);
+    int consistent = 1;
+    int collisions = 0;
+    for (int i = 0; i < VERSION_COUNT; i++) {
+        for (int j = i + 1; j < VERSION_COUNT; j++) {
+            for (int flags = 0; flags <= VERSION_HASH_BUILD; flags++) {
+                int same_hash = hash_version(&versions[i], flags) == hash_version(&versions[j], flags);
+                if (version_hash_equals(&versions[i], &versions[j], flags)) {
+                    consistent &= same_hash;
+                } else {
+                    collisions += same_hash;
+                }
+            }
+        }
+    }
+    mu_assert("Hash agrees with compare_versions", consistent);
+    mu_assert("No collisions", collisions == 0);
+
+    return 0;
+}
+
+static char* test_map() {
+    VersionMap* map = init_version_map(0);
+    unsigned int seed = 5;
+    random_versions(&seed, versions, VERSION_COUNT, 3, 3, 5, RANDOM_BUILDS);
+
+    int distinct = 0;
+    int found = 1;
+    for (int i = 0; i < VERSION_COUNT; i++) {
+        int added;
+        VersionMapEntry* e = version_map_insert(map, &versions[i], &added);
+        if (added) {
+            e->value = &versions[i];
+            distinct++;
+        }
+        /* the value is the first equal version */
+        found &= e != NULL && compare_versions(e->value, &versions[i]) == 0;
+    }
+    mu_assert("Insert", found && map->count == distinct);
+
+    int expected = 0;
+    for (int i = 0; i < VERSION_COUNT; i++) {
+        int first = 1;
+        for (int j = 0; j < i && first; j++) {
+            first = compare_versions(&versions[j], &versions[i]) != 0;
+        }
+        expected += first;
+    }
+    mu_assert("Distinct versions", distinct == expected);
+
+    int removed = 0;
+    for (int i = 0; i < VERSION_COUNT; i += 3) {
+        removed += version_map_remove(map, &versions[i]);
+    }
+    int matched = 1;
+    for (int i = 0; i < VERSION_COUNT; i++) {
+        int was_removed = 0;
+        for (int j = 0; j < VERSION_COUNT && ! was_removed; j += 3) {
+            was_removed = compare_versions(&versions[j], &versions[i]) == 0;
+        }
+        matched &= (version_map_find(map, &versions[i]) == NULL) == was_removed;
+    }
+    mu_assert("Remove", matched && map->count == distinct - removed);
+
+    int iterated = 0;
+    for (VersionMapEntry* e = version_map_next(map, NULL); e != NULL; e = version_map_next(map, e)) {
+        iterated++;
+    }
+    mu_assert("Iterate", iterated == map->count);
+
+    clear_version_map(map);
+    mu_assert("Clear", map->count == 0 && version_map_find(map, &versions[1]) == NULL);
+
+    free_version_map(&map);
+    mu_assert("Map freed", map == NULL);
+    return 0;
+}
+
+static char* test_map_build() {
+    VersionMap* map = init_version_map(VERSION_HASH_BUILD);
+    SemVersion ver;
+    int added;
+    parse_version("1.0.0+b1", &ver);
+    version_map_insert(map, &ver, &added);
+    parse_version("1.0.0+b2", &ver);
+    version_map_insert(map, &ver, &added);
+    mu_assert("Build makes versions different", added && map->count == 2);
+    parse_version("1.0.0+b1", &ver);
+    version_map_insert(map, &ver, &added);
+    mu_assert("Same build", ! added && map->count == 2);
+
+    free_version_map(&map);
+    return 0;
+}
+
+static char* all_tests() {
+    mu_run_test("Version hash", test_hash);
+    mu_run_test("Version map", test_map);
+    mu_run_test("Version map with build", test_map_build);
+    return 0;
+}
+
+int main (int argc, char** argv) {
+    char *result = all_tests();
+     if (result != 0) {
+         printf("%s\n", result);
+     }
+     else {
+         printf("ALL TESTS PASSED\n");
+     }
+     printf("Tests run: %d\n", tests_run);
+
+     return result != 0;
+}
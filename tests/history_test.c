@@ -0,0 +1,161 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "semver.h"
+#include "semver_history.h"
+
+#include "unittest.h"
+#include "testutils.h"
+
+int tests_run = 0;
+
+#define VERSION_COUNT 3000
+
+static SemVersion versions[VERSION_COUNT];
+static SemVersion decoded[VERSION_COUNT];
+static unsigned char data[VERSION_COUNT * 64];
+
+/* Sorted random versions, some of them with a major number that takes a
+ * long varint */
+static void build_versions(unsigned int* seed, int count) {
+    random_versions(seed, versions, count, 4, 5, 300, RANDOM_BUILDS);
+    for (int i = 0; i < count; i++) {
+        if (next_random(seed) % 8 == 0) {
+            versions[i].major = 4000000000u;
+        }
+    }
+    qsort(versions, count, sizeof(SemVersion), compare_for_qsort);
+}
+
+static char* test_round_trip() {
+    static const int counts[] = { 0, 1, 2, 127, 128, 129, 1000, VERSION_COUNT };
+    unsigned int seed = 9;
+
+    for (int c = 0; c < sizeof(counts) / sizeof(counts[0]); c++) {
+        int count = counts[c];
+        build_versions(&seed, count);
+
+        size_t size;
+        mu_assert("Size query", encode_version_history(versions, count, NULL, 0, &size) == SEMVER_BUFFER_TOO_SMALL);
+        mu_assert("Buffer too small", size == VERSION_HISTORY_HEADER_SIZE ||
+                encode_version_history(versions, count, data, size - 1, &size) == SEMVER_BUFFER_TOO_SMALL);
+        mu_assert("Encoded", encode_version_history(versions, count, data, sizeof(data), &size) == SEMVER_OK);
+
+        HistoryDecoder decoder;
+        mu_assert("Decoder", init_history_decoder(&decoder, data, size) == SEMVER_OK && decoder.count == count);
+        int total = 0;
+        int n;
+        while ((n = history_decoder_read(&decoder, decoded + total, 1 + next_random(&seed) % 300)) > 0) {
+            total += n;
+        }
+        mu_assert("All versions are decoded", n == 0 && total == count);
+        mu_assert("Same versions", memcmp(versions, decoded, count * sizeof(SemVersion)) == 0);
+    }
+
+    return 0;
+}
+
+static char* test_seek() {
+    unsigned int seed = 21;
+    build_versions(&seed, VERSION_COUNT);
+
+    size_t size;
+    encode_version_history(versions, VERSION_COUNT, data, sizeof(data), &size);
+    HistoryDecoder decoder;
+    init_history_decoder(&decoder, data, size);
+
+    int same = 1;
+    for (int i = 0; i < 500; i++) {
+        SemVersion ver = versions[next_random(&seed) % VERSION_COUNT];
+        ver.patch += next_random(&seed) % 2;
+        int expected = 0;
+        while (expected < VERSION_COUNT && compare_versions(&versions[expected], &ver) < 0) {
+            expected++;
+        }
+
+        SemVersion next;
+        int idx = history_decoder_seek(&decoder, &ver);
+        int n = history_decoder_read(&decoder, &next, 1);
+        if (idx != expected || (n == 1) != (expected < VERSION_COUNT) ||
+                (n == 1 && memcmp(&next, &versions[expected], sizeof(SemVersion)) != 0)) {
+            printf("%u.%u.%u: %d, expected %d\n", ver.major, ver.minor, ver.patch, idx, expected);
+            same = 0;
+        }
+    }
+    mu_assert("Seek to the lower bound", same);
+
+    return 0;
+}
+
+static char* test_size() {
+    for (int i = 0; i < VERSION_COUNT; i++) {
+        char str[64];
+        snprintf(str, sizeof(str), "2.%d.%d", i / 100, i % 100);
+        parse_version(str, &versions[i]);
+    }
+
+    size_t size;
+    encode_version_history(versions, VERSION_COUNT, data, sizeof(data), &size);
+    mu_assert("Patch releases take 2 bytes", size < VERSION_COUNT * 2 + 1024);
+
+    return 0;
+}
+
+static char* test_invalid() {
+    unsigned int seed = 5;
+    build_versions(&seed, 500);
+
+    size_t size;
+    SemVersion tmp = versions[0];
+    versions[0] = versions[499];
+    versions[499] = tmp;
+    mu_assert("Unsorted", encode_version_history(versions, 500, data, sizeof(data), &size) == SEMVER_INVALID_VERSION);
+    versions[499] = versions[0];
+    versions[0] = tmp;
+
+    encode_version_history(versions, 500, data, sizeof(data), &size);
+    HistoryDecoder decoder;
+    mu_assert("Truncated", init_history_decoder(&decoder, data, size - 1) == SEMVER_INVALID_BLOB);
+    mu_assert("No data", init_history_decoder(&decoder, NULL, size) == SEMVER_INVALID_BLOB);
+
+    /* broken records are found or decoded to some versions, never read
+     * out of the buffer */
+    unsigned char* copy = malloc(size);
+    int broken = 0;
+    for (int i = 0; i < 2000; i++) {
+        memcpy(copy, data, size);
+        copy[next_random(&seed) % size] ^= 1 << (next_random(&seed) % 8);
+        if (init_history_decoder(&decoder, copy, size) != SEMVER_OK) {
+            broken++;
+            continue;
+        }
+        int n;
+        while ((n = history_decoder_read(&decoder, decoded, 64)) > 0);
+        broken += n < 0;
+    }
+    free(copy);
+    mu_assert("Broken data is found", broken > 0);
+
+    return 0;
+}
+
+static char* all_tests() {
+    mu_run_test("Round trip", test_round_trip);
+    mu_run_test("Seek", test_seek);
+    mu_run_test("Encoded size", test_size);
+    mu_run_test("Invalid data", test_invalid);
+    return 0;
+}
+
+int main (int argc, char** argv) {
+    char *result = all_tests();
+     if (result != 0) {
+         printf("%s\n", result);
+     }
+     else {
+         printf("ALL TESTS PASSED\n");
+     }
+     printf("Tests run: %d\n", tests_run);
+
+     return result != 0;
+}
@@ -0,0 +1,122 @@
+#include <stdio.h>
+#include <string.h>
+#include "semver.h"
+#include "semver_check.h"
+#include "semver_intern.h"
+
+#include "unittest.h"
+
+int tests_run = 0;
+
+static const char* lists[] = {
+    ">=1.2.0,<2.0.0", "^1.4.0", "~2.3.1", "1.0.0 - 1.9.9,3.0.0", "!=1.5.0", "*", "<=1.11.0,>=1.14.1",
+    "2.0.0-rc.1 - 2.0.0", ">1.0.0,<1.5.0,>=3.0.0", "1.0.0,^2.0.0", "", "1.0.0-beta.2,1.0.0-beta.10",
+};
+static const char* versions[] = {
+    "1.2.3", "1.5.0", "2.3.4", "0.9.1", "2.0.0-rc.2", "1.17.0", "3.0.0", "1.12.3-beta.31+345", "1.4.0", "1.0.0",
+    "2.5.0", "1.0.0-beta.10",
+};
+
+static char* test_intern() {
+    ConstraintTable* table = init_constraint_table();
+    unsigned int handles[sizeof(lists) / sizeof(lists[0])];
+    for (int i = 0; i < sizeof(lists) / sizeof(lists[0]); i++) {
+        mu_assert("Interned", intern_constraint(table, lists[i], &handles[i]) == SEMVER_OK);
+    }
+    mu_assert("Distinct lists", table->count == sizeof(lists) / sizeof(lists[0]));
+
+    int same = 1;
+    for (int i = 0; i < sizeof(lists) / sizeof(lists[0]); i++) {
+        for (int j = 0; j < sizeof(versions) / sizeof(versions[0]); j++) {
+            SemVersion ver;
+            parse_version(versions[j], &ver);
+            same &= check_constraint(table, handles[i], &ver) == check_version(&ver, lists[i]);
+        }
+    }
+    mu_assert("Check as check_version", same);
+
+    static const char* equal[][2] = {
+        { "1.0.0,^2.0.0", " ^2.0.0, =1.0.0,1.0.0" }, { "*", " *" }, { "<2.0.0,>=1.2.0", ">=1.2.0,<2.0.0" },
+        { "1.0.0 - 1.9.9,3.0.0", "==3.0.0,>=1.0.0,<=1.9.9" }, { "^1.4.0-rc.1", ">=1.4.0-rc.1,<2.0.0,^1.4.0-rc.1" },
+        { "", ">2.0.0 <1.0.0" },
+    };
+    for (int i = 0; i < sizeof(equal) / sizeof(equal[0]); i++) {
+        unsigned int a, b;
+        intern_constraint(table, equal[i][0], &a);
+        intern_constraint(table, equal[i][1], &b);
+        same &= a == b && get_constraint(table, a)->terms != NULL;
+        release_constraint(table, a);
+        release_constraint(table, b);
+    }
+    mu_assert("Equal lists share a handle", same);
+
+    unsigned int h;
+    mu_assert("Invalid list", intern_constraint(table, ">=1.0.0,<<2.0.0", &h) == SEMVER_INVALID_VERSION_LIST);
+    mu_assert("No new lists", table->count == sizeof(lists) / sizeof(lists[0]));
+
+    free_constraint_table(&table);
+    mu_assert("Freed", table == NULL);
+    return 0;
+}
+
+static char* test_refs() {
+    ConstraintTable* table = init_constraint_table();
+    unsigned int a, b, c;
+    intern_constraint(table, "^1.0.0", &a);
+    intern_constraint(table, ">=1.0.0,<2.0.0", &b);
+    mu_assert("Same handle", a == b && get_constraint(table, a)->refs == 2);
+    retain_constraint(table, a);
+    release_constraint(table, a);
+    release_constraint(table, a);
+    mu_assert("Still in use", get_constraint(table, a) != NULL);
+    release_constraint(table, a);
+    mu_assert("Released", get_constraint(table, a) == NULL && table->count == 0);
+    mu_assert("Released handle", release_constraint(table, a) == SEMVER_INVALID_HANDLE &&
+            check_constraint(table, a, NULL) == SEMVER_INVALID_HANDLE);
+
+    intern_constraint(table, "~1.0.0", &c);
+    mu_assert("Handle is reused", c == a);
+
+    /* many lists make the index grow and remove entries from the middle of probe chains */
+    static unsigned int handles[2000];
+    for (int i = 0; i < 2000; i++) {
+        char list[32];
+        snprintf(list, sizeof(list), "^%d.%d.0", i / 10, i % 10);
+        intern_constraint(table, list, &handles[i]);
+    }
+    for (int i = 0; i < 2000; i += 2) {
+        release_constraint(table, handles[i]);
+    }
+    int found = 1;
+    for (int i = 1; i < 2000; i += 2) {
+        char list[32];
+        unsigned int h;
+        snprintf(list, sizeof(list), ">=%d.%d.0,<%d.0.0", i / 10, i % 10, i / 10 + 1);
+        intern_constraint(table, list, &h);
+        found &= h == handles[i];
+        release_constraint(table, h);
+    }
+    mu_assert("Lookups after removal", found && table->count == 1 + 1000);
+
+    free_constraint_table(&table);
+    return 0;
+}
+
+static char* all_tests() {
+    mu_run_test("Intern constraints", test_intern);
+    mu_run_test("Constraint references", test_refs);
+    return 0;
+}
+
+int main (int argc, char** argv) {
+    char *result = all_tests();
+     if (result != 0) {
+         printf("%s\n", result);
+     }
+     else {
+         printf("ALL TESTS PASSED\n");
+     }
+     printf("Tests run: %d\n", tests_run);
+
+     return result != 0;
+}
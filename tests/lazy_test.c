@@ -0,0 +1,115 @@
+#include <stdio.h>
+#include <string.h>
+#include "semver.h"
+#include "semver_lazy.h"
+
+#include "unittest.h"
+#include "testutils.h"
+
+int tests_run = 0;
+
+#define VERSION_COUNT 1000
+
+static char strings[VERSION_COUNT][64];
+
+static int same_version(const SemVersion* a, const SemVersion* b) {
+    return a->major == b->major && a->minor == b->minor && a->patch == b->patch && a->cmp == b->cmp &&
+        a->prerelease == b->prerelease && memcmp(a->prerelease_str, b->prerelease_str, MAX_PRERELEASE_LEN) == 0 &&
+        memcmp(a->build_str, b->build_str, MAX_BUILD_LEN) == 0;
+}
+
+static char* test_parse() {
+    static const char* valid[] = {
+        "1.2.3", "v1.2.3", ">=1.2.3", "1.2.3-alpha.1+build.5", "1.2.3+b1 ", "1.2.3-", "1.2.3+",
+        "1.2.3-0123456789abcdefghij", "1.2.3+0123456789abcdefghij",
+    };
+    static const char* invalid_tail[] = { "1.2.3-al_pha", "1.2.3+b1 x", "1.2.3-rc.1+b-1", "1.2.3-rc 1" };
+    static const char* invalid[] = { "1.2", "1.x.3", "x", "", "1.2.3 ", "1.2.3_1" };
+
+    int same = 1;
+    for (int i = 0; i < sizeof(valid) / sizeof(valid[0]); i++) {
+        LazyVersion lazy;
+        SemVersion expected, ver;
+        parse_version(valid[i], &expected);
+        same &= parse_lazy_version(valid[i], LAZY_VERSION_STRICT, &lazy) == SEMVER_OK;
+        same &= lazy_version_to_semver(&lazy, &ver) == SEMVER_OK && same_version(&expected, &ver);
+    }
+    mu_assert("Valid versions", same);
+
+    for (int i = 0; i < sizeof(invalid_tail) / sizeof(invalid_tail[0]); i++) {
+        LazyVersion lazy;
+        int expected = parse_version(invalid_tail[i], NULL);
+        same &= expected != SEMVER_OK;
+        same &= parse_lazy_version(invalid_tail[i], LAZY_VERSION_STRICT, &lazy) == expected;
+        same &= parse_lazy_version(invalid_tail[i], 0, &lazy) == SEMVER_OK;
+        if (lazy.str[lazy.tail] == '-') {
+            same &= decode_lazy_version(&lazy) == expected;
+        }
+        SemVersion ver;
+        same &= lazy_version_to_semver(&lazy, &ver) == expected;
+    }
+    mu_assert("Tail is checked only in strict mode", same);
+
+    for (int i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++) {
+        LazyVersion lazy;
+        same &= parse_lazy_version(invalid[i], 0, &lazy) == parse_version(invalid[i], NULL);
+    }
+    mu_assert("Numbers are always checked", same);
+
+    return 0;
+}
+
+static char* test_compare() {
+    unsigned int seed = 9;
+    for (int i = 0; i < VERSION_COUNT; i++) {
+        random_version_string(&seed, strings[i], sizeof(strings[i]), 3, 3, 3, RANDOM_BUILDS);
+    }
+
+    static SemVersion versions[VERSION_COUNT];
+    static LazyVersion lazy[VERSION_COUNT];
+    for (int i = 0; i < VERSION_COUNT; i++) {
+        parse_version(strings[i], &versions[i]);
+        parse_lazy_version(strings[i], 0, &lazy[i]);
+    }
+
+    int same = 1;
+    for (int i = 0; i < VERSION_COUNT; i++) {
+        for (int j = 0; j < VERSION_COUNT; j++) {
+            int expected = compare_versions(&versions[i], &versions[j]);
+            int res = compare_lazy_versions(&lazy[i], &lazy[j]);
+            same &= (expected < 0) == (res < 0) && (expected > 0) == (res > 0);
+        }
+    }
+    mu_assert("Compare as compare_versions", same);
+
+    LazyVersion a, b;
+    parse_lazy_version("1.2.3-beta.1", 0, &a);
+    parse_lazy_version("1.2.4-beta.1", 0, &b);
+    mu_assert("Not decoded before compare", ! a.decoded && ! b.decoded);
+    compare_lazy_versions(&a, &b);
+    mu_assert("Different numbers are not decoded", ! a.decoded && ! b.decoded);
+    parse_lazy_version("1.2.3-beta.2", 0, &b);
+    mu_assert("Equal numbers are decoded", compare_lazy_versions(&a, &b) < 0 && a.decoded && b.decoded &&
+            a.prerelease == PRERELEASE_BETA);
+
+    return 0;
+}
+
+static char* all_tests() {
+    mu_run_test("Lazy parse", test_parse);
+    mu_run_test("Lazy compare", test_compare);
+    return 0;
+}
+
+int main (int argc, char** argv) {
+    char *result = all_tests();
+     if (result != 0) {
+         printf("%s\n", result);
+     }
+     else {
+         printf("ALL TESTS PASSED\n");
+     }
+     printf("Tests run: %d\n", tests_run);
+
+     return result != 0;
+}
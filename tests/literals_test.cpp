@@ -0,0 +1,163 @@
+#include <stdio.h>
+#include <string.h>
+#include "semver_literals.hpp"
+
+#include "unittest.h"
+
+using namespace semver::literals;
+
+int tests_run = 0;
+
+static const char* version_strings[] = {
+    "1.2.3", "1.5.0", "2.3.4", "0.9.1", "2.0.0-rc.2", "2.0.0-rc.1", "2.0.0", "1.17.0", "3.0.0", "1.12.3-beta.31+345",
+    "1.4.0", "1.4.0-alpha", "1.4.0-alpha.1", "1.4.0-dev", "1.4.0-dev.10", "1.4.0-dev.9", "2.3.1", "2.4.0-rc",
+    "1.0.0", "1.9.9", "1.9.10", "0.0.0", "4294967294.0.0", "1.0.0-beta.ab", "1.0.0-beta.abc", "1.0.0-",
+};
+
+static const char* list_strings[] = {
+    ">=1.2.0,<2.0.0", "^1.4.0", "~2.3.1", "1.0.0 - 1.9.9,3.0.0", "!=1.5.0", "*", " *,garbage", "<=1.11.0,>=1.14.1",
+    "2.0.0-rc.1 - 2.0.0", ">1.0.0,<1.5.0,>=3.0.0", "^1.4.0-alpha", "~1.4.0-dev.9", ">=1.4.0-dev,<1.4.0",
+    "1.0.0 - 2.0.0 - 3.0.0", ">=1.0.0,<<2.0.0", "<2.0.0,<1.0.0,>1.5.0", "1.0.0 -", "1.0.0 - ", "- 1.0.0",
+    "1.0.0 - 1.5.0, 2.0.0 - 2.3.4", "=1.2.3", "==1.2.3", "v1.2.3", "1.2.3 ", "1.2.3+b ", ">= 1.0.0", "1.0.0-beta.abc",
+    "^0.9.0,~1.17.0,!=1.17.0", "1.0.0 - ^1.5.0", "", ",,", "1.x.0", "1.4294967295.0", "1.4294967296.0",
+    ">1.0.0-beta.ab,<1.0.0", "1.0.0-beta.a", ">=1.9.9 - <=1.9.10", ">=1.2.0 <2.0.0", "1.0.0 || 2.0.0",
+    "^1.4.0 || >=3.0.0 <4.0.0",
+};
+
+static bool same_version(const SemVersion& a, const SemVersion& b) {
+    return a.major == b.major && a.minor == b.minor && a.patch == b.patch && a.cmp == b.cmp &&
+        a.prerelease == b.prerelease && strncmp(a.prerelease_str, b.prerelease_str, MAX_PRERELEASE_LEN) == 0 &&
+        strncmp(a.build_str, b.build_str, MAX_BUILD_LEN) == 0;
+}
+
+static char* test_parse() {
+    static const char* strings[] = {
+        "1.2.3", "v1.2.3", " V 1.2.3", ">=1.2.3", ">= 1.2.3", "^1.2.3", "~1.2.3-rc.1", "!=1.0.0", "==1.0.0", "=1.0.0",
+        "<1.0.0", ">1.0.0", "<=1.0.0", "1.2", "1.2.x", "x", "", "1. 2. 3", "1.2.3 ", "1.2.3+b1 ", "1.2.3+b1 x",
+        "1.2.3-alpha.1+build.5", "1.2.3-alpha-1", "1.2.3-", "1.2.3+", "1.2.3-0123456789abcdefghij",
+        "1.2.3+0123456789abcdefghij", "4294967295.0.0", "4294967296.0.0", "99999999999999999999.0.0", ">=v1.0.0",
+        "1.0.0-betax", "1.0.0-rc", "1.0.0_1",
+    };
+
+    bool same = true;
+    for (const char* str : strings) {
+        SemVersion expected, parsed;
+        int res = parse_version(str, &expected);
+        int ct_res = semver::detail::parse_version(semver::detail::TextView{ str, strlen(str) }, parsed);
+        same = same && res == ct_res && (res != SEMVER_OK || same_version(expected, parsed));
+    }
+    mu_assert("constexpr parser gives the same result", same);
+
+    constexpr auto ver = "1.2.3-beta.4+b5"_semver;
+    static_assert(ver.major() == 1 && ver.minor() == 2 && ver.patch() == 3 && ver.prerelease() == PRERELEASE_BETA);
+    mu_assert("Version literal", ver == semver::Version("1.2.3-beta.4+b5") && ver.build_str() == "b5");
+    mu_assert("Variable template", semver::static_version<"^2.0.0">.compare_operator() == COMPARE_MAJOR);
+
+    return 0;
+}
+
+static char* test_compare() {
+    bool same = true;
+    for (const char* a : version_strings) {
+        for (const char* b : version_strings) {
+            SemVersion ver_a, ver_b;
+            parse_version(a, &ver_a);
+            parse_version(b, &ver_b);
+            int r = compare_versions(&ver_a, &ver_b);
+            int ct = semver::detail::compare_versions(ver_a, ver_b);
+            same = same && (r > 0) == (ct > 0) && (r < 0) == (ct < 0);
+        }
+    }
+    mu_assert("constexpr compare gives the same sign", same);
+
+    static_assert(semver::detail::compare_versions("1.0.0-beta.10"_semver.c_version(), "1.0.0-beta.9"_semver.c_version()) > 0);
+    static_assert(semver::detail::compare_versions("1.0.0-dev"_semver.c_version(), "1.0.0-alpha"_semver.c_version()) < 0);
+
+    return 0;
+}
+
+static char* test_list() {
+    bool same = true;
+    for (const char* list : list_strings) {
+        auto compiled = semver::detail::compile_version_list<64>(semver::detail::TextView{ list, strlen(list) });
+        for (const char* v : version_strings) {
+            SemVersion ver;
+            parse_version(v, &ver);
+            int res = check_version(&ver, list);
+            if (compiled.error != SEMVER_OK) {
+                /* check_version can match before it reaches the invalid item */
+                same = same && (res == SEMVER_OK || res == SEMVER_OUT_OF_RANGE || res == SEMVER_INVALID_VERSION_LIST);
+                continue;
+            }
+            bool matched = compiled.matches(ver);
+            same = same && matched == (res == SEMVER_OK);
+        }
+    }
+    mu_assert("Compiled list matches as check_version", same);
+
+    return 0;
+}
+
+template <std::size_t N>
+static constexpr bool rejected(const char (&list)[N]) {
+    return semver::detail::compile_version_list<N>(semver::detail::TextView{ list, N - 1 }).error ==
+        SEMVER_INVALID_VERSION_LIST;
+}
+
+template <semver::detail::FixedString S>
+static bool agrees() {
+    constexpr auto constraint = semver::static_constraint<S>;
+    bool same = true;
+    for (const char* v : version_strings) {
+        SemVersion ver;
+        parse_version(v, &ver);
+        same = same && constraint.matches(ver) == (check_version(&ver, S.str) == SEMVER_OK);
+    }
+    return same;
+}
+
+static char* test_literal() {
+    constexpr auto supported = ">=2.3.0,<3.0.0,4.0.0"_semver_list;
+    static_assert(supported.matches("2.5.0"_semver) && supported.matches("4.0.0"_semver));
+    static_assert(! supported.matches("2.2.9"_semver) && ! supported.matches("3.0.0"_semver));
+    static_assert(supported.matches("3.0.0-rc.1"_semver));
+    static_assert(supported.size() == 2);
+    static_assert("^1.4.0"_semver_list.matches("1.99.0"_semver) && ! "^1.4.0"_semver_list.matches("2.0.0"_semver));
+    static_assert("~1.4.0"_semver_list.matches("1.4.7"_semver) && ! "~1.4.0"_semver_list.matches("1.5.0"_semver));
+    static_assert("1.0.0 - 1.9.9,3.0.0"_semver_list.size() == 2);
+    static_assert("*"_semver_list.matches("0.0.1"_semver));
+    /* npm-style lists are valid for check_version, but not as literals */
+    static_assert(rejected(">=1.2.0 <2.0.0") && rejected("1.0.0 || 2.0.0") && rejected("^1.4.0 || >=3.0.0 <4.0.0"));
+    static_assert(! rejected(">=1.2.0,<2.0.0") && ! rejected("1.0.0,2.0.0"));
+
+    mu_assert("Literal at run time", supported.matches(semver::Version("2.9.9")) && ! supported.matches(semver::Version("1.0.0")));
+    mu_assert("Literals match as check_version",
+            agrees<">=1.2.0,<2.0.0">() && agrees<"^1.4.0">() && agrees<"~2.3.1">() && agrees<"1.0.0 - 1.9.9,3.0.0">() &&
+            agrees<"!=1.5.0">() && agrees<"<=1.11.0,>=1.14.1">() && agrees<"2.0.0-rc.1 - 2.0.0">() &&
+            agrees<">1.0.0,<1.5.0,>=3.0.0">() && agrees<"^1.4.0-alpha">() && agrees<"<2.0.0,<1.0.0,>1.5.0">() &&
+            agrees<"1.0.0 - ">() && agrees<"1.0.0 - 1.5.0, 2.0.0 - 2.3.4">() && agrees<"v1.2.3">() &&
+            agrees<"^0.9.0,~1.17.0,!=1.17.0">() && agrees<"1.0.0 - ^1.5.0">() && agrees<">1.0.0-beta.ab,<1.0.0">());
+
+    return 0;
+}
+
+static char* all_tests() {
+    mu_run_test("constexpr parse", test_parse);
+    mu_run_test("constexpr compare", test_compare);
+    mu_run_test("Compiled version list", test_list);
+    mu_run_test("Version list literal", test_literal);
+    return 0;
+}
+
+int main (int argc, char** argv) {
+    char *result = all_tests();
+     if (result != 0) {
+         printf("%s\n", result);
+     }
+     else {
+         printf("ALL TESTS PASSED\n");
+     }
+     printf("Tests run: %d\n", tests_run);
+
+     return result != 0;
+}
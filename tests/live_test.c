@@ -0,0 +1,186 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include "semver.h"
+#include "semver_check.h"
+#include "semver_live.h"
+
+#include "unittest.h"
+#include "testutils.h"
+
+int tests_run = 0;
+
+#define VERSION_COUNT 20000
+#define WRITER_COUNT 2
+#define READER_COUNT 4
+
+static SemVersion versions[VERSION_COUNT];
+static SemVersion sorted[VERSION_COUNT];
+
+static char* test_index() {
+    unsigned int seed = 3;
+    random_versions(&seed, versions, VERSION_COUNT, 5, 20, 100, 0);
+
+    LiveIndex* index = create_live_index();
+    int distinct = 0;
+    for (int i = 0; i < VERSION_COUNT; i++) {
+        int added;
+        live_index_insert(index, &versions[i], &added);
+        if (added) {
+            sorted[distinct++] = versions[i];
+        }
+    }
+    qsort(sorted, distinct, sizeof(SemVersion), compare_for_qsort);
+    mu_assert("Count", live_index_count(index) == distinct);
+
+    LiveReader* reader = open_live_reader(index);
+    const LiveSnapshot* snapshot = live_reader_enter(reader);
+    int same = live_snapshot_count(snapshot) == distinct;
+    for (int i = 0; i < distinct && same; i++) {
+        SemVersion ver;
+        same = live_snapshot_get(snapshot, i, &ver) == SEMVER_OK && compare_versions(&ver, &sorted[i]) == 0;
+    }
+    mu_assert("Sorted distinct versions", same);
+
+    static const char* lists[] = {
+        "*", "^2.3.0", "~1.5.0,<0.5.0", ">=1.2.0 <2.0.0 || ^3.1.0", "<0.0.1", "5.0.0", "1.2.3-rc.1 - 1.2.3-alpha",
+        "<=2.5.50,!=2.5.50", ">3.0.0 !=4.19.99 !=4.19.98", "1.5.0,2.7.30", "!=4.19.99", ">=3.0.0-alpha,<3.0.0",
+    };
+    for (int i = 0; i < sizeof(lists) / sizeof(lists[0]); i++) {
+        int expected = distinct - 1;
+        while (expected >= 0 && check_version(&sorted[expected], lists[i]) != SEMVER_OK) {
+            expected--;
+        }
+        SemVersion ver;
+        same &= live_snapshot_max_satisfying(snapshot, lists[i], &ver) == expected;
+    }
+    mu_assert("Max satisfying", same);
+    mu_assert("Invalid list", live_snapshot_max_satisfying(snapshot, "1.x", NULL) == -1);
+    live_reader_exit(reader);
+
+    close_live_reader(&reader);
+    mu_assert("Reader closed", reader == NULL);
+    free_live_index(&index);
+    mu_assert("Index freed", index == NULL);
+    return 0;
+}
+
+typedef struct stress_t {
+    LiveIndex* index;
+    atomic_int writers_done;
+    atomic_int errors;
+} Stress;
+
+static Stress stress;
+
+static void* write_versions(void* arg) {
+    int part = *(int*)arg;
+    for (int i = part; i < VERSION_COUNT; i += WRITER_COUNT) {
+        if (live_index_insert(stress.index, &sorted[i], NULL) != SEMVER_OK) {
+            atomic_fetch_add(&stress.errors, 1);
+        }
+    }
+    atomic_fetch_add(&stress.writers_done, 1);
+    return NULL;
+}
+
+/* Every snapshot must be sorted, have all versions of the previous one,
+ * and its max satisfying version must be the highest one */
+static void* read_versions(void* arg) {
+    LiveReader* reader = open_live_reader(stress.index);
+    int prev_count = 0;
+    SemVersion prev_max;
+    int iterations = 0;
+
+    while (atomic_load(&stress.writers_done) < WRITER_COUNT || iterations < 10) {
+        const LiveSnapshot* snapshot = live_reader_enter(reader);
+        int count = live_snapshot_count(snapshot);
+        int ok = count >= prev_count;
+
+        SemVersion prev, ver;
+        for (int i = 0; i < count && ok; i += 1 + iterations % 7) {
+            ok = live_snapshot_get(snapshot, i, &ver) == SEMVER_OK && (i == 0 || compare_versions(&prev, &ver) < 0);
+            prev = ver;
+        }
+        if (ok && count > 0) {
+            SemVersion max;
+            ok = live_snapshot_max_satisfying(snapshot, "*", &max) == count - 1 &&
+                live_snapshot_get(snapshot, count - 1, &ver) == SEMVER_OK && compare_versions(&max, &ver) == 0 &&
+                (prev_count == 0 || compare_versions(&prev_max, &max) <= 0);
+            prev_max = max;
+        }
+        live_reader_exit(reader);
+
+        if (! ok) {
+            atomic_fetch_add(&stress.errors, 1);
+        }
+        prev_count = count;
+        iterations++;
+    }
+
+    close_live_reader(&reader);
+    return NULL;
+}
+
+static char* test_stress() {
+    unsigned int seed = 7;
+    int count = 0;
+    for (int i = 0; i < VERSION_COUNT; i++) {
+        char str[64];
+        snprintf(str, sizeof(str), "%d.%d.%d", i / 1000, i / 10 % 100, i % 10);
+        parse_version(str, &sorted[count++]);
+    }
+    /* shuffle the insert order */
+    for (int i = count - 1; i > 0; i--) {
+        int j = next_random(&seed) % (i + 1);
+        SemVersion tmp = sorted[i];
+        sorted[i] = sorted[j];
+        sorted[j] = tmp;
+    }
+
+    stress.index = create_live_index();
+    atomic_init(&stress.writers_done, 0);
+    atomic_init(&stress.errors, 0);
+
+    pthread_t writers[WRITER_COUNT], readers[READER_COUNT];
+    int parts[WRITER_COUNT];
+    for (int i = 0; i < READER_COUNT; i++) {
+        pthread_create(&readers[i], NULL, read_versions, NULL);
+    }
+    for (int i = 0; i < WRITER_COUNT; i++) {
+        parts[i] = i;
+        pthread_create(&writers[i], NULL, write_versions, &parts[i]);
+    }
+    for (int i = 0; i < WRITER_COUNT; i++) {
+        pthread_join(writers[i], NULL);
+    }
+    for (int i = 0; i < READER_COUNT; i++) {
+        pthread_join(readers[i], NULL);
+    }
+
+    mu_assert("Consistent snapshots", atomic_load(&stress.errors) == 0);
+    mu_assert("All versions are added", live_index_count(stress.index) == VERSION_COUNT);
+    free_live_index(&stress.index);
+    return 0;
+}
+
+static char* all_tests() {
+    mu_run_test("Live index", test_index);
+    mu_run_test("Concurrent readers and writers", test_stress);
+    return 0;
+}
+
+int main (int argc, char** argv) {
+    char *result = all_tests();
+     if (result != 0) {
+         printf("%s\n", result);
+     }
+     else {
+         printf("ALL TESTS PASSED\n");
+     }
+     printf("Tests run: %d\n", tests_run);
+
+     return result != 0;
+}
@@ -0,0 +1,198 @@
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include "semver.h"
+#include "semver_policy.h"
+
+#include "unittest.h"
+
+int tests_run = 0;
+
+#define POLICY_FILE "policy_test.txt"
+#define RELOAD_COUNT 2000
+#define READER_COUNT 3
+
+static const char* policy =
+    "# gateway policy\n"
+    "*     deny  1.0.0-rc.1\n"
+    "\n"
+    "alpha allow >=1.2.0 <2.0.0 || ^3.1.0\n"
+    "alpha deny  1.5.0 || 1.6.0-alpha\n"
+    "beta  deny  <1.0.0\r\n"
+    "gamma allow 2.0.0\n"
+    "gamma allow 2.1.0";
+
+static int check(const PolicySnapshot* snapshot, const char* package, const char* version) {
+    SemVersion ver;
+    parse_version(version, &ver);
+    return check_policy(snapshot, package, &ver);
+}
+
+static char* test_policy() {
+    PolicySet* set = create_policy_set();
+    PolicyReader* reader = open_policy_reader(set);
+    const PolicySnapshot* snapshot = policy_reader_enter(reader);
+    mu_assert("Empty policy", policy_snapshot_generation(snapshot) == 0 && check(snapshot, "alpha", "0.1.0") == SEMVER_OK);
+    policy_reader_exit(reader);
+
+    int line;
+    int res = reload_policy_set(set, policy, strlen(policy), &line);
+    mu_assert("Reload", res == SEMVER_OK && line == 0);
+    snapshot = policy_reader_enter(reader);
+    mu_assert("Generation", policy_snapshot_generation(snapshot) == 1);
+    mu_assert("Allowed range", check(snapshot, "alpha", "1.2.0") == SEMVER_OK);
+    mu_assert("Allowed second range", check(snapshot, "alpha", "3.4.0") == SEMVER_OK);
+    mu_assert("Not allowed", check(snapshot, "alpha", "2.0.0") == SEMVER_OUT_OF_RANGE);
+    mu_assert("Denied by package", check(snapshot, "alpha", "1.5.0") == SEMVER_OUT_OF_RANGE);
+    mu_assert("Allowed next to denied", check(snapshot, "alpha", "1.5.1") == SEMVER_OK);
+    mu_assert("Denied", check(snapshot, "beta", "0.9.0") == SEMVER_OUT_OF_RANGE);
+    mu_assert("No allow rules", check(snapshot, "beta", "7.0.0") == SEMVER_OK);
+    mu_assert("Denied for all", check(snapshot, "beta", "1.0.0-rc.1") == SEMVER_OUT_OF_RANGE);
+    mu_assert("Denied for unknown", check(snapshot, "delta", "1.0.0-rc.1") == SEMVER_OUT_OF_RANGE);
+    mu_assert("Unknown package", check(snapshot, "delta", "1.0.0") == SEMVER_OK);
+    mu_assert("Any allow rule", check(snapshot, "gamma", "2.1.0") == SEMVER_OK);
+    mu_assert("Not in allow rules", check(snapshot, "gamma", "2.0.1") == SEMVER_OUT_OF_RANGE);
+    mu_assert("Prefix of a package", check(snapshot, "gam", "2.0.1") == SEMVER_OK);
+    mu_assert("NULL package", check(snapshot, NULL, "2.0.1") == SEMVER_INVALID_VERSION);
+    policy_reader_exit(reader);
+
+    static const struct {
+        const char* text;
+        int res;
+        int line;
+    } invalid[] = {
+        { "alpha allow 1.0.0\nalpha permit 1.0.0\n", SEMVER_INVALID_VERSION_LIST, 2 },
+        { "\n\n# comment\nalpha deny\n", SEMVER_INVALID_VERSION_LIST, 4 },
+        { "alpha allow >=1.0.0,garbage", SEMVER_INVALID_VERSION_LIST, 1 },
+        { "alpha", SEMVER_INVALID_VERSION_LIST, 1 },
+    };
+    for (int i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++) {
+        res = reload_policy_set(set, invalid[i].text, strlen(invalid[i].text), &line);
+        mu_assert("Invalid policy", res == invalid[i].res && line == invalid[i].line);
+    }
+    snapshot = policy_reader_enter(reader);
+    mu_assert("Policy is kept", policy_snapshot_generation(snapshot) == 1 &&
+            check(snapshot, "beta", "0.9.0") == SEMVER_OUT_OF_RANGE);
+    policy_reader_exit(reader);
+
+    FILE* f = fopen(POLICY_FILE, "wb");
+    fputs("beta allow 0.9.0\n", f);
+    fclose(f);
+    res = load_policy_file(set, POLICY_FILE, &line);
+    remove(POLICY_FILE);
+    mu_assert("Load file", res == SEMVER_OK);
+    snapshot = policy_reader_enter(reader);
+    mu_assert("File policy", policy_snapshot_generation(snapshot) == 2 &&
+            check(snapshot, "beta", "0.9.0") == SEMVER_OK && check(snapshot, "beta", "1.0.0") == SEMVER_OUT_OF_RANGE);
+    policy_reader_exit(reader);
+    mu_assert("No file", load_policy_file(set, POLICY_FILE, &line) == SEMVER_IO_ERROR);
+
+    close_policy_reader(&reader);
+    free_policy_set(&set);
+    return 0;
+}
+
+static char* test_pinned() {
+    PolicySet* set = create_policy_set();
+    PolicyReader* reader = open_policy_reader(set);
+    PolicyReader* other = open_policy_reader(set);
+    reload_policy_set(set, "alpha deny 1.0.0", 16, NULL);
+
+    const PolicySnapshot* pinned = policy_reader_enter(reader);
+    reload_policy_set(set, "alpha allow 1.0.0", 17, NULL);
+    reload_policy_set(set, "alpha allow 2.0.0", 17, NULL);
+    mu_assert("Pinned policy", policy_snapshot_generation(pinned) == 1 &&
+            check(pinned, "alpha", "1.0.0") == SEMVER_OUT_OF_RANGE);
+
+    const PolicySnapshot* latest = policy_reader_enter(other);
+    mu_assert("Latest policy", policy_snapshot_generation(latest) == 3 &&
+            check(latest, "alpha", "1.0.0") == SEMVER_OUT_OF_RANGE && check(latest, "alpha", "2.0.0") == SEMVER_OK);
+    policy_reader_exit(other);
+    policy_reader_exit(reader);
+
+    close_policy_reader(&reader);
+    mu_assert("Reader is reused", open_policy_reader(set) != NULL);
+    free_policy_set(&set);
+    return 0;
+}
+
+/* Odd generations deny the version 1.0.0 and even ones allow only it */
+static const char* policies[] = { "alpha allow 1.0.0\n", "# odd\nalpha deny 1.0.0\nbeta allow 1.0.0\n" };
+
+typedef struct reload_state_t {
+    PolicySet* set;
+    atomic_int done;
+    atomic_int errors;
+} ReloadState;
+
+static void* reader_main(void* arg) {
+    ReloadState* state = arg;
+    PolicyReader* reader = open_policy_reader(state->set);
+    SemVersion one, two;
+    parse_version("1.0.0", &one);
+    parse_version("2.0.0", &two);
+
+    while (! atomic_load(&state->done)) {
+        const PolicySnapshot* snapshot = policy_reader_enter(reader);
+        int odd = policy_snapshot_generation(snapshot) % 2;
+        for (int i = 0; i < 16; i++) {
+            int expected = odd ? SEMVER_OUT_OF_RANGE : SEMVER_OK;
+            if (check_policy(snapshot, "alpha", &one) != expected ||
+                    check_policy(snapshot, "alpha", &two) != (odd ? SEMVER_OK : SEMVER_OUT_OF_RANGE)) {
+                atomic_fetch_add(&state->errors, 1);
+            }
+        }
+        policy_reader_exit(reader);
+    }
+
+    close_policy_reader(&reader);
+    return NULL;
+}
+
+static char* test_reload() {
+    ReloadState state;
+    state.set = create_policy_set();
+    reload_policy_set(state.set, policies[1], strlen(policies[1]), NULL);
+    atomic_init(&state.done, 0);
+    atomic_init(&state.errors, 0);
+
+    pthread_t readers[READER_COUNT];
+    for (int i = 0; i < READER_COUNT; i++) {
+        pthread_create(&readers[i], NULL, reader_main, &state);
+    }
+    int failed = 0;
+    for (int i = 0; i < RELOAD_COUNT; i++) {
+        const char* text = policies[i % 2];
+        failed |= reload_policy_set(state.set, text, strlen(text), NULL) != SEMVER_OK;
+    }
+    atomic_store(&state.done, 1);
+    for (int i = 0; i < READER_COUNT; i++) {
+        pthread_join(readers[i], NULL);
+    }
+    mu_assert("Reloads", ! failed);
+    mu_assert("Checks match the generation", atomic_load(&state.errors) == 0);
+
+    free_policy_set(&state.set);
+    return 0;
+}
+
+static char* all_tests() {
+    mu_run_test("Policy rules", test_policy);
+    mu_run_test("Pinned policy", test_pinned);
+    mu_run_test("Reload under checks", test_reload);
+    return 0;
+}
+
+int main (int argc, char** argv) {
+    char *result = all_tests();
+     if (result != 0) {
+         printf("%s\n", result);
+     }
+     else {
+         printf("ALL TESTS PASSED\n");
+     }
+     printf("Tests run: %d\n", tests_run);
+
+     return result != 0;
+}
@@ -0,0 +1,134 @@
+#include <stdio.h>
+#include <algorithm>
+#include <unordered_set>
+#include <vector>
+#include "semver_scheme.hpp"
+
+#include "unittest.h"
+
+int tests_run = 0;
+
+#define VERSION_COUNT 2000
+
+static const char* prereleases[] = {
+    "", "", "alpha", "alpha.1", "alpha.01", "beta.2", "beta.10", "rc.1", "rc.1a", "dev", "dev.3", "x.y.z",
+};
+
+static unsigned int next_random(unsigned int* seed) {
+    *seed = *seed * 1103515245 + 12345;
+    return *seed >> 16;
+}
+
+static char* test_parse() {
+    semver::QuadVersion quad = semver::QuadVersion::parse("1.2.3.4+b5");
+    mu_assert("Four parts", quad.part(0) == 1 && quad.part(1) == 2 && quad.part(2) == 3 && quad.part(3) == 4 &&
+            quad.build_str() == "b5");
+    semver::CalendarVersion cal = semver::CalendarVersion::parse("2026.10.17");
+    mu_assert("Calendar version", cal.part(0) == 2026 && cal.part(1) == 10 && cal.part(2) == 17);
+
+    int error = SEMVER_OK;
+    mu_assert("Too few parts", ! semver::QuadVersion::try_parse("1.2.3", &error) && error == SEMVER_INVALID_PATCH);
+    mu_assert("Too many parts", ! semver::QuadVersion::try_parse("1.2.3.4.5", &error) && error == SEMVER_INVALID_VERSION);
+    mu_assert("No prerelease", ! semver::CalendarVersion::try_parse("2026.10.17-rc", &error) &&
+            error == SEMVER_INVALID_PRERELEASE);
+    mu_assert("Operators are not versions", ! semver::SemanticVersion::try_parse(">=1.0.0"));
+
+    static const char* strings[] = {
+        "1.2.3", "v1.2.3", "1. 2. 3", "1.2.3 ", "1.2.3+b1 ", "1.2.3-alpha.1+build.5", "1.2.3-", "1.2.3+",
+        "1.2.3-0123456789abcdefghij", "4294967295.0.0", "4294967296.0.0", "1.2", "1.2.x", "1.0.0_1",
+    };
+    bool same = true;
+    for (const char* str : strings) {
+        SemVersion expected;
+        int res = parse_version(str, &expected);
+        semver::SemanticVersion ver;
+        same = same && semver::SemanticVersion::parse(str, ver) == res &&
+            (res != SEMVER_OK || ver == semver::SemanticVersion(expected));
+    }
+    mu_assert("Semantic version parses as parse_version", same);
+
+    constexpr auto ct = semver::QuadVersion::try_parse("10.0.19041.1");
+    static_assert(ct.has_value() && ct->part(2) == 19041);
+
+    return 0;
+}
+
+static char* test_semantic() {
+    std::vector<SemVersion> versions(VERSION_COUNT);
+    unsigned int seed = 3;
+    for (SemVersion& ver : versions) {
+        char str[128];
+        const char* pre = prereleases[next_random(&seed) % (sizeof(prereleases) / sizeof(prereleases[0]))];
+        snprintf(str, sizeof(str), "%u.%u.%u%s%s", next_random(&seed) % 3, next_random(&seed) % 3,
+                next_random(&seed) % 3, *pre ? "-" : "", pre);
+        parse_version(str, &ver);
+    }
+
+    bool compared = true;
+    bool hashed = true;
+    bool keyed = true;
+    for (int i = 0; i < VERSION_COUNT; i += 7) {
+        semver::SemanticVersion a(versions[i]);
+        hashed = hashed && a.hash() == hash_version(&versions[i], 0);
+        for (int j = 0; j < VERSION_COUNT; j++) {
+            semver::SemanticVersion b(versions[j]);
+            int res = compare_versions(&versions[i], &versions[j]);
+            int r = compare(a, b);
+            compared = compared && (res < 0) == (r < 0) && (res > 0) == (r > 0);
+            keyed = keyed && (a.key() < b.key() ? r < 0 : true) && (r < 0 ? a.key() <= b.key() : true);
+        }
+    }
+    mu_assert("Compare as compare_versions", compared);
+    mu_assert("Hash as hash_version", hashed);
+    mu_assert("Key order", keyed);
+
+    return 0;
+}
+
+static char* test_quad() {
+    std::vector<semver::QuadVersion> versions;
+    unsigned int seed = 7;
+    for (int i = 0; i < VERSION_COUNT; i++) {
+        char str[64];
+        snprintf(str, sizeof(str), "%u.%u.%u.%u", next_random(&seed) % 3, next_random(&seed) % 3,
+                next_random(&seed) % 3, next_random(&seed) % 3);
+        versions.push_back(semver::QuadVersion::parse(str));
+    }
+
+    std::vector<semver::QuadVersion> by_key = versions;
+    std::sort(versions.begin(), versions.end());
+    std::sort(by_key.begin(), by_key.end(), [](const semver::QuadVersion& a, const semver::QuadVersion& b) {
+        return a.key() < b.key();
+    });
+    mu_assert("Key gives the same order", versions == by_key);
+    mu_assert("Fourth part counts", semver::QuadVersion::parse("1.0.0.2") > semver::QuadVersion::parse("1.0.0.1"));
+
+    std::unordered_set<semver::QuadVersion> set(versions.begin(), versions.end());
+    mu_assert("Distinct versions", set.size() == 81);
+
+    static_assert(semver::CalendarVersion::try_parse("2026.10.17")->hash() !=
+            semver::CalendarVersion::try_parse("2026.10.18")->hash());
+    static_assert(sizeof(semver::QuadVersion::Key) == 16 && sizeof(semver::SemanticVersion::Key) == 16);
+
+    return 0;
+}
+
+static char* all_tests() {
+    mu_run_test("Scheme parse", test_parse);
+    mu_run_test("Semantic version", test_semantic);
+    mu_run_test("Four part version", test_quad);
+    return 0;
+}
+
+int main (int argc, char** argv) {
+    char *result = all_tests();
+     if (result != 0) {
+         printf("%s\n", result);
+     }
+     else {
+         printf("ALL TESTS PASSED\n");
+     }
+     printf("Tests run: %d\n", tests_run);
+
+     return result != 0;
+}
@@ -0,0 +1,105 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "semver.h"
+#include "semver_search.h"
+
+#include "unittest.h"
+#include "testutils.h"
+
+int tests_run = 0;
+
+#define VERSION_COUNT 5000
+
+static const unsigned int numbers[] = { 0, 1, 2, 7, 1048574, 1048575, 1048576, 4000000000u };
+
+static void random_version(unsigned int* seed, SemVersion* ver) {
+    char str[128];
+    const char* pre = random_prerelease(seed);
+    unsigned int major = numbers[next_random(seed) % (sizeof(numbers) / sizeof(numbers[0]))];
+    snprintf(str, sizeof(str), "%u.%u.%u%s%s", major, next_random(seed) % 3, numbers[next_random(seed) % 4],
+            *pre ? "-" : "", pre);
+    parse_version(str, ver);
+}
+
+static int reference_bound(const SemVersion* versions, int count, const SemVersion* ver, int upper) {
+    int i = 0;
+    while (i < count && (upper ? compare_versions(&versions[i], ver) <= 0 : compare_versions(&versions[i], ver) < 0)) {
+        i++;
+    }
+    return i;
+}
+
+static char* test_search() {
+    static SemVersion versions[VERSION_COUNT];
+    unsigned int seed = 3;
+    int same = 1;
+
+    for (int count = 0; count <= VERSION_COUNT; count = count < 40 ? count + 1 : count * 5) {
+        for (int i = 0; i < count; i++) {
+            random_version(&seed, &versions[i]);
+        }
+        qsort(versions, count, sizeof(SemVersion), compare_for_qsort);
+
+        int error;
+        VersionSearch* search = build_version_search(versions, count, &error);
+        mu_assert("Index is built", search != NULL && error == SEMVER_OK);
+
+        for (int i = 0; i < 500; i++) {
+            SemVersion ver;
+            random_version(&seed, &ver);
+            int lower = reference_bound(versions, count, &ver, 0);
+            int upper = reference_bound(versions, count, &ver, 1);
+            int rank;
+            int found = version_search_contains(search, &ver, &rank);
+            if (version_search_lower_bound(search, &ver) != lower || version_search_upper_bound(search, &ver) != upper ||
+                    found != (lower < upper) || rank != lower) {
+                printf("%d versions, %u.%u.%u-%s: %d %d, expected %d %d\n", count, ver.major, ver.minor, ver.patch,
+                        ver.prerelease_str, version_search_lower_bound(search, &ver),
+                        version_search_upper_bound(search, &ver), lower, upper);
+                same = 0;
+            }
+        }
+        free_version_search(&search);
+    }
+    mu_assert("Same bounds as linear search", same);
+
+    return 0;
+}
+
+static char* test_invalid() {
+    SemVersion versions[2];
+    parse_version("2.0.0", &versions[0]);
+    parse_version("1.0.0", &versions[1]);
+
+    int error;
+    mu_assert("Unsorted versions", build_version_search(versions, 2, &error) == NULL && error == SEMVER_INVALID_VERSION);
+    mu_assert("NULL array", build_version_search(NULL, 2, &error) == NULL && error == SEMVER_INVALID_VERSION);
+
+    VersionSearch* search = build_version_search(versions + 1, 1, NULL);
+    mu_assert("One version", search != NULL && version_search_contains(search, &versions[1], NULL) &&
+            ! version_search_contains(search, &versions[0], NULL) && version_search_lower_bound(search, &versions[0]) == 1);
+    free_version_search(&search);
+    mu_assert("Index freed", search == NULL);
+
+    return 0;
+}
+
+static char* all_tests() {
+    mu_run_test("Eytzinger search", test_search);
+    mu_run_test("Invalid arrays", test_invalid);
+    return 0;
+}
+
+int main (int argc, char** argv) {
+    char *result = all_tests();
+     if (result != 0) {
+         printf("%s\n", result);
+     }
+     else {
+         printf("ALL TESTS PASSED\n");
+     }
+     printf("Tests run: %d\n", tests_run);
+
+     return result != 0;
+}
@@ -0,0 +1,138 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "semver.h"
+#include "semver_set.h"
+
+#include "unittest.h"
+#include "testutils.h"
+
+int tests_run = 0;
+
+#define MAX_SET_SIZE 20000
+
+static SemVersion set_a[MAX_SET_SIZE];
+static SemVersion set_b[MAX_SET_SIZE];
+static SemVersion result[2 * MAX_SET_SIZE];
+static SemVersion expected[2 * MAX_SET_SIZE];
+
+static int sort_flags = 0;
+
+static int compare_for_sort(const void* a, const void* b) {
+    return compare_set_versions(a, b, sort_flags);
+}
+
+static void build_set(SemVersion* versions, int count, unsigned int range, unsigned int* seed, int flags) {
+    random_versions(seed, versions, count, range, 4, 4, RANDOM_BUILDS);
+    sort_flags = flags;
+    qsort(versions, count, sizeof(SemVersion), compare_for_sort);
+}
+
+/* Plain merge without galloping */
+static int reference_merge(int count_a, int count_b, int flags, int only_a, int only_b, int both) {
+    int i = 0, j = 0, n = 0;
+    while (i < count_a || j < count_b) {
+        int res = i == count_a ? 1 : (j == count_b ? -1 : compare_set_versions(&set_a[i], &set_b[j], flags));
+        if (res < 0) {
+            if (only_a) {
+                expected[n++] = set_a[i];
+            }
+            i++;
+        } else if (res > 0) {
+            if (only_b) {
+                expected[n++] = set_b[j];
+            }
+            j++;
+        } else {
+            if (both) {
+                expected[n++] = set_a[i];
+            }
+            i++;
+            j++;
+        }
+    }
+    return n;
+}
+
+static int check_operations(int count_a, int count_b, int flags) {
+    int matched = 1;
+    int count;
+
+    int n = reference_merge(count_a, count_b, flags, 1, 1, 1);
+    matched &= version_set_union(set_a, count_a, set_b, count_b, flags, result, 2 * MAX_SET_SIZE, &count) == SEMVER_OK &&
+        count == n && memcmp(result, expected, n * sizeof(SemVersion)) == 0;
+    n = reference_merge(count_a, count_b, flags, 0, 0, 1);
+    matched &= version_set_intersection(set_a, count_a, set_b, count_b, flags, result, 2 * MAX_SET_SIZE, &count) == SEMVER_OK &&
+        count == n && memcmp(result, expected, n * sizeof(SemVersion)) == 0;
+    n = reference_merge(count_a, count_b, flags, 1, 0, 0);
+    matched &= version_set_difference(set_a, count_a, set_b, count_b, flags, result, 2 * MAX_SET_SIZE, &count) == SEMVER_OK &&
+        count == n && memcmp(result, expected, n * sizeof(SemVersion)) == 0;
+    n = reference_merge(count_a, count_b, flags, 1, 1, 0);
+    matched &= version_set_symmetric_difference(set_a, count_a, set_b, count_b, flags, result, 2 * MAX_SET_SIZE, &count) == SEMVER_OK &&
+        count == n && memcmp(result, expected, n * sizeof(SemVersion)) == 0;
+
+    return matched;
+}
+
+static char* test_set_operations() {
+    static const int sizes[][2] = { { 1000, 1000 }, { 10, MAX_SET_SIZE }, { MAX_SET_SIZE, 3 }, { 0, 100 }, { 500, 0 } };
+    unsigned int seed = 11;
+
+    int matched = 1;
+    for (int flags = 0; flags <= VERSION_SET_COMPARE_BUILD; flags++) {
+        for (int s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+            build_set(set_a, sizes[s][0], 300, &seed, flags);
+            build_set(set_b, sizes[s][1], 300, &seed, flags);
+            matched &= check_operations(sizes[s][0], sizes[s][1], flags);
+        }
+        /* long runs that do not overlap */
+        build_set(set_a, 1000, 10, &seed, flags);
+        build_set(set_b, 1000, 300, &seed, flags);
+        matched &= check_operations(1000, 1000, flags);
+    }
+    mu_assert("Set operations are the same as a plain merge gives", matched);
+
+    return 0;
+}
+
+static char* test_set_equality() {
+    SemVersion a[3], b[2];
+    int count;
+    parse_version("1.0.0", &a[0]);
+    parse_version("1.0.0", &a[1]);
+    parse_version("2.0.0+b1", &a[2]);
+    parse_version("1.0.0", &b[0]);
+    parse_version("2.0.0+b2", &b[1]);
+
+    mu_assert("Duplicates", version_set_intersection(a, 3, b, 2, 0, result, 10, &count) == SEMVER_OK && count == 2);
+    mu_assert("Build is ignored", version_set_difference(a, 3, b, 2, 0, result, 10, &count) == SEMVER_OK &&
+            count == 1 && compare_versions(&result[0], &b[0]) == 0);
+    mu_assert("Build is compared", version_set_difference(a, 3, b, 2, VERSION_SET_COMPARE_BUILD, result, 10, &count) == SEMVER_OK &&
+            count == 2 && strcmp(result[1].build_str, "b1") == 0);
+
+    mu_assert("Small buffer", version_set_union(a, 3, b, 2, 0, result, 2, &count) == SEMVER_BUFFER_TOO_SMALL && count == 3);
+    mu_assert("Count only", version_set_union(a, 3, b, 2, VERSION_SET_COMPARE_BUILD, NULL, 0, &count) == SEMVER_BUFFER_TOO_SMALL &&
+            count == 4);
+    mu_assert("Invalid set", version_set_union(NULL, 3, b, 2, 0, result, 10, &count) == SEMVER_INVALID_VERSION);
+
+    return 0;
+}
+
+static char* all_tests() {
+    mu_run_test("Set operations", test_set_operations);
+    mu_run_test("Set equality", test_set_equality);
+    return 0;
+}
+
+int main (int argc, char** argv) {
+    char *result = all_tests();
+     if (result != 0) {
+         printf("%s\n", result);
+     }
+     else {
+         printf("ALL TESTS PASSED\n");
+     }
+     printf("Tests run: %d\n", tests_run);
+
+     return result != 0;
+}
@@ -0,0 +1,224 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#endif
+#include "semver.h"
+#include "semver_blob.h"
+#include "semver_check.h"
+#include "semver_shared.h"
+
+#include "unittest.h"
+#include "testutils.h"
+
+int tests_run = 0;
+
+#define CACHE_SIZE (1 << 20)
+#define LIST_COUNT 2000
+#define PROCESS_COUNT 4
+
+static const char* versions[] = {
+    "1.0.0", "1.2.3", "1.5.0", "2.0.0-rc.1", "2.0.0", "2.3.4", "3.1.0", "0.9.1",
+};
+
+static char lists[LIST_COUNT][64];
+static char cache_name[64];
+
+static void build_lists() {
+    for (int i = 0; i < LIST_COUNT; i++) {
+        switch (i % 4) {
+            case 0: snprintf(lists[i], sizeof(lists[i]), "^%d.%d.0", i % 3, i); break;
+            case 1: snprintf(lists[i], sizeof(lists[i]), ">=1.%d.0 <2.0.0 || ~3.%d.0", i % 7, i); break;
+            case 2: snprintf(lists[i], sizeof(lists[i]), "1.0.0 - 2.%d.0,!=1.5.%d", i % 5, i); break;
+            default: snprintf(lists[i], sizeof(lists[i]), "<=%d.0.0,>2.3.%d", i % 4, i); break;
+        }
+    }
+}
+
+/* Returns 1 if the cached blob has the same bytes as the list compiled here */
+static int same_blob(const char* list, const unsigned char* blob, size_t size) {
+    unsigned char expected[1024];
+    size_t expected_size;
+    if (compile_version_list(list, expected, sizeof(expected), &expected_size) != SEMVER_OK) {
+        return 0;
+    }
+    return size == expected_size && memcmp(blob, expected, size) == 0;
+}
+
+static char* test_cache() {
+    snprintf(cache_name, sizeof(cache_name), "/semver_shared_test_%d", (int)getpid());
+    remove_shared_cache(cache_name);
+
+    SharedCache* cache;
+    mu_assert("Too small", open_shared_cache(cache_name, 100, &cache) == SEMVER_IO_ERROR);
+    mu_assert("Open", open_shared_cache(cache_name, CACHE_SIZE, &cache) == SEMVER_OK);
+
+    const unsigned char* blob;
+    const unsigned char* again;
+    size_t size, again_size;
+    int res = shared_cache_get(cache, lists[1], &blob, &size);
+    mu_assert("Compiled", res == SEMVER_OK && same_blob(lists[1], blob, size));
+    res = shared_cache_get(cache, lists[1], &again, &again_size);
+    mu_assert("Cached", res == SEMVER_OK && again == blob && again_size == size);
+    mu_assert("Invalid list", shared_cache_get(cache, ">=1.0.0,garbage", &blob, &size) == SEMVER_INVALID_VERSION_LIST);
+    mu_assert("NULL cache", shared_cache_get(NULL, lists[1], &blob, &size) == SEMVER_INVALID_HANDLE);
+
+    SharedCacheStats stats;
+    shared_cache_stats(cache, &stats);
+    mu_assert("One entry", stats.entry_count == 1 && stats.data_used > 0 && stats.data_used < stats.data_size);
+
+    /* the second mapping is at another address */
+    SharedCache* other;
+    mu_assert("Open existing", open_shared_cache(cache_name, SHARED_CACHE_MIN_SIZE, &other) == SEMVER_OK);
+    res = shared_cache_get(other, lists[1], &again, &again_size);
+    mu_assert("Shared entry", res == SEMVER_OK && again != blob && same_blob(lists[1], again, again_size));
+    shared_cache_stats(other, &stats);
+    mu_assert("Size of existing cache", stats.entry_count == 1 && stats.data_size > CACHE_SIZE / 2);
+    close_shared_cache(&other);
+
+    int same = 1;
+    for (int i = 0; i < 100; i++) {
+        for (int j = 0; j < sizeof(versions) / sizeof(versions[0]); j++) {
+            SemVersion ver;
+            parse_version(versions[j], &ver);
+            same &= check_version_shared(cache, &ver, lists[i]) == check_version(&ver, lists[i]);
+        }
+    }
+    mu_assert("Same result as check_version", same);
+
+#ifndef _WIN32
+    /* a peer that rewrites the layout after the cache is opened */
+    int fd = shm_open(cache_name, O_RDWR, 0);
+    unsigned int* header = fd < 0 ? MAP_FAILED : mmap(NULL, 32, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    mu_assert("Map header", header != MAP_FAILED);
+    close(fd);
+    header[2] = 0x80000000u;
+    header[3] = 0xFFFFFFF0u;
+    header[4] = 0;
+    munmap(header, 32);
+    for (int i = 100; i < 200; i++) {
+        res = shared_cache_get(cache, lists[i], &blob, &size);
+        same &= res == SEMVER_OK && same_blob(lists[i], blob, size);
+    }
+    mu_assert("Layout is read once", same);
+#endif
+
+    close_shared_cache(&cache);
+    mu_assert("Remove", remove_shared_cache(cache_name) == SEMVER_OK);
+    mu_assert("Removed", remove_shared_cache(cache_name) == SEMVER_IO_ERROR);
+    return 0;
+}
+
+static char* test_full() {
+    SharedCache* cache;
+    mu_assert("Open small", open_shared_cache(cache_name, SHARED_CACHE_MIN_SIZE, &cache) == SEMVER_OK);
+
+    int full = 0, same = 1;
+    for (int i = 0; i < 200; i++) {
+        const unsigned char* blob;
+        size_t size;
+        int res = shared_cache_get(cache, lists[i], &blob, &size);
+        full |= res == SEMVER_BUFFER_TOO_SMALL;
+        same &= res == SEMVER_BUFFER_TOO_SMALL || (res == SEMVER_OK && same_blob(lists[i], blob, size));
+
+        SemVersion ver;
+        parse_version(versions[i % (sizeof(versions) / sizeof(versions[0]))], &ver);
+        same &= check_version_shared(cache, &ver, lists[i]) == check_version(&ver, lists[i]);
+    }
+    mu_assert("Cache is full", full);
+    mu_assert("Lists that are not cached are checked", same);
+    close_shared_cache(&cache);
+
+#ifndef _WIN32
+    /* a segment with another layout */
+    int fd = shm_open(cache_name, O_RDWR, 0);
+    unsigned int garbage = 0xFFFFFFFF;
+    mu_assert("Overwrite", fd >= 0 && write(fd, &garbage, sizeof(garbage)) == sizeof(garbage));
+    close(fd);
+    mu_assert("Not a cache", open_shared_cache(cache_name, CACHE_SIZE, &cache) == SEMVER_INVALID_BLOB);
+    remove_shared_cache(cache_name);
+#endif
+    return 0;
+}
+
+#ifndef _WIN32
+/* Every process gets all lists in its own order and checks the bytes */
+static int process_main(int part) {
+    SharedCache* cache;
+    if (open_shared_cache(cache_name, CACHE_SIZE, &cache) != SEMVER_OK) {
+        return 1;
+    }
+
+    unsigned int seed = 100 + part;
+    int failed = 0;
+    for (int i = 0; i < LIST_COUNT * 2; i++) {
+        const char* list = lists[next_random(&seed) % LIST_COUNT];
+        const unsigned char* blob;
+        size_t size;
+        failed |= shared_cache_get(cache, list, &blob, &size) != SEMVER_OK || ! same_blob(list, blob, size);
+    }
+    for (int i = 0; i < LIST_COUNT; i++) {
+        const unsigned char* blob;
+        size_t size;
+        failed |= shared_cache_get(cache, lists[i], &blob, &size) != SEMVER_OK || ! same_blob(lists[i], blob, size);
+    }
+
+    close_shared_cache(&cache);
+    return failed;
+}
+
+static char* test_processes() {
+    pid_t pids[PROCESS_COUNT];
+    for (int i = 0; i < PROCESS_COUNT; i++) {
+        pids[i] = fork();
+        if (pids[i] == 0) {
+            _exit(process_main(i));
+        }
+    }
+    int failed = 0;
+    for (int i = 0; i < PROCESS_COUNT; i++) {
+        int status;
+        failed |= pids[i] < 0 || waitpid(pids[i], &status, 0) != pids[i] || ! WIFEXITED(status) ||
+            WEXITSTATUS(status) != 0;
+    }
+    mu_assert("All processes got the same blobs", ! failed);
+
+    SharedCache* cache;
+    mu_assert("Open after processes", open_shared_cache(cache_name, CACHE_SIZE, &cache) == SEMVER_OK);
+    SharedCacheStats stats;
+    shared_cache_stats(cache, &stats);
+    mu_assert("Every list is stored once", stats.entry_count == LIST_COUNT);
+    close_shared_cache(&cache);
+    remove_shared_cache(cache_name);
+    return 0;
+}
+#endif
+
+static char* all_tests() {
+    build_lists();
+    mu_run_test("Shared cache", test_cache);
+    mu_run_test("Full cache", test_full);
+#ifndef _WIN32
+    mu_run_test("Many processes", test_processes);
+#endif
+    return 0;
+}
+
+int main (int argc, char** argv) {
+    char *result = all_tests();
+     if (result != 0) {
+         printf("%s\n", result);
+     }
+     else {
+         printf("ALL TESTS PASSED\n");
+     }
+     printf("Tests run: %d\n", tests_run);
+
+     return result != 0;
+}
@@ -0,0 +1,131 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "semver.h"
+#include "semver_sort.h"
+
+#include "unittest.h"
+#include "testutils.h"
+
+int tests_run = 0;
+
+#define VERSION_COUNT 100000
+
+static SemVersion source[VERSION_COUNT];
+static SemVersion sorted[VERSION_COUNT];
+static SemVersion expected[VERSION_COUNT];
+static SemVersion buffer[VERSION_COUNT];
+static int indices[VERSION_COUNT];
+
+/* Plain top-down stable merge sort */
+static void reference_sort(SemVersion* versions, int count) {
+    if (count < 2) {
+        return;
+    }
+    int mid = count / 2;
+    reference_sort(versions, mid);
+    reference_sort(versions + mid, count - mid);
+
+    int i = 0, j = mid, n = 0;
+    while (i < mid || j < count) {
+        if (j == count || (i < mid && compare_versions(&versions[j], &versions[i]) >= 0)) {
+            buffer[n++] = versions[i++];
+        } else {
+            buffer[n++] = versions[j++];
+        }
+    }
+    memcpy(versions, buffer, count * sizeof(SemVersion));
+}
+
+static int is_sorted(const SemVersion* versions, int count) {
+    for (int i = 1; i < count; i++) {
+        if (compare_versions(&versions[i - 1], &versions[i]) > 0) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static char* test_stable_sort() {
+    static const int counts[] = { VERSION_COUNT, 20000, 1000, 2 };
+    int matched = 1;
+    for (int c = 0; c < sizeof(counts) / sizeof(counts[0]); c++) {
+        unsigned int seed = 3;
+        random_versions(&seed, source, counts[c], 8, 8, 8, RANDOM_BUILDS);
+        memcpy(expected, source, counts[c] * sizeof(SemVersion));
+        reference_sort(expected, counts[c]);
+
+        for (int threads = 1; threads <= 7; threads += 2) {
+            memcpy(sorted, source, counts[c] * sizeof(SemVersion));
+            matched &= sort_versions(sorted, counts[c], VERSION_SORT_STABLE, threads) == SEMVER_OK &&
+                memcmp(sorted, expected, counts[c] * sizeof(SemVersion)) == 0;
+        }
+    }
+    mu_assert("Stable sort is the same as a plain merge sort gives", matched);
+
+    return 0;
+}
+
+static char* test_unstable_sort() {
+    int matched = 1;
+    unsigned int seed = 3;
+    random_versions(&seed, source, VERSION_COUNT, 1000, 1000, 1000, RANDOM_BUILDS);
+    for (int threads = 0; threads <= 8; threads += 4) {
+        memcpy(sorted, source, sizeof(source));
+        matched &= sort_versions(sorted, VERSION_COUNT, 0, threads) == SEMVER_OK && is_sorted(sorted, VERSION_COUNT);
+    }
+    mu_assert("Sorted versions", matched);
+
+    /* already sorted and reversed arrays */
+    matched &= sort_versions(sorted, VERSION_COUNT, 0, 4) == SEMVER_OK && is_sorted(sorted, VERSION_COUNT);
+    for (int i = 0; i < VERSION_COUNT / 2; i++) {
+        SemVersion tmp = sorted[i];
+        sorted[i] = sorted[VERSION_COUNT - 1 - i];
+        sorted[VERSION_COUNT - 1 - i] = tmp;
+    }
+    matched &= sort_versions(sorted, VERSION_COUNT, 0, 4) == SEMVER_OK && is_sorted(sorted, VERSION_COUNT);
+    mu_assert("Sorted and reversed versions", matched);
+
+    return 0;
+}
+
+static char* test_sort_indices() {
+    unsigned int seed = 3;
+    random_versions(&seed, source, VERSION_COUNT, 8, 8, 8, RANDOM_BUILDS);
+    for (int i = 0; i < VERSION_COUNT; i++) {
+        indices[i] = i;
+    }
+    mu_assert("Sort indices", sort_version_indices(source, indices, VERSION_COUNT, VERSION_SORT_STABLE, 4) == SEMVER_OK);
+
+    int matched = 1;
+    for (int i = 1; i < VERSION_COUNT; i++) {
+        int res = compare_versions(&source[indices[i - 1]], &source[indices[i]]);
+        matched &= res < 0 || (res == 0 && indices[i - 1] < indices[i]);
+    }
+    mu_assert("Indices are sorted and equal versions keep their order", matched);
+
+    mu_assert("Invalid indices", sort_version_indices(source, NULL, 5, 0, 1) == SEMVER_INVALID_VERSION);
+    mu_assert("Empty array", sort_versions(NULL, 0, 0, 1) == SEMVER_OK);
+
+    return 0;
+}
+
+static char* all_tests() {
+    mu_run_test("Stable sort", test_stable_sort);
+    mu_run_test("Unstable sort", test_unstable_sort);
+    mu_run_test("Sort indices", test_sort_indices);
+    return 0;
+}
+
+int main (int argc, char** argv) {
+    char *result = all_tests();
+     if (result != 0) {
+         printf("%s\n", result);
+     }
+     else {
+         printf("ALL TESTS PASSED\n");
+     }
+     printf("Tests run: %d\n", tests_run);
+
+     return result != 0;
+}
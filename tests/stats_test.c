@@ -0,0 +1,149 @@
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include "semver.h"
+#include "semver_check.h"
+#include "semver_stats.h"
+
+#include "unittest.h"
+
+int tests_run = 0;
+
+#define THREAD_COUNT 4
+#define THREAD_CALLS 1000
+#define THREAD_ROUNDS 64
+
+static char* test_counters() {
+    SemVersion ver;
+    reset_semver_stats();
+
+    parse_version("1.2.3", &ver);
+    parse_version("1.5.0", &ver);
+    check_version(&ver, "1.2.3,1.5.0");
+    check_version(&ver, "1.0.0 - 2.0.0");
+    check_version(&ver, ">=2.0.0,^3.1.0");
+
+    SemverStats stats;
+    get_semver_stats(&stats);
+    if (! semver_stats_enabled()) {
+        mu_assert("Disabled statistics are empty", stats.entries[STATS_PARSE_VERSION].calls == 0 &&
+                stats.counters[STATS_LISTS] == 0);
+        return 0;
+    }
+
+    /* check_version parses every item of the list */
+    mu_assert("Parse calls", stats.entries[STATS_PARSE_VERSION].calls == 2 + 2 + 2 + 2);
+    mu_assert("Check calls", stats.entries[STATS_CHECK_VERSION].calls == 3);
+    mu_assert("Lists", stats.counters[STATS_LISTS] == 3);
+    mu_assert("Terms", stats.counters[STATS_TERMS] == 2 + 1 + 2);
+    mu_assert("Single match", stats.counters[STATS_SINGLE_MATCHES] == 1);
+    mu_assert("Range checks", stats.counters[STATS_RANGE_CHECKS] == 2);
+    mu_assert("Range match", stats.counters[STATS_RANGE_MATCHES] == 1);
+    /* check_version does not build range lists */
+    mu_assert("Range nodes", stats.counters[STATS_RANGE_NODES] == 0);
+    mu_assert("No allocations", stats.counters[STATS_ALLOCATIONS] == 0);
+
+    unsigned long long in_buckets = 0;
+    for (int b = 0; b < STATS_LATENCY_BUCKETS; b++) {
+        in_buckets += stats.entries[STATS_CHECK_VERSION].latency[b];
+    }
+    mu_assert("Latency histogram", in_buckets == 3);
+
+    reset_semver_stats();
+    get_semver_stats(&stats);
+    mu_assert("Reset", stats.entries[STATS_PARSE_VERSION].calls == 0 && stats.counters[STATS_LISTS] == 0);
+
+    return 0;
+}
+
+static void* run_checks(void* arg) {
+    SemVersion ver;
+    parse_version("1.5.0", &ver);
+    for (int i = 0; i < THREAD_CALLS; i++) {
+        check_version(&ver, ">=1.0.0,<2.0.0");
+    }
+    return NULL;
+}
+
+static char* test_threads() {
+    pthread_t threads[THREAD_COUNT];
+    reset_semver_stats();
+    for (int i = 0; i < THREAD_COUNT; i++) {
+        pthread_create(&threads[i], NULL, run_checks, NULL);
+    }
+    for (int i = 0; i < THREAD_COUNT; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    SemverStats stats;
+    get_semver_stats(&stats);
+    unsigned long long expected = semver_stats_enabled() ? THREAD_COUNT * THREAD_CALLS : 0;
+    mu_assert("Checks of all threads", stats.entries[STATS_CHECK_VERSION].calls == expected);
+    mu_assert("Range matches of all threads", stats.counters[STATS_RANGE_MATCHES] == expected);
+
+    return 0;
+}
+
+/* Threads that start after others exit reuse their blocks */
+static char* test_thread_reuse() {
+    reset_semver_stats();
+    for (int i = 0; i < THREAD_ROUNDS; i++) {
+        pthread_t thread;
+        pthread_create(&thread, NULL, run_checks, NULL);
+        pthread_join(thread, NULL);
+    }
+
+    SemverStats stats;
+    get_semver_stats(&stats);
+    unsigned long long expected = semver_stats_enabled() ? THREAD_ROUNDS * THREAD_CALLS : 0;
+    mu_assert("Checks of exited threads", stats.entries[STATS_CHECK_VERSION].calls == expected);
+    mu_assert("Range matches of exited threads", stats.counters[STATS_RANGE_MATCHES] == expected);
+
+    return 0;
+}
+
+static char* test_format() {
+    SemverStats stats;
+    memset(&stats, 0, sizeof(stats));
+    stats.entries[STATS_CHECK_VERSION].calls = 2;
+    stats.entries[STATS_CHECK_VERSION].latency[10] = 2;
+    stats.counters[STATS_TERMS] = 7;
+
+    char buf[4096];
+    int len = format_semver_stats(&stats, STATS_FORMAT_JSON, buf, sizeof(buf));
+    mu_assert("JSON length", len > 0 && len == strlen(buf));
+    mu_assert("JSON entry", strstr(buf, "\"check_version\":{\"calls\":2,") != NULL);
+    mu_assert("JSON counter", strstr(buf, "\"terms\":7") != NULL);
+
+    len = format_semver_stats(&stats, STATS_FORMAT_TEXT, buf, sizeof(buf));
+    mu_assert("Text latency", len > 0 && strstr(buf, "<1024ns:2") != NULL);
+
+    char small[16];
+    int full = format_semver_stats(&stats, STATS_FORMAT_TEXT, small, sizeof(small));
+    mu_assert("Truncated output", full == len && strlen(small) == sizeof(small) - 1);
+    mu_assert("Length only", format_semver_stats(&stats, STATS_FORMAT_JSON, NULL, 0) > 0);
+    mu_assert("Unknown format", format_semver_stats(&stats, 100, buf, sizeof(buf)) == -1);
+
+    return 0;
+}
+
+static char* all_tests() {
+    mu_run_test("Stats counters", test_counters);
+    mu_run_test("Stats threads", test_threads);
+    mu_run_test("Stats thread reuse", test_thread_reuse);
+    mu_run_test("Stats format", test_format);
+    return 0;
+}
+
+int main (int argc, char** argv) {
+    char *result = all_tests();
+     if (result != 0) {
+         printf("%s\n", result);
+     }
+     else {
+         printf("ALL TESTS PASSED\n");
+     }
+     printf("Tests run: %d\n", tests_run);
+
+     return result != 0;
+}
@@ -0,0 +1,155 @@
+#include <stdio.h>
+#include <string.h>
+#include "semver.h"
+#include "semver_stream.h"
+
+#include "unittest.h"
+
+int tests_run = 0;
+
+static const char* items[] = {
+    "1.2.3", "  1.2.3-beta.31+a345  ", "v1.0.0", ">= 1.2.3-rc.1", "!=1.2.3", "^1.2.3", "~ 1.2.3",
+    "<1.2.3", "==1.2.3", "=1.2.3", "1.2.3-beta.31.78.somelongtext.7818.after.alpha+345",
+    "1.2.3+12345678901234567890", "y.2.3", "1.j.3", "1.2.r", "1.2.3-b=ta", "1.2.3-beta+3$5",
+    "1.2", "1.2.", "1", "v", "!1.2.3", "=", "1.2.3 ", "1.2.3+b c", "1.2.3-", "99999999999999999999.1.1",
+    "4294967295.0.0", "4294967296.0.1", "42949672954294967295.0.0", "1. 2. 3", "-1.2.3",
+};
+
+#define ITEM_COUNT (sizeof(items) / sizeof(items[0]))
+#define MAX_RESULTS 64
+
+typedef struct results_t {
+    VersionStreamItem items[MAX_RESULTS];
+    int count;
+} Results;
+
+static int collect(const VersionStreamItem* item, void* data) {
+    Results* res = data;
+    if (res->count < MAX_RESULTS) {
+        res->items[res->count++] = *item;
+    }
+    return SEMVER_OK;
+}
+
+static int stop_at_first(const VersionStreamItem* item, void* data) {
+    Results* res = data;
+    res->items[res->count++] = *item;
+    return SEMVER_OUT_OF_RANGE;
+}
+
+/* Returns 1 if every item is parsed the same way parse_version parses it */
+static int results_match(const Results* res, const char* text) {
+    if (res->count != ITEM_COUNT) {
+        return 0;
+    }
+
+    for (int i = 0; i < ITEM_COUNT; i++) {
+        const VersionStreamItem* item = &res->items[i];
+        SemVersion ver;
+        int expected = parse_version(items[i], &ver);
+        if (item->result != expected || item->length != strlen(items[i]) ||
+            strncmp(text + item->offset, items[i], item->length) != 0) {
+            return 0;
+        }
+        if (item->result != SEMVER_OK &&
+            (item->error_offset < item->offset || item->error_offset > item->offset + item->length)) {
+            return 0;
+        }
+        if (expected == SEMVER_OK && memcmp(&ver, &item->version, sizeof(SemVersion)) != 0) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+static char* test_chunks() {
+    static const char delimiters[] = { '\n', ',', '\t', '\r' };
+    char text[1024] = "";
+    for (int i = 0; i < ITEM_COUNT; i++) {
+        strcat(text, items[i]);
+        if (i != ITEM_COUNT - 1) {
+            size_t len = strlen(text);
+            text[len] = delimiters[i % sizeof(delimiters)];
+            text[len + 1] = '\0';
+            if (i % 5 == 0) {
+                strcat(text, "\n");
+            }
+        }
+    }
+    size_t len = strlen(text);
+
+    int matched = 1;
+    for (size_t chunk = 1; chunk <= len && matched; chunk++) {
+        VersionStream stream;
+        Results res;
+        res.count = 0;
+        init_version_stream(&stream);
+        for (size_t pos = 0; pos < len; pos += chunk) {
+            size_t size = (pos + chunk > len) ? len - pos : chunk;
+            if (feed_version_stream(&stream, text + pos, size, collect, &res) != SEMVER_OK) {
+                matched = 0;
+            }
+        }
+        if (finish_version_stream(&stream, collect, &res) != SEMVER_OK || ! results_match(&res, text)) {
+            matched = 0;
+        }
+    }
+    mu_assert("Every chunk size gives parse_version results", matched);
+
+    return 0;
+}
+
+static char* test_error_offset() {
+    VersionStream stream;
+    Results res;
+    res.count = 0;
+    init_version_stream(&stream);
+
+    feed_version_stream(&stream, "1.2.3-b=ta\n1.2.x", 16, collect, &res);
+    finish_version_stream(&stream, collect, &res);
+    mu_assert("Two items", res.count == 2);
+    mu_assert("Prerelease error offset", res.items[0].result == SEMVER_INVALID_PRERELEASE && res.items[0].error_offset == 7);
+    mu_assert("Patch error offset", res.items[1].result == SEMVER_INVALID_PATCH && res.items[1].error_offset == 15);
+
+    return 0;
+}
+
+static char* test_stop_and_resume() {
+    const char* text = "1.0.0,2.0.0,3.0.0";
+    VersionStream stream;
+    Results res;
+    res.count = 0;
+    init_version_stream(&stream);
+
+    int ok = feed_version_stream(&stream, text, strlen(text), stop_at_first, &res);
+    mu_assert("Callback stopped parsing", ok == SEMVER_OUT_OF_RANGE && res.count == 1 && stream.offset == 6);
+    ok = feed_version_stream(&stream, text + stream.offset, strlen(text) - 6, collect, &res);
+    finish_version_stream(&stream, collect, &res);
+    mu_assert("Parsing resumed", ok == SEMVER_OK && res.count == 3 && res.items[2].version.major == 3);
+    mu_assert("Offsets continue", res.items[2].offset == 12);
+
+    mu_assert("NULL callback", feed_version_stream(&stream, text, 1, NULL, NULL) == SEMVER_INVALID_VERSION);
+
+    return 0;
+}
+
+static char* all_tests() {
+    mu_run_test("Stream chunks", test_chunks);
+    mu_run_test("Stream error offsets", test_error_offset);
+    mu_run_test("Stream stop and resume", test_stop_and_resume);
+    return 0;
+}
+
+int main (int argc, char** argv) {
+    char *result = all_tests();
+     if (result != 0) {
+         printf("%s\n", result);
+     }
+     else {
+         printf("ALL TESTS PASSED\n");
+     }
+     printf("Tests run: %d\n", tests_run);
+
+     return result != 0;
+}
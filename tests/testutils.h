@@ -0,0 +1,61 @@
+﻿/* Helpers shared by the tests: a pseudo-random generator that gives the
+ * same numbers on every platform, and random versions made with it
+ */
+#ifndef TESTUTILS_20261019
+#define TESTUTILS_20261019
+
+#include <stdio.h>
+#include "semver.h"
+
+/* random_versions flags: versions get random build parts */
+#define RANDOM_BUILDS 1
+
+/* Empty strings are versions without a prerelease or a build part. The
+ * long ones do not fit into SemVersion and are cut
+ */
+static const char* const test_prereleases[] = {
+    "", "", "", "alpha", "alpha.1", "alpha.01", "beta.2", "beta.10", "rc.1", "rc.1a", "dev", "dev.3", "x.y.z",
+    "verylongprerelease.123",
+};
+static const char* const test_builds[] = { "", "", "b1", "b2", "build.5", "build.0123456789" };
+
+static inline unsigned int next_random(unsigned int* seed) {
+    *seed = *seed * 1103515245 + 12345;
+    return *seed >> 16;
+}
+
+static inline const char* random_prerelease(unsigned int* seed) {
+    return test_prereleases[next_random(seed) % (sizeof(test_prereleases) / sizeof(test_prereleases[0]))];
+}
+
+/* Writes a version with numbers below major, minor and patch and a random
+ * prerelease (and build with RANDOM_BUILDS) to str
+ */
+static inline void random_version_string(unsigned int* seed, char* str, size_t size, unsigned int major,
+        unsigned int minor, unsigned int patch, int flags) {
+    const char* pre = random_prerelease(seed);
+    const char* build = (flags & RANDOM_BUILDS) ?
+        test_builds[next_random(seed) % (sizeof(test_builds) / sizeof(test_builds[0]))] : "";
+    unsigned int major_num = next_random(seed) % major;
+    unsigned int minor_num = next_random(seed) % minor;
+    unsigned int patch_num = next_random(seed) % patch;
+    snprintf(str, size, "%u.%u.%u%s%s%s%s", major_num, minor_num, patch_num, *pre ? "-" : "", pre,
+            *build ? "+" : "", build);
+}
+
+/* Fills versions with random_version_string versions */
+static inline void random_versions(unsigned int* seed, SemVersion* versions, int count, unsigned int major,
+        unsigned int minor, unsigned int patch, int flags) {
+    for (int i = 0; i < count; i++) {
+        char str[64];
+        random_version_string(seed, str, sizeof(str), major, minor, patch, flags);
+        parse_version(str, &versions[i]);
+    }
+}
+
+/* compare_versions for qsort */
+static inline int compare_for_qsort(const void* a, const void* b) {
+    return compare_versions(a, b);
+}
+
+#endif
@@ -1,6 +1,6 @@
 ﻿#define mu_assert(name, test) do {\
                 printf("    Checking %s .. ", name); \
-                    if (!(test)) { printf("FAIL\n"); return name;} \
+                    if (!(test)) { printf("FAIL\n"); return (char*)(name);} \
                     else printf("OK\n"); \
                 } while (0)
 #define mu_run_test(name, test) do { printf("Running %s...\n", name); \
@@ -0,0 +1,119 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "semver.h"
+#include "semver_validate.h"
+
+#include "unittest.h"
+#include "testutils.h"
+
+int tests_run = 0;
+
+static const char* items[] = {
+    "1.2.3", "  1.2.3-beta.31+a345  ", "v1.0.0", ">= 1.2.3-rc.1", "!=1.2.3", "^1.2.3", "~ 1.2.3",
+    "<1.2.3", "==1.2.3", "=1.2.3", "1.2.3-beta.31.78.somelongtext.7818.after.alpha+345",
+    "1.2.3+12345678901234567890", "y.2.3", "1.j.3", "1.2.r", "1.2.3-b=ta", "1.2.3-beta+3$5",
+    "1.2", "1.2.", "1", "v", "!1.2.3", "=", "1.2.3 ", "1.2.3+b c", "1.2.3-", "99999999999999999999.1.1",
+    "4294967295.0.0", "4294967296.0.1", "42949672954294967295.0.0", "1.00004294967295.0", "1.2.18446744069414584319",
+    "1. 2. 3", "-1.2.3", "", " ", "=<1.2.3", ">>1.2.3", "1.2.3-+", "1.2.3++", "1.2.3-a b",
+};
+
+#define ITEM_COUNT (sizeof(items) / sizeof(items[0]))
+
+static char* test_same_as_parse() {
+    for (int i = 0; i < ITEM_COUNT; i++) {
+        int res = validate_version(items[i], NULL);
+        mu_assert("Validation result differs from parse_version", res == parse_version(items[i], NULL));
+        mu_assert("Length validation result differs", res == validate_version_len(items[i], strlen(items[i]), NULL));
+    }
+
+    /* random strings made of the grammar chars */
+    static const char alphabet[] = " vV0123456789.-+!=<>^~abr$";
+    char str[32];
+    unsigned int seed = 1;
+    int matched = 1;
+    for (int i = 0; i < 200000 && matched; i++) {
+        int len = next_random(&seed) % 20;
+        for (int j = 0; j < len; j++) {
+            unsigned int r = next_random(&seed);
+            /* digits are more likely to build versions that are valid up to some point */
+            str[j] = (r >> 4) % 3 == 0 ? '.' : alphabet[r % (sizeof(alphabet) - 1)];
+        }
+        str[len] = '\0';
+        matched = validate_version(str, NULL) == parse_version(str, NULL);
+    }
+    mu_assert("Random strings validated as parse_version does", matched);
+
+    mu_assert("NULL version", validate_version(NULL, NULL) == SEMVER_INVALID_VERSION);
+
+    return 0;
+}
+
+static char* test_error_offset() {
+    size_t offset = 100;
+    mu_assert("Valid version", validate_version("1.2.3-rc.1+b", &offset) == SEMVER_OK && offset == 100);
+    mu_assert("Invalid prerelease", validate_version("1.2.3-b=ta", &offset) == SEMVER_INVALID_PRERELEASE && offset == 7);
+    mu_assert("Invalid minor", validate_version(">=1.x.3", &offset) == SEMVER_INVALID_MINOR && offset == 4);
+    mu_assert("Unexpected end", validate_version("1.2", &offset) == SEMVER_INVALID_MINOR && offset == 3);
+    mu_assert("Invalid number", validate_version("4294967295.0.0", &offset) == SEMVER_INVALID_MAJOR && offset == 10);
+    mu_assert("Invalid build", validate_version("1.2.3+b c", &offset) == SEMVER_INVALID_BUILD && offset == 8);
+
+    mu_assert("Length limits string", validate_version_len("1.2.3-rc", 5, NULL) == SEMVER_OK);
+    mu_assert("NUL inside is invalid", validate_version_len("1.2.3\0", 6, &offset) == SEMVER_INVALID_PATCH && offset == 5);
+
+    return 0;
+}
+
+static char* test_buffer() {
+    const char* buf = "1.2.3\n1.x.3\n\n^2.0.0-rc.1\n1.2.3+b c\n";
+    VersionValidation res[4];
+
+    size_t count = validate_version_buffer(buf, strlen(buf), '\n', res, 4);
+    mu_assert("Five items", count == 5);
+    mu_assert("First item", res[0].result == SEMVER_OK && res[0].offset == 0 && res[0].length == 5);
+    mu_assert("Second item", res[1].result == SEMVER_INVALID_MINOR && res[1].offset == 6 &&
+            res[1].length == 5 && res[1].error_offset == 8);
+    mu_assert("Empty item", res[2].result == SEMVER_INVALID_MAJOR && res[2].offset == 12 && res[2].length == 0);
+    mu_assert("Fourth item", res[3].result == SEMVER_OK && res[3].offset == 13 && res[3].length == 11);
+
+    mu_assert("Counting only", validate_version_buffer(buf, strlen(buf), '\n', NULL, 0) == 5);
+    mu_assert("Without trailing delimiter", validate_version_buffer("1.0.0,2.0.0", 11, ',', res, 4) == 2 &&
+            res[1].result == SEMVER_OK && res[1].length == 5);
+    mu_assert("Empty buffer", validate_version_buffer("", 0, ',', res, 4) == 0);
+
+    /* every item gets the same result as parse_version */
+    char text[1024] = "";
+    for (int i = 0; i < ITEM_COUNT; i++) {
+        strcat(text, items[i]);
+        strcat(text, ",");
+    }
+    VersionValidation all[ITEM_COUNT];
+    mu_assert("All items", validate_version_buffer(text, strlen(text), ',', all, ITEM_COUNT) == ITEM_COUNT);
+    int matched = 1;
+    for (int i = 0; i < ITEM_COUNT; i++) {
+        matched &= all[i].result == parse_version(items[i], NULL) && all[i].length == strlen(items[i]);
+    }
+    mu_assert("Buffer items validated as parse_version does", matched);
+
+    return 0;
+}
+
+static char* all_tests() {
+    mu_run_test("Validate as parse", test_same_as_parse);
+    mu_run_test("Validate error offsets", test_error_offset);
+    mu_run_test("Validate buffer", test_buffer);
+    return 0;
+}
+
+int main (int argc, char** argv) {
+    char *result = all_tests();
+     if (result != 0) {
+         printf("%s\n", result);
+     }
+     else {
+         printf("ALL TESTS PASSED\n");
+     }
+     printf("Tests run: %d\n", tests_run);
+
+     return result != 0;
+}
@@ -0,0 +1,90 @@
+/* Builds a version catalog file from a text list of package versions.
+ *
+ * Usage: catalog_build <catalog-file> [input-file]
+ *
+ * Every line of the input (stdin if input file is not set) contains
+ * a package name and its version separated with spaces:
+ *      libfoo 1.2.3-beta.1+build7
+ * Empty lines and lines starting with '#' are skipped.
+ */
+#include <stdio.h>
+#include <string.h>
+
+#include "semver.h"
+#include "ver_catalog.h"
+
+#define MAX_LINE 1024
+
+int main(int argc, char** argv) {
+    if (argc < 2 || argc > 3) {
+        fprintf(stderr, "Usage: %s <catalog-file> [input-file]\n", argv[0]);
+        return 1;
+    }
+
+    FILE* in = stdin;
+    if (argc == 3) {
+        in = fopen(argv[2], "r");
+        if (in == NULL) {
+            fprintf(stderr, "Failed to open %s\n", argv[2]);
+            return 1;
+        }
+    }
+
+    CatalogBuilder* builder = init_catalog_builder();
+    if (builder == NULL) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+
+    char line[MAX_LINE];
+    int line_no = 0;
+    int added = 0;
+    int skipped = 0;
+    while (fgets(line, sizeof(line), in) != NULL) {
+        line_no++;
+        line[strcspn(line, "\r\n")] = '\0';
+
+        char* package = line;
+        while (*package == ' ' || *package == '\t') {
+            package++;
+        }
+        if (*package == '\0' || *package == '#') {
+            continue;
+        }
+
+        char* version = package + strcspn(package, " \t");
+        if (*version != '\0') {
+            *version++ = '\0';
+        }
+
+        SemVersion ver;
+        int res = parse_version(version, &ver);
+        if (res != SEMVER_OK) {
+            fprintf(stderr, "Line %d: invalid version '%s' (error %d)\n", line_no, version, res);
+            skipped++;
+            continue;
+        }
+
+        res = catalog_builder_add(builder, package, &ver);
+        if (res != SEMVER_OK) {
+            fprintf(stderr, "Line %d: failed to add version (error %d)\n", line_no, res);
+            free_catalog_builder(&builder);
+            return 1;
+        }
+        added++;
+    }
+
+    if (in != stdin) {
+        fclose(in);
+    }
+
+    int res = catalog_builder_write(builder, argv[1]);
+    free_catalog_builder(&builder);
+    if (res != SEMVER_OK) {
+        fprintf(stderr, "Failed to write %s (error %d)\n", argv[1], res);
+        return 1;
+    }
+
+    printf("Versions added: %d, skipped: %d\n", added, skipped);
+    return 0;
+}
@@ -0,0 +1,173 @@
+/* Read scaling benchmark of LiveIndex.
+ *
+ * Usage: live_bench [-n versions] [-t max_threads] [-d seconds]
+ *
+ * Fills an index with versions and then runs 1, 2, 4, ... up to
+ * max_threads reader threads (the number of processors by default) for
+ * the given time while one writer keeps inserting new versions. Readers
+ * ask for the max satisfying version of random lists. Every thread count
+ * is run twice: with lock-free readers and with a mutex around every
+ * query and insert, as a sorted array under a lock would need.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+#include "semver.h"
+#include "semver_live.h"
+
+static const char* lists[] = {
+    "*", ">=1.2.0 <2.0.0 || ^3.1.0", "~2.3.0", "<4.0.0", "^1.4.0", "1.0.0 - 1.9.9,3.0.0", ">=0.9.0 !=9.9.9",
+};
+
+#define LIST_COUNT (sizeof(lists) / sizeof(lists[0]))
+
+typedef struct bench_t {
+    LiveIndex* index;
+    pthread_mutex_t lock;
+    int locked;
+    atomic_int stop;
+    atomic_ullong queries;
+    atomic_ullong inserts;
+} Bench;
+
+static double now_sec() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void random_version(unsigned int* seed, SemVersion* ver) {
+    char str[64];
+    *seed = *seed * 1103515245 + 12345;
+    unsigned int r = *seed >> 4;
+    snprintf(str, sizeof(str), "%u.%u.%u", r % 10, (r >> 4) % 50, (r >> 10) % 1000);
+    parse_version(str, ver);
+}
+
+static void* read_loop(void* arg) {
+    Bench* bench = arg;
+    LiveReader* reader = open_live_reader(bench->index);
+    unsigned int seed = (unsigned int)(size_t)&seed;
+    unsigned long long queries = 0;
+
+    while (! atomic_load_explicit(&bench->stop, memory_order_relaxed)) {
+        seed = seed * 1103515245 + 12345;
+        const char* list = lists[(seed >> 16) % LIST_COUNT];
+        SemVersion ver;
+        if (bench->locked) {
+            pthread_mutex_lock(&bench->lock);
+        }
+        const LiveSnapshot* snapshot = live_reader_enter(reader);
+        live_snapshot_max_satisfying(snapshot, list, &ver);
+        live_reader_exit(reader);
+        if (bench->locked) {
+            pthread_mutex_unlock(&bench->lock);
+        }
+        queries++;
+    }
+
+    close_live_reader(&reader);
+    atomic_fetch_add(&bench->queries, queries);
+    return NULL;
+}
+
+static void* write_loop(void* arg) {
+    Bench* bench = arg;
+    unsigned int seed = 99;
+    unsigned long long inserts = 0;
+
+    while (! atomic_load_explicit(&bench->stop, memory_order_relaxed)) {
+        SemVersion ver;
+        random_version(&seed, &ver);
+        if (bench->locked) {
+            pthread_mutex_lock(&bench->lock);
+        }
+        live_index_insert(bench->index, &ver, NULL);
+        if (bench->locked) {
+            pthread_mutex_unlock(&bench->lock);
+        }
+        inserts++;
+    }
+
+    atomic_fetch_add(&bench->inserts, inserts);
+    return NULL;
+}
+
+static void usage() {
+    printf("Usage: live_bench [-n versions] [-t max_threads] [-d seconds]\n");
+}
+
+int main(int argc, char** argv) {
+    int count = 100000;
+    int max_threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    double seconds = 1;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "n:t:d:h")) != -1) {
+        switch (opt) {
+            case 'n': count = atoi(optarg); break;
+            case 't': max_threads = atoi(optarg); break;
+            case 'd': seconds = atof(optarg); break;
+            default: usage(); return 1;
+        }
+    }
+    if (count < 1 || max_threads < 1 || seconds <= 0) {
+        usage();
+        return 1;
+    }
+
+    Bench bench;
+    bench.index = create_live_index();
+    pthread_mutex_init(&bench.lock, NULL);
+    unsigned int seed = 1;
+    for (int i = 0; i < count; i++) {
+        SemVersion ver;
+        random_version(&seed, &ver);
+        live_index_insert(bench.index, &ver, NULL);
+    }
+    printf("%d versions, one writer\n", live_index_count(bench.index));
+
+    for (int threads = 1; ; threads = threads * 2 < max_threads ? threads * 2 : max_threads) {
+        double rates[2];
+        for (int locked = 0; locked < 2; locked++) {
+            bench.locked = locked;
+            atomic_init(&bench.stop, 0);
+            atomic_init(&bench.queries, 0);
+            atomic_init(&bench.inserts, 0);
+
+            pthread_t writer;
+            pthread_t* readers = malloc(threads * sizeof(pthread_t));
+            double started = now_sec();
+            pthread_create(&writer, NULL, write_loop, &bench);
+            for (int i = 0; i < threads; i++) {
+                pthread_create(&readers[i], NULL, read_loop, &bench);
+            }
+            usleep((useconds_t)(seconds * 1e6));
+            atomic_store(&bench.stop, 1);
+            for (int i = 0; i < threads; i++) {
+                pthread_join(readers[i], NULL);
+            }
+            pthread_join(writer, NULL);
+            double elapsed = now_sec() - started;
+            free(readers);
+
+            rates[locked] = atomic_load(&bench.queries) / elapsed;
+            printf("%2d readers  %-9s %10.0f queries/s  %8.0f inserts/s\n", threads, locked ? "mutex" : "lock-free",
+                    rates[locked], atomic_load(&bench.inserts) / elapsed);
+        }
+        printf("%2d readers  lock-free/mutex %.2fx\n", threads, rates[0] / rates[1]);
+
+        if (threads == max_threads) {
+            break;
+        }
+    }
+
+    free_live_index(&bench.index);
+    pthread_mutex_destroy(&bench.lock);
+    return 0;
+}
@@ -0,0 +1,152 @@
+/* Benchmark of VersionSearch lower_bound against binary search.
+ *
+ * Usage: search_bench [-n max_versions] [-q queries]
+ *
+ * Builds sorted arrays of 1M, 10M, ... up to max_versions versions (10M
+ * by default, 100M needs about 7 GB of memory) and prints the average
+ * time of a lower bound query for binary search with compare_versions and
+ * for the Eytzinger index. Half of the queries are not in the array.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "semver.h"
+#include "semver_search.h"
+
+static double now_sec() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static unsigned int next_random(unsigned int* seed) {
+    *seed = *seed * 1103515245 + 12345;
+    return *seed >> 8;
+}
+
+static void usage() {
+    printf("Usage: search_bench [-n max_versions] [-q queries]\n");
+}
+
+/* Fills versions in increasing order: every release may be preceded with
+ * its release candidate */
+static void build_versions(SemVersion* versions, int count) {
+    SemVersion release, candidate;
+    parse_version("0.0.0", &release);
+    parse_version("0.0.0-rc.1", &candidate);
+
+    unsigned int seed = 1;
+    for (int i = 0; i < count; i++) {
+        unsigned int r = next_random(&seed);
+        if (r % 50 == 0) {
+            release.major++;
+            release.minor = 0;
+            release.patch = 0;
+        } else if (r % 10 == 0) {
+            release.minor++;
+            release.patch = 0;
+        } else {
+            release.patch += 1 + (r >> 8) % 3;
+        }
+
+        if ((r >> 12) % 4 == 0 && i + 1 < count) {
+            versions[i] = candidate;
+            versions[i].major = release.major;
+            versions[i].minor = release.minor;
+            versions[i].patch = release.patch;
+            i++;
+        }
+        versions[i] = release;
+    }
+}
+
+static int binary_lower_bound(const SemVersion* versions, int count, const SemVersion* ver) {
+    int lo = 0, hi = count;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (compare_versions(&versions[mid], ver) < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+int main(int argc, char** argv) {
+    int max_count = 10000000;
+    int query_count = 2000000;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "n:q:h")) != -1) {
+        switch (opt) {
+            case 'n': max_count = atoi(optarg); break;
+            case 'q': query_count = atoi(optarg); break;
+            default: usage(); return 1;
+        }
+    }
+    if (max_count < 1 || query_count < 1) {
+        usage();
+        return 1;
+    }
+
+    SemVersion* queries = malloc(query_count * sizeof(SemVersion));
+    if (queries == NULL) {
+        printf("Not enough memory\n");
+        return 1;
+    }
+
+    for (int count = max_count < 1000000 ? max_count : 1000000; ; count = count * 10 < max_count ? count * 10 : max_count) {
+        SemVersion* versions = malloc(count * sizeof(SemVersion));
+        if (versions == NULL) {
+            printf("Not enough memory\n");
+            return 1;
+        }
+        build_versions(versions, count);
+
+        unsigned int seed = 7;
+        for (int i = 0; i < query_count; i++) {
+            unsigned int r = next_random(&seed);
+            queries[i] = versions[r % count];
+            queries[i].patch += r & 1;
+        }
+
+        double started = now_sec();
+        int error;
+        VersionSearch* search = build_version_search(versions, count, &error);
+        if (search == NULL) {
+            printf("Failed to build the index: %d\n", error);
+            return 1;
+        }
+        double built = now_sec() - started;
+
+        long long sum_binary = 0, sum_index = 0;
+        started = now_sec();
+        for (int i = 0; i < query_count; i++) {
+            sum_binary += binary_lower_bound(versions, count, &queries[i]);
+        }
+        double binary = now_sec() - started;
+
+        started = now_sec();
+        for (int i = 0; i < query_count; i++) {
+            sum_index += version_search_lower_bound(search, &queries[i]);
+        }
+        double index = now_sec() - started;
+
+        printf("%10d versions  build %6.3f s  binary %7.1f ns  eytzinger %7.1f ns  speedup %.2fx%s\n", count, built,
+                binary * 1e9 / query_count, index * 1e9 / query_count, binary / index,
+                sum_binary == sum_index ? "" : "  RESULTS DIFFER");
+
+        free_version_search(&search);
+        free(versions);
+        if (count == max_count) {
+            break;
+        }
+    }
+
+    free(queries);
+    return 0;
+}
@@ -0,0 +1,608 @@
+/* Local version check daemon.
+ *
+ * Usage: semver_daemon [socket-path]
+ *
+ * Serves check_version and max-satisfying queries over a Unix domain
+ * socket (see semver_proto.h). Requests from all clients that arrive
+ * during one event loop iteration are collected into a batch. The batch
+ * is grouped by version list, every list is compiled once (compiled
+ * lists are kept in a cache shared by all clients) and all queries of
+ * a group are checked in a row against the same compiled list.
+ *
+ * Linux only: the daemon uses epoll.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "semver.h"
+#include "semver_blob.h"
+#include "semver_proto.h"
+
+#define MAX_EVENTS 64
+#define READ_CHUNK 65536
+/* a client is not read while it has more unparsed input, and a frame
+ * longer than PROTO_MAX_FRAME closes the connection */
+#define CLIENT_MAX_INPUT (4 * PROTO_MAX_FRAME)
+#define CACHE_SIZE 4096
+#define CACHE_PROBES 8
+#define LATENCY_BUCKETS 24
+
+typedef struct client_t {
+    int fd;
+    /* the connection is closed without sending pending responses */
+    int closing;
+    /* the client does not send more requests, the connection is closed
+     * after all responses are sent */
+    int eof;
+    unsigned char* in;
+    size_t in_len;
+    size_t in_cap;
+    /* bytes of in already parsed into requests */
+    size_t in_used;
+    unsigned char* out;
+    size_t out_len;
+    size_t out_cap;
+    size_t out_sent;
+    /* epoll events the client is registered for */
+    unsigned int events;
+    struct client_t* next;
+} Client;
+
+typedef struct request_t {
+    Client* client;
+    unsigned int id;
+    int op;
+    const unsigned char* list;
+    unsigned int list_len;
+    unsigned int list_hash;
+    /* version (PROTO_CHECK) or version array (PROTO_MAX_SATISFYING) */
+    const unsigned char* body;
+    unsigned int body_len;
+    unsigned long long received;
+} Request;
+
+typedef struct cache_entry_t {
+    char* list;
+    unsigned int list_len;
+    unsigned int hash;
+    unsigned char* blob;
+    size_t blob_size;
+    /* compile result: SEMVER_OK or error code */
+    int status;
+} CacheEntry;
+
+typedef struct stats_t {
+    unsigned long long started;
+    unsigned long long requests;
+    unsigned long long checks;
+    unsigned long long max_queries;
+    unsigned long long versions_checked;
+    unsigned long long batches;
+    unsigned long long batch_max;
+    unsigned long long groups;
+    unsigned long long cache_hits;
+    unsigned long long cache_misses;
+    unsigned long long cache_evictions;
+    unsigned long long bad_frames;
+    unsigned long long clients;
+    unsigned long long latency[LATENCY_BUCKETS];
+} Stats;
+
+static volatile sig_atomic_t stop = 0;
+static CacheEntry cache[CACHE_SIZE];
+static Stats stats;
+static Client* clients = NULL;
+static Request* batch = NULL;
+static size_t batch_len = 0;
+static size_t batch_cap = 0;
+
+static void on_signal(int sig) {
+    stop = 1;
+}
+
+static unsigned long long now_us() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000ull + ts.tv_nsec / 1000;
+}
+
+static unsigned int hash_bytes(const unsigned char* data, unsigned int len) {
+    unsigned int hash = 2166136261u;
+    for (unsigned int i = 0; i < len; i++) {
+        hash ^= data[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static int reserve(unsigned char** buf, size_t* cap, size_t need) {
+    if (need <= *cap) {
+        return 1;
+    }
+    size_t new_cap = *cap == 0 ? 4096 : *cap;
+    while (new_cap < need) {
+        new_cap *= 2;
+    }
+    unsigned char* tmp = realloc(*buf, new_cap);
+    if (tmp == NULL) {
+        return 0;
+    }
+    *buf = tmp;
+    *cap = new_cap;
+    return 1;
+}
+
+/* Returns compiled version list from the cache. Compiles and caches the
+ * list if it is not found. When all probed slots are busy the first of
+ * them is evicted
+ */
+static CacheEntry* cache_get(const unsigned char* list, unsigned int len, unsigned int hash) {
+    unsigned int slot = hash & (CACHE_SIZE - 1);
+    CacheEntry* victim = &cache[slot];
+
+    for (int probe = 0; probe < CACHE_PROBES; probe++) {
+        CacheEntry* e = &cache[(slot + probe) & (CACHE_SIZE - 1)];
+        if (e->list == NULL) {
+            victim = e;
+            break;
+        }
+        if (e->hash == hash && e->list_len == len && memcmp(e->list, list, len) == 0) {
+            stats.cache_hits++;
+            return e;
+        }
+    }
+
+    stats.cache_misses++;
+    if (victim->list != NULL) {
+        stats.cache_evictions++;
+        free(victim->list);
+        free(victim->blob);
+    }
+    memset(victim, 0, sizeof(CacheEntry));
+
+    victim->list = malloc(len + 1);
+    if (victim->list == NULL) {
+        return NULL;
+    }
+    memcpy(victim->list, list, len);
+    victim->list[len] = '\0';
+    victim->list_len = len;
+    victim->hash = hash;
+
+    size_t size = 0;
+    victim->status = compile_version_list(victim->list, NULL, 0, &size);
+    if (victim->status == SEMVER_BUFFER_TOO_SMALL) {
+        victim->blob = malloc(size);
+        victim->status = victim->blob == NULL ? SEMVER_OUT_OF_MEMORY :
+            compile_version_list(victim->list, victim->blob, size, &victim->blob_size);
+    }
+
+    return victim;
+}
+
+static int parse_bytes(const unsigned char* str, unsigned int len, SemVersion* ver) {
+    char buf[256];
+    if (len >= sizeof(buf)) {
+        return SEMVER_INVALID_VERSION;
+    }
+    memcpy(buf, str, len);
+    buf[len] = '\0';
+    return parse_version(buf, ver);
+}
+
+static void add_response(Client* client, unsigned int id, int status, unsigned int value,
+        const char* text, size_t text_len) {
+    size_t frame = PROTO_RESPONSE_HEADER + text_len;
+    if (! reserve(&client->out, &client->out_cap, client->out_len + frame)) {
+        client->closing = 1;
+        return;
+    }
+
+    unsigned char* p = client->out + client->out_len;
+    proto_put_u32(p, (unsigned int)(frame - 4));
+    proto_put_u32(p + 4, id);
+    proto_put_u32(p + 8, (unsigned int)status);
+    proto_put_u32(p + 12, value);
+    if (text_len > 0) {
+        memcpy(p + PROTO_RESPONSE_HEADER, text, text_len);
+    }
+    client->out_len += frame;
+}
+
+static size_t format_stats(char* buf, size_t size) {
+    double uptime = (now_us() - stats.started) / 1e6;
+    size_t len = snprintf(buf, size,
+        "uptime_s %.3f\nclients %llu\nrequests %llu\nchecks %llu\nmax_queries %llu\n"
+        "versions_checked %llu\nthroughput_rps %.1f\nbatches %llu\navg_batch %.2f\nmax_batch %llu\n"
+        "groups %llu\ncache_hits %llu\ncache_misses %llu\ncache_evictions %llu\nbad_frames %llu\n",
+        uptime, stats.clients, stats.requests, stats.checks, stats.max_queries, stats.versions_checked,
+        uptime > 0 ? stats.requests / uptime : 0.0, stats.batches,
+        stats.batches > 0 ? (double)stats.requests / stats.batches : 0.0, stats.batch_max,
+        stats.groups, stats.cache_hits, stats.cache_misses, stats.cache_evictions, stats.bad_frames);
+
+    for (int i = 0; i < LATENCY_BUCKETS && len < size; i++) {
+        if (stats.latency[i] != 0) {
+            len += snprintf(buf + len, size - len, "latency_us_lt_%llu %llu\n", 1ull << i, stats.latency[i]);
+        }
+    }
+
+    return len < size ? len : size - 1;
+}
+
+static void record_latency(unsigned long long received) {
+    unsigned long long us = now_us() - received;
+    int bucket = 0;
+    while (bucket < LATENCY_BUCKETS - 1 && us >= (1ull << bucket)) {
+        bucket++;
+    }
+    stats.latency[bucket]++;
+}
+
+/* Splits the unparsed part of client input into requests and adds them to the batch */
+static void collect_requests(Client* client, unsigned long long received) {
+    while (client->in_len - client->in_used >= 4) {
+        const unsigned char* p = client->in + client->in_used;
+        unsigned int length = proto_get_u32(p);
+        if (length < PROTO_REQUEST_HEADER - 4 || length > PROTO_MAX_FRAME) {
+            stats.bad_frames++;
+            client->closing = 1;
+            return;
+        }
+        if (client->in_len - client->in_used < length + 4) {
+            return;
+        }
+        client->in_used += length + 4;
+
+        Request req;
+        memset(&req, 0, sizeof(req));
+        req.client = client;
+        req.id = proto_get_u32(p + 4);
+        req.op = p[8];
+        req.list_len = proto_get_u16(p + 10);
+        req.list = p + PROTO_REQUEST_HEADER;
+        req.received = received;
+        if (PROTO_REQUEST_HEADER - 4 + req.list_len > length) {
+            stats.bad_frames++;
+            add_response(client, req.id, SEMVER_INVALID_VERSION_LIST, PROTO_NO_INDEX, NULL, 0);
+            continue;
+        }
+        req.body = req.list + req.list_len;
+        req.body_len = length - (PROTO_REQUEST_HEADER - 4) - req.list_len;
+        req.list_hash = hash_bytes(req.list, req.list_len);
+
+        if (batch_len == batch_cap) {
+            size_t cap = batch_cap == 0 ? 256 : batch_cap * 2;
+            Request* tmp = realloc(batch, cap * sizeof(Request));
+            if (tmp == NULL) {
+                client->closing = 1;
+                return;
+            }
+            batch = tmp;
+            batch_cap = cap;
+        }
+        batch[batch_len++] = req;
+    }
+}
+
+static void run_check(Request* req, const CacheEntry* entry) {
+    SemVersion ver;
+    int status = entry == NULL ? SEMVER_OUT_OF_MEMORY : entry->status;
+    if (status == SEMVER_OK) {
+        if (req->body_len < 2 || 2 + proto_get_u16(req->body) > req->body_len) {
+            status = SEMVER_INVALID_VERSION;
+        } else {
+            status = parse_bytes(req->body + 2, proto_get_u16(req->body), &ver);
+            if (status == SEMVER_OK) {
+                status = check_version_blob(&ver, entry->blob, entry->blob_size);
+            }
+        }
+    }
+
+    stats.checks++;
+    stats.versions_checked++;
+    add_response(req->client, req->id, status, PROTO_NO_INDEX, NULL, 0);
+}
+
+static void run_max_satisfying(Request* req, const CacheEntry* entry) {
+    int status = entry == NULL ? SEMVER_OUT_OF_MEMORY : entry->status;
+    unsigned int best_idx = PROTO_NO_INDEX;
+
+    if (status == SEMVER_OK) {
+        SemVersion best;
+        status = SEMVER_OUT_OF_RANGE;
+        if (req->body_len < 2) {
+            status = SEMVER_INVALID_VERSION;
+        } else {
+            unsigned int count = proto_get_u16(req->body);
+            unsigned int offset = 2;
+            for (unsigned int i = 0; i < count; i++) {
+                if (offset + 2 > req->body_len || offset + 2 + proto_get_u16(req->body + offset) > req->body_len) {
+                    status = SEMVER_INVALID_VERSION;
+                    break;
+                }
+                unsigned int len = proto_get_u16(req->body + offset);
+                SemVersion ver;
+                int ok = parse_bytes(req->body + offset + 2, len, &ver);
+                offset += 2 + len;
+                stats.versions_checked++;
+                if (ok != SEMVER_OK || check_version_blob(&ver, entry->blob, entry->blob_size) != SEMVER_OK) {
+                    continue;
+                }
+                if (best_idx == PROTO_NO_INDEX || compare_versions(&ver, &best) > 0) {
+                    best = ver;
+                    best_idx = i;
+                    status = SEMVER_OK;
+                }
+            }
+        }
+    }
+
+    stats.max_queries++;
+    add_response(req->client, req->id, status, best_idx, NULL, 0);
+}
+
+static int compare_requests(const void* a, const void* b) {
+    const Request* ra = a;
+    const Request* rb = b;
+    if (ra->list_hash != rb->list_hash) {
+        return ra->list_hash < rb->list_hash ? -1 : 1;
+    }
+    if (ra->list_len != rb->list_len) {
+        return ra->list_len < rb->list_len ? -1 : 1;
+    }
+    return memcmp(ra->list, rb->list, ra->list_len);
+}
+
+/* Evaluates all collected requests grouped by version list */
+static void run_batch() {
+    if (batch_len == 0) {
+        return;
+    }
+
+    stats.batches++;
+    stats.requests += batch_len;
+    if (batch_len > stats.batch_max) {
+        stats.batch_max = batch_len;
+    }
+
+    qsort(batch, batch_len, sizeof(Request), compare_requests);
+
+    const CacheEntry* entry = NULL;
+    for (size_t i = 0; i < batch_len; i++) {
+        Request* req = &batch[i];
+        if (req->op == PROTO_STATS) {
+            char text[2048];
+            size_t len = format_stats(text, sizeof(text));
+            add_response(req->client, req->id, SEMVER_OK, PROTO_NO_INDEX, text, len);
+            record_latency(req->received);
+            continue;
+        }
+
+        if (i == 0 || compare_requests(req, &batch[i - 1]) != 0 || entry == NULL) {
+            entry = cache_get(req->list, req->list_len, req->list_hash);
+            stats.groups++;
+        }
+
+        if (req->op == PROTO_CHECK) {
+            run_check(req, entry);
+        } else if (req->op == PROTO_MAX_SATISFYING) {
+            run_max_satisfying(req, entry);
+        } else {
+            stats.bad_frames++;
+            add_response(req->client, req->id, SEMVER_INVALID_VERSION, PROTO_NO_INDEX, NULL, 0);
+        }
+        record_latency(req->received);
+    }
+
+    batch_len = 0;
+}
+
+static void update_events(int epfd, Client* client, int want_write) {
+    unsigned int events = (client->eof ? 0 : EPOLLIN) | (want_write ? EPOLLOUT : 0);
+    if (client->events == events) {
+        return;
+    }
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = events;
+    ev.data.ptr = client;
+    epoll_ctl(epfd, EPOLL_CTL_MOD, client->fd, &ev);
+    client->events = events;
+}
+
+static void flush_client(int epfd, Client* client) {
+    while (client->out_sent < client->out_len) {
+        ssize_t n = write(client->fd, client->out + client->out_sent, client->out_len - client->out_sent);
+        if (n < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                update_events(epfd, client, 1);
+                return;
+            }
+            if (errno == EINTR) {
+                continue;
+            }
+            client->closing = 1;
+            return;
+        }
+        client->out_sent += n;
+    }
+
+    client->out_len = 0;
+    client->out_sent = 0;
+    update_events(epfd, client, 0);
+}
+
+static void read_client(int epfd, Client* client, unsigned long long received) {
+    if (client->eof) {
+        return;
+    }
+
+    /* the rest of the input stays in the socket until this batch is done */
+    while (client->in_len - client->in_used < CLIENT_MAX_INPUT) {
+        if (! reserve(&client->in, &client->in_cap, client->in_len + READ_CHUNK)) {
+            client->closing = 1;
+            return;
+        }
+        ssize_t n = read(client->fd, client->in + client->in_len, client->in_cap - client->in_len);
+        if (n > 0) {
+            client->in_len += n;
+            continue;
+        }
+        if (n == 0) {
+            client->eof = 1;
+            update_events(epfd, client, client->out_len > 0);
+        } else if (errno == EINTR) {
+            continue;
+        } else if (errno != EAGAIN && errno != EWOULDBLOCK) {
+            client->closing = 1;
+        }
+        break;
+    }
+
+    collect_requests(client, received);
+}
+
+static void accept_clients(int epfd, int listen_fd) {
+    for (;;) {
+        int fd = accept(listen_fd, NULL, NULL);
+        if (fd < 0) {
+            return;
+        }
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+
+        Client* client = calloc(1, sizeof(Client));
+        if (client == NULL) {
+            close(fd);
+            continue;
+        }
+        client->fd = fd;
+        client->events = EPOLLIN;
+
+        struct epoll_event ev;
+        memset(&ev, 0, sizeof(ev));
+        ev.events = EPOLLIN;
+        ev.data.ptr = client;
+        if (epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+            close(fd);
+            free(client);
+            continue;
+        }
+
+        client->next = clients;
+        clients = client;
+        stats.clients++;
+    }
+}
+
+/* Flushes responses, drops consumed input and closes finished clients:
+ * a client that closed its side of the connection gets all responses
+ * first */
+static void finish_iteration(int epfd) {
+    Client** link = &clients;
+    while (*link != NULL) {
+        Client* client = *link;
+        if (client->out_len > 0 && ! client->closing) {
+            flush_client(epfd, client);
+        }
+
+        if (client->in_used > 0) {
+            memmove(client->in, client->in + client->in_used, client->in_len - client->in_used);
+            client->in_len -= client->in_used;
+            client->in_used = 0;
+        }
+
+        if (client->closing || (client->eof && client->out_len == 0)) {
+            epoll_ctl(epfd, EPOLL_CTL_DEL, client->fd, NULL);
+            close(client->fd);
+            *link = client->next;
+            free(client->in);
+            free(client->out);
+            free(client);
+            continue;
+        }
+        link = &client->next;
+    }
+}
+
+int main(int argc, char** argv) {
+    const char* path = argc > 1 ? argv[1] : PROTO_DEFAULT_SOCKET;
+
+    int listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listen_fd < 0) {
+        perror("socket");
+        return 1;
+    }
+
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+    unlink(path);
+    if (bind(listen_fd, (struct sockaddr*)&addr, sizeof(addr)) != 0 || listen(listen_fd, 128) != 0) {
+        perror("bind");
+        return 1;
+    }
+    fcntl(listen_fd, F_SETFL, fcntl(listen_fd, F_GETFL, 0) | O_NONBLOCK);
+
+    int epfd = epoll_create1(0);
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.ptr = NULL;
+    epoll_ctl(epfd, EPOLL_CTL_ADD, listen_fd, &ev);
+
+    signal(SIGINT, on_signal);
+    signal(SIGTERM, on_signal);
+    signal(SIGPIPE, SIG_IGN);
+
+    stats.started = now_us();
+    printf("Listening on %s\n", path);
+    fflush(stdout);
+
+    struct epoll_event events[MAX_EVENTS];
+    while (! stop) {
+        int n = epoll_wait(epfd, events, MAX_EVENTS, -1);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            perror("epoll_wait");
+            break;
+        }
+
+        unsigned long long received = now_us();
+        for (int i = 0; i < n; i++) {
+            Client* client = events[i].data.ptr;
+            if (client == NULL) {
+                accept_clients(epfd, listen_fd);
+                continue;
+            }
+            if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+                read_client(epfd, client, received);
+            }
+            if (events[i].events & EPOLLOUT) {
+                flush_client(epfd, client);
+            }
+        }
+
+        run_batch();
+        finish_iteration(epfd);
+    }
+
+    char text[2048];
+    format_stats(text, sizeof(text));
+    printf("%s", text);
+
+    close(listen_fd);
+    unlink(path);
+    return 0;
+}
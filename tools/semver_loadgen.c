@@ -0,0 +1,275 @@
+/* Load generator for semver_daemon.
+ *
+ * Usage: semver_loadgen [-s socket] [-n requests] [-c connections] [-d depth]
+ *
+ * Every connection runs in its own thread and keeps up to depth requests
+ * in flight. At the end the tool prints throughput, latency percentiles,
+ * and the daemon statistics.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "semver.h"
+#include "semver_proto.h"
+
+#define LATENCY_BUCKETS 32
+
+static const char* lists[] = {
+    ">=1.2.0,<2.0.0", "^1.4.0", "~2.3.1", "1.0.0 - 1.9.9,3.0.0", "!=1.5.0", ">=0.9.0",
+    "1.16.1 - 1.17.0,0.10.3 - 5.13.9,1.2.15 - 1.2.70", "<=1.11.0,>=1.14.1", "2.0.0-rc.1 - 2.0.0",
+};
+
+static const char* versions[] = {
+    "1.2.3", "1.5.0", "2.3.4", "0.9.1", "2.0.0-rc.2", "1.17.0", "3.0.0", "1.12.3-beta.31+345",
+};
+
+#define LIST_COUNT (sizeof(lists) / sizeof(lists[0]))
+#define VERSION_COUNT (sizeof(versions) / sizeof(versions[0]))
+
+typedef struct worker_t {
+    pthread_t thread;
+    const char* path;
+    int requests;
+    int depth;
+    unsigned int seed;
+    int failed;
+    unsigned long long matched;
+    unsigned long long latency[LATENCY_BUCKETS];
+} Worker;
+
+static unsigned long long now_us() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000ull + ts.tv_nsec / 1000;
+}
+
+static int connect_daemon(const char* path) {
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return -1;
+    }
+
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+    if (connect(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+static int write_all(int fd, const unsigned char* buf, size_t len) {
+    while (len > 0) {
+        ssize_t n = write(fd, buf, len);
+        if (n <= 0) {
+            return 0;
+        }
+        buf += n;
+        len -= n;
+    }
+    return 1;
+}
+
+static size_t put_string(unsigned char* p, const char* str) {
+    size_t len = strlen(str);
+    proto_put_u16(p, (unsigned int)len);
+    memcpy(p + 2, str, len);
+    return len + 2;
+}
+
+/* Builds a random request and returns its size */
+static size_t build_request(unsigned char* p, unsigned int id, unsigned int* seed) {
+    const char* list = lists[rand_r(seed) % LIST_COUNT];
+    int op = (rand_r(seed) % 5 == 0) ? PROTO_MAX_SATISFYING : PROTO_CHECK;
+
+    p[8] = (unsigned char)op;
+    p[9] = 0;
+    size_t len = 10 + put_string(p + 10, list);
+    if (op == PROTO_CHECK) {
+        len += put_string(p + len, versions[rand_r(seed) % VERSION_COUNT]);
+    } else {
+        proto_put_u16(p + len, VERSION_COUNT);
+        len += 2;
+        for (unsigned int i = 0; i < VERSION_COUNT; i++) {
+            len += put_string(p + len, versions[i]);
+        }
+    }
+
+    proto_put_u32(p, (unsigned int)(len - 4));
+    proto_put_u32(p + 4, id);
+    return len;
+}
+
+static void* run_worker(void* arg) {
+    Worker* w = arg;
+    int fd = connect_daemon(w->path);
+    if (fd < 0) {
+        w->failed = 1;
+        return NULL;
+    }
+
+    unsigned long long* sent_at = calloc(w->requests, sizeof(unsigned long long));
+    unsigned char* out = malloc((size_t)w->depth * 1024);
+    unsigned char in[65536];
+    size_t in_len = 0;
+    int sent = 0;
+    int received = 0;
+
+    while (received < w->requests && sent_at != NULL && out != NULL) {
+        size_t out_len = 0;
+        unsigned long long now = now_us();
+        while (sent < w->requests && sent - received < w->depth) {
+            out_len += build_request(out + out_len, sent, &w->seed);
+            sent_at[sent++] = now;
+        }
+        if (out_len > 0 && ! write_all(fd, out, out_len)) {
+            w->failed = 1;
+            break;
+        }
+
+        ssize_t n = read(fd, in + in_len, sizeof(in) - in_len);
+        if (n <= 0) {
+            w->failed = 1;
+            break;
+        }
+        in_len += n;
+
+        size_t pos = 0;
+        now = now_us();
+        while (in_len - pos >= PROTO_RESPONSE_HEADER &&
+               in_len - pos >= proto_get_u32(in + pos) + 4) {
+            unsigned int id = proto_get_u32(in + pos + 4);
+            int status = (int)proto_get_u32(in + pos + 8);
+            if (id < (unsigned int)w->requests) {
+                unsigned long long us = now - sent_at[id];
+                int bucket = 0;
+                while (bucket < LATENCY_BUCKETS - 1 && us >= (1ull << bucket)) {
+                    bucket++;
+                }
+                w->latency[bucket]++;
+            }
+            if (status == SEMVER_OK) {
+                w->matched++;
+            }
+            received++;
+            pos += proto_get_u32(in + pos) + 4;
+        }
+        memmove(in, in + pos, in_len - pos);
+        in_len -= pos;
+    }
+
+    free(sent_at);
+    free(out);
+    close(fd);
+    return NULL;
+}
+
+static void print_daemon_stats(const char* path) {
+    int fd = connect_daemon(path);
+    if (fd < 0) {
+        return;
+    }
+
+    unsigned char req[PROTO_REQUEST_HEADER];
+    memset(req, 0, sizeof(req));
+    proto_put_u32(req, PROTO_REQUEST_HEADER - 4);
+    req[8] = PROTO_STATS;
+    write_all(fd, req, sizeof(req));
+
+    unsigned char in[4096];
+    size_t len = 0;
+    while (len < PROTO_RESPONSE_HEADER || len < proto_get_u32(in) + 4) {
+        ssize_t n = read(fd, in + len, sizeof(in) - 1 - len);
+        if (n <= 0) {
+            break;
+        }
+        len += n;
+    }
+    if (len > PROTO_RESPONSE_HEADER) {
+        in[len] = '\0';
+        printf("Daemon statistics:\n%s", (char*)in + PROTO_RESPONSE_HEADER);
+    }
+    close(fd);
+}
+
+int main(int argc, char** argv) {
+    const char* path = PROTO_DEFAULT_SOCKET;
+    int requests = 100000;
+    int connections = 4;
+    int depth = 32;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "s:n:c:d:")) != -1) {
+        switch (opt) {
+            case 's': path = optarg; break;
+            case 'n': requests = atoi(optarg); break;
+            case 'c': connections = atoi(optarg); break;
+            case 'd': depth = atoi(optarg); break;
+            default:
+                fprintf(stderr, "Usage: %s [-s socket] [-n requests] [-c connections] [-d depth]\n", argv[0]);
+                return 1;
+        }
+    }
+    if (requests <= 0 || connections <= 0 || depth <= 0) {
+        fprintf(stderr, "Invalid arguments\n");
+        return 1;
+    }
+
+    Worker* workers = calloc(connections, sizeof(Worker));
+    if (workers == NULL) {
+        return 1;
+    }
+
+    unsigned long long started = now_us();
+    for (int i = 0; i < connections; i++) {
+        workers[i].path = path;
+        workers[i].requests = requests / connections + (i < requests % connections ? 1 : 0);
+        workers[i].depth = depth;
+        workers[i].seed = 12345 + i;
+        pthread_create(&workers[i].thread, NULL, run_worker, &workers[i]);
+    }
+
+    unsigned long long latency[LATENCY_BUCKETS];
+    unsigned long long matched = 0;
+    unsigned long long total = 0;
+    int failed = 0;
+    memset(latency, 0, sizeof(latency));
+    for (int i = 0; i < connections; i++) {
+        pthread_join(workers[i].thread, NULL);
+        failed |= workers[i].failed;
+        matched += workers[i].matched;
+        for (int b = 0; b < LATENCY_BUCKETS; b++) {
+            latency[b] += workers[i].latency[b];
+            total += workers[i].latency[b];
+        }
+    }
+    double elapsed = (now_us() - started) / 1e6;
+
+    printf("Requests: %llu in %.3f s (%.0f req/s), matched: %llu%s\n", total, elapsed,
+            elapsed > 0 ? total / elapsed : 0.0, matched, failed ? ", some connections failed" : "");
+
+    static const double percentiles[] = { 0.5, 0.9, 0.99, 0.999 };
+    for (int p = 0; p < sizeof(percentiles) / sizeof(percentiles[0]); p++) {
+        unsigned long long seen = 0;
+        for (int b = 0; b < LATENCY_BUCKETS; b++) {
+            seen += latency[b];
+            if (seen >= total * percentiles[p]) {
+                printf("p%g latency < %llu us\n", percentiles[p] * 100, 1ull << b);
+                break;
+            }
+        }
+    }
+
+    print_daemon_stats(path);
+    free(workers);
+    return failed;
+}
@@ -0,0 +1,65 @@
+/* Binary protocol of semver_daemon.
+ *
+ * All integers are in the host byte order: the daemon serves only
+ * local clients over a Unix domain socket.
+ *
+ * Request frame:
+ *   u32 length   - size of the frame without this field
+ *   u32 id       - request id, it is copied to the response
+ *   u8  op       - PROTO_CHECK, PROTO_MAX_SATISFYING, or PROTO_STATS
+ *   u8  reserved
+ *   u16 list length and the version list (not NUL-terminated)
+ *   PROTO_CHECK: u16 version length and the version
+ *   PROTO_MAX_SATISFYING: u16 version count, then every version as
+ *   u16 length and the version
+ *
+ * Response frame:
+ *   u32 length   - size of the frame without this field
+ *   u32 id
+ *   i32 status   - SEMVER_OK, SEMVER_OUT_OF_RANGE, or error code
+ *   u32 value    - PROTO_MAX_SATISFYING: index of the highest version
+ *                  that meets the list requirements
+ *   PROTO_STATS: status is SEMVER_OK and the rest of the frame is text
+ *
+ * Clients can send many requests without waiting for responses.
+ * Responses can come in any order.
+ */
+#ifndef SEMVER_PROTO_20261019
+#define SEMVER_PROTO_20261019
+
+#include <string.h>
+
+#define PROTO_DEFAULT_SOCKET "/tmp/semver.sock"
+#define PROTO_MAX_FRAME 65536
+#define PROTO_REQUEST_HEADER 12
+#define PROTO_RESPONSE_HEADER 16
+#define PROTO_NO_INDEX 0xFFFFFFFFu
+
+enum {
+    PROTO_CHECK = 1,
+    PROTO_MAX_SATISFYING = 2,
+    PROTO_STATS = 3,
+};
+
+static inline unsigned int proto_get_u32(const unsigned char* p) {
+    unsigned int value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+static inline unsigned int proto_get_u16(const unsigned char* p) {
+    unsigned short value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+static inline void proto_put_u32(unsigned char* p, unsigned int value) {
+    memcpy(p, &value, sizeof(value));
+}
+
+static inline void proto_put_u16(unsigned char* p, unsigned int value) {
+    unsigned short v = (unsigned short)value;
+    memcpy(p, &v, sizeof(v));
+}
+
+#endif
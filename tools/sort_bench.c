@@ -0,0 +1,101 @@
+/* Benchmark of sort_versions.
+ *
+ * Usage: sort_bench [-n versions] [-t max_threads] [-s]
+ *
+ * Sorts the same random array with 1, 2, 4, ... up to max_threads threads
+ * (the number of processors by default) and prints the time and speedup
+ * for every thread count. The first line is qsort with compare_versions.
+ * -s makes the sort stable.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "semver.h"
+#include "semver_sort.h"
+
+static const char* prereleases[] = { "", "", "", "", "alpha", "alpha.2", "beta.1", "beta.11", "rc.1", "rc.2" };
+
+static double now_sec() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static int compare_for_qsort(const void* a, const void* b) {
+    return compare_versions(a, b);
+}
+
+static void usage() {
+    printf("Usage: sort_bench [-n versions] [-t max_threads] [-s]\n");
+}
+
+int main(int argc, char** argv) {
+    int count = 5000000;
+    int max_threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    int flags = 0;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "n:t:sh")) != -1) {
+        switch (opt) {
+            case 'n': count = atoi(optarg); break;
+            case 't': max_threads = atoi(optarg); break;
+            case 's': flags |= VERSION_SORT_STABLE; break;
+            default: usage(); return 1;
+        }
+    }
+    if (count < 1 || max_threads < 1) {
+        usage();
+        return 1;
+    }
+
+    SemVersion* source = malloc(count * sizeof(SemVersion));
+    SemVersion* versions = malloc(count * sizeof(SemVersion));
+    if (source == NULL || versions == NULL) {
+        printf("Not enough memory\n");
+        return 1;
+    }
+
+    unsigned int seed = 1;
+    for (int i = 0; i < count; i++) {
+        char str[64];
+        seed = seed * 1103515245 + 12345;
+        const char* pre = prereleases[(seed >> 16) % (sizeof(prereleases) / sizeof(prereleases[0]))];
+        seed = seed * 1103515245 + 12345;
+        unsigned int r = seed >> 8;
+        snprintf(str, sizeof(str), "%u.%u.%u%s%s", r % 20, (r >> 5) % 50, (r >> 11) % 200, *pre ? "-" : "", pre);
+        parse_version(str, &source[i]);
+    }
+
+    printf("%d versions, %s sort\n", count, (flags & VERSION_SORT_STABLE) ? "stable" : "unstable");
+
+    memcpy(versions, source, count * sizeof(SemVersion));
+    double started = now_sec();
+    qsort(versions, count, sizeof(SemVersion), compare_for_qsort);
+    printf("qsort       %8.3f s\n", now_sec() - started);
+
+    double single = 0;
+    for (int threads = 1; ; threads = threads * 2 < max_threads ? threads * 2 : max_threads) {
+        memcpy(versions, source, count * sizeof(SemVersion));
+        started = now_sec();
+        if (sort_versions(versions, count, flags, threads) != SEMVER_OK) {
+            printf("Failed to sort\n");
+            return 1;
+        }
+        double elapsed = now_sec() - started;
+        if (threads == 1) {
+            single = elapsed;
+        }
+        printf("%2d threads  %8.3f s  speedup %.2fx\n", threads, elapsed, single / elapsed);
+
+        if (threads == max_threads) {
+            break;
+        }
+    }
+
+    free(source);
+    free(versions);
+    return 0;
+}